@@ -0,0 +1,112 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#include "AdcTable.h"
+
+#include "InternalConfig.h"
+
+// Store ADC Linearization Table (mV per 2^ADC_TABLE_SHIFT Counts).
+uint16_t adcTable[(4096 >> ADC_TABLE_SHIFT) + 1];
+
+/**
+ * Builds the Table from the Characterization and the Calibration Points.
+ *
+ * The Characterization is evaluated once per Table Entry and corrected
+ * through the Points. Invalid Points are ignored, the Table then only holds
+ * the Characterization.
+ *
+ * @param characterize Converts ADC Counts to mV (eFuse Characterization).
+ * @param points The Calibration Points ([measured mV, true mV]), ascending.
+ * @param count The Number of Points.
+ * @return False if the Points are invalid.
+ */
+bool AdcTable::build(uint32_t (*characterize)(uint32_t counts), const int32_t (*points)[2], uint8_t count)
+{
+    bool valid = isValid(points, count);
+
+    for (uint16_t i = 0; i < sizeof(adcTable) / sizeof(adcTable[0]); i++)
+    {
+        uint32_t counts = (uint32_t)i << ADC_TABLE_SHIFT;
+        int32_t millivolts = characterize(counts < 4095 ? counts : 4095);
+
+        if (valid)
+            millivolts = correct(millivolts, points, count);
+
+        adcTable[i] = millivolts < 0 ? 0 : (millivolts > UINT16_MAX ? UINT16_MAX : millivolts);
+    }
+
+    return valid;
+}
+
+/**
+ * Checks the Calibration Points.
+ *
+ * @param points The Calibration Points ([measured mV, true mV]).
+ * @param count The Number of Points.
+ * @return True if the measured Values are strictly ascending (no Points are valid as well).
+ */
+bool AdcTable::isValid(const int32_t (*points)[2], uint8_t count)
+{
+    for (uint8_t i = 1; i < count; i++)
+    {
+        if (points[i][0] <= points[i - 1][0])
+            return false;
+    }
+
+    return true;
+}
+
+/**
+ * Corrects a Voltage by interpolating between the Calibration Points.
+ *
+ * Outside of the Points the first or last Segment is extrapolated, a single
+ * Point only shifts the Voltage.
+ *
+ * @param millivolts The measured Voltage in mV.
+ * @param points The Calibration Points ([measured mV, true mV]), ascending.
+ * @param count The Number of Points.
+ * @return The corrected Voltage in mV.
+ */
+int32_t AdcTable::correct(int32_t millivolts, const int32_t (*points)[2], uint8_t count)
+{
+    if (count == 0)
+        return millivolts;
+
+    if (count == 1)
+        return millivolts + points[0][1] - points[0][0];
+
+    // Find Segment, the outer Segments are extrapolated.
+    uint8_t segment = 1;
+
+    while (segment < count - 1 && millivolts > points[segment][0])
+        segment++;
+
+    const int32_t* low = points[segment - 1];
+    const int32_t* high = points[segment];
+
+    return low[1] + (int32_t)((int64_t)(millivolts - low[0]) * (high[1] - low[1]) / (high[0] - low[0]));
+}
+
+/**
+ * Converts an ADC Position to mV by interpolating the Table.
+ *
+ * @param position The averaged ADC Counts with 4 fractional Bits.
+ * @return The Voltage in mV.
+ */
+uint32_t AdcTable::linearize(uint32_t position)
+{
+    const uint8_t shift = ADC_TABLE_SHIFT + 4;
+    const uint32_t last = sizeof(adcTable) / sizeof(adcTable[0]) - 1;
+
+    uint32_t index = position >> shift;
+    uint32_t fraction = position & ((1UL << shift) - 1);
+
+    if (index >= last)
+        return adcTable[last];
+
+    // Corrected Tables may fall locally, interpolate signed.
+    int32_t delta = (int32_t)adcTable[index + 1] - adcTable[index];
+
+    return adcTable[index] + (int32_t)(((int64_t)delta * fraction) >> shift);
+}
@@ -0,0 +1,30 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#ifndef ADCTABLE_H
+#define ADCTABLE_H
+#include <stdint.h>
+
+
+/**
+ * Converts averaged ADC Counts to mV via a Lookup Table.
+ *
+ * The Table combines the linear eFuse Characterization with the piecewise
+ * linear Correction through the Calibration Points, so the non-linear Ends of
+ * the 11 dB Range are corrected while a Sample only costs an Interpolation.
+ *
+ * Free of Arduino Dependencies, the Characterization is passed as Callback so
+ * the native Tests run with recorded Pairs.
+ */
+class AdcTable
+{
+public:
+    static bool build(uint32_t (*characterize)(uint32_t counts), const int32_t (*points)[2], uint8_t count);
+    static bool isValid(const int32_t (*points)[2], uint8_t count);
+    static int32_t correct(int32_t millivolts, const int32_t (*points)[2], uint8_t count);
+    static uint32_t linearize(uint32_t position);
+};
+
+
+#endif //ADCTABLE_H
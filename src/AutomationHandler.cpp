@@ -7,6 +7,7 @@
 #include "DeviceHandler.h"
 #include "FileHandler.h"
 #include "InternalConfig.h"
+#include "RelaisHandler.h"
 
 int mode;
 float maxL;
@@ -23,7 +24,7 @@ unsigned long autoMillis = 0;
  * Controls the state of the pump by interacting with the relay and updates
  * the internal state flag.
  *
- * This method uses the `DeviceHandler::setRelais` function to change the state of
+ * This method uses the `RelaisHandler::set` function to change the state of
  * the pump relay and modifies the internal `pumpM` flag to reflect the pump's current
  * operational status.
  *
@@ -32,9 +33,8 @@ unsigned long autoMillis = 0;
  */
 void AutomationHandler::setPump(bool cond)
 {
-    DeviceHandler::setRelais(PUMP_EMPTY, cond);
-
-    pumpM = cond;
+    // Only track the Pump as running if the Interlock allowed the Start.
+    pumpM = RelaisHandler::set(PUMP_EMPTY, cond, RELAIS_AUTO) && cond;
 }
 
 /**
@@ -64,7 +64,7 @@ void AutomationHandler::handlePump()
 /**
  * Activates or deactivates the filling system by controlling the associated pump.
  *
- * This method uses the `DeviceHandler::setRelais` function to set the state of the
+ * This method uses the `RelaisHandler::set` function to set the state of the
  * filling pump relay. Additionally, it updates an internal flag to reflect the
  * current state of the filling system.
  *
@@ -73,9 +73,8 @@ void AutomationHandler::handlePump()
  */
 void AutomationHandler::setFill(bool cond)
 {
-    DeviceHandler::setRelais(PUMP_FILL, cond);
-
-    fillM = cond;
+    // Only track the Fill as running if the Interlock allowed the Start.
+    fillM = RelaisHandler::set(PUMP_FILL, cond, RELAIS_AUTO) && cond;
 }
 
 /**
@@ -150,7 +149,8 @@ void AutomationHandler::loop()
      * <option value="1">Fill & Pump</option>
      * <option value="2">Fill</option>
      */
-    if (mode != 0)
+    // Wait for the first valid Level after Boot.
+    if (mode != 0 && DeviceHandler::isScanValid())
     {
         unsigned long currentMillis = millis();
 
@@ -159,6 +159,10 @@ void AutomationHandler::loop()
         {
             autoMillis = currentMillis;
 
+            // Sync with Relais switched off by Timeouts, Interlocks or the API.
+            fillM = fillM && RelaisHandler::getState(PUMP_FILL);
+            pumpM = pumpM && RelaisHandler::getState(PUMP_EMPTY);
+
             switch (mode)
             {
             case 1:
@@ -236,3 +240,65 @@ int AutomationHandler::getMode()
 {
     return mode;
 }
+
+/**
+ * Changes the Mode at Runtime (not persisted, eq. from Modbus).
+ *
+ * Relais held by the Automation are switched off when it is disabled.
+ *
+ * @param value The Mode (0 = Off, 1 = Fill & Pump, 2 = Fill).
+ * @return False if the Mode is invalid.
+ */
+bool AutomationHandler::setMode(int value)
+{
+    if (value < 0 || value > 2)
+        return false;
+
+    mode = value;
+
+    if (mode == 0 && (fillM || pumpM))
+    {
+        setPump(false);
+        setFill(false);
+    }
+
+    return true;
+}
+
+/**
+ * Retrieves a Threshold.
+ *
+ * @param threshold AUTO_MAX, AUTO_FILL or AUTO_MIN.
+ * @return The Level in %.
+ */
+float AutomationHandler::getThreshold(uint8_t threshold)
+{
+    switch (threshold)
+    {
+    case AUTO_MAX: return maxL;
+    case AUTO_FILL: return fillL;
+    case AUTO_MIN: return minL;
+    default: return 0.0f;
+    }
+}
+
+/**
+ * Changes a Threshold at Runtime (not persisted, eq. from Modbus).
+ *
+ * @param threshold AUTO_MAX, AUTO_FILL or AUTO_MIN.
+ * @param value The Level in % (0 - 100).
+ * @return False if the Threshold or Level is invalid.
+ */
+bool AutomationHandler::setThreshold(uint8_t threshold, float value)
+{
+    if (value < 0.0f || value > 100.0f)
+        return false;
+
+    switch (threshold)
+    {
+    case AUTO_MAX: maxL = value; return true;
+    case AUTO_FILL: fillL = value; return true;
+    case AUTO_MIN: minL = value; return true;
+    default: return false;
+    }
+}
@@ -4,6 +4,14 @@
 
 #ifndef AUTOMATIONHANDLER_H
 #define AUTOMATIONHANDLER_H
+#include <Arduino.h>
+
+/**
+ * Define Automation Thresholds (Level in %).
+ */
+#define AUTO_MAX 0
+#define AUTO_FILL 1
+#define AUTO_MIN 2
 
 
 class AutomationHandler
@@ -20,6 +28,9 @@ public:
     static bool isFilling();
     static bool isPumping();
     static int getMode();
+    static bool setMode(int value);
+    static float getThreshold(uint8_t threshold);
+    static bool setThreshold(uint8_t threshold, float value);
 };
 
 
@@ -0,0 +1,60 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#include "BootHandler.h"
+
+// Store Time (µs since Boot) each Phase has been reached (0 = not yet).
+volatile uint32_t bootTimes[BOOT_PHASES] = {};
+
+// Define Phase Names (Index = BOOT_*).
+const char* const bootNames[BOOT_PHASES] = {
+    "relais", "config", "device", "sensor", "wifi", "stats", "services", "ready", "level", "screen", "ip"
+};
+
+/**
+ * Marks a Boot Phase as reached, only the first Call counts.
+ *
+ * May be called from any Task (eq. the Sensor Task for BOOT_LEVEL).
+ *
+ * @param phase The Phase (BOOT_*).
+ */
+void BootHandler::mark(uint8_t phase)
+{
+    if (phase < BOOT_PHASES && bootTimes[phase] == 0)
+        bootTimes[phase] = micros();
+}
+
+/**
+ * Retrieves the Time a Boot Phase has been reached.
+ *
+ * @param phase The Phase (BOOT_*).
+ * @return The Time in µs since Boot, or `0` if not reached yet.
+ */
+uint32_t BootHandler::getTime(uint8_t phase)
+{
+    return phase < BOOT_PHASES ? bootTimes[phase] : 0;
+}
+
+/**
+ * Retrieves the Name of a Boot Phase.
+ *
+ * @param phase The Phase (BOOT_*).
+ * @return The Name, or an empty String if invalid.
+ */
+const char* BootHandler::getName(uint8_t phase)
+{
+    return phase < BOOT_PHASES ? bootNames[phase] : "";
+}
+
+/**
+ * Prints the reached Boot Phases.
+ */
+void BootHandler::print()
+{
+    for (uint8_t i = 0; i < BOOT_PHASES; i++)
+    {
+        if (bootTimes[i] != 0)
+            Serial.printf("Boot %-8s %7.1f ms\n", bootNames[i], bootTimes[i] / 1000.0f);
+    }
+}
@@ -0,0 +1,40 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#ifndef BOOTHANDLER_H
+#define BOOTHANDLER_H
+#include <Arduino.h>
+
+/**
+ * Define Boot Phases, marked at their End by `setup()`.
+ */
+#define BOOT_RELAIS 0
+#define BOOT_CONFIG 1
+#define BOOT_DEVICE 2
+#define BOOT_SENSOR 3
+#define BOOT_WIFI 4
+#define BOOT_STATS 5
+#define BOOT_SERVICES 6
+#define BOOT_READY 7
+
+/**
+ * Define Boot Events, marked by the Tasks running in the Background.
+ */
+#define BOOT_LEVEL 8
+#define BOOT_SCREEN 9
+#define BOOT_IP 10
+#define BOOT_PHASES 11
+
+
+class BootHandler
+{
+public:
+    static void mark(uint8_t phase);
+    static uint32_t getTime(uint8_t phase);
+    static const char* getName(uint8_t phase);
+    static void print();
+};
+
+
+#endif //BOOTHANDLER_H
@@ -0,0 +1,125 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#include "ConfigStore.h"
+#include <string.h>
+
+#include "InternalConfig.h"
+
+/**
+ * Loads the newest valid Config Copy.
+ *
+ * The binary `/config.bin` is tried first (one Read, no Text Parsing). If it
+ * is missing or invalid, the newest valid JSON Copy is used: `/config.json`,
+ * a completed but not yet renamed `/config.json.tmp` (Power Loss between
+ * close and rename) or finally the factory Backup `/config.json.bak`.
+ *
+ * @param files The File Operations.
+ * @return The Source of the loaded Config (CONFIG_*), CONFIG_NONE if every Copy is invalid.
+ */
+uint8_t ConfigStore::load(const ConfigFiles& files)
+{
+    // Fast Path, binary Config of the last Save.
+    if (files.loadBinary("/config.bin"))
+        return CONFIG_BINARY;
+
+    // Primary Config.
+    if (files.loadJson("/config.json"))
+        return CONFIG_JSON;
+
+    // Pending Temp File of an interrupted Save.
+    if (files.loadJson("/config.json.tmp"))
+    {
+        // Finish interrupted Save.
+        files.rename("/config.json.tmp", "/config.json");
+        return CONFIG_TEMP;
+    }
+
+    // Restore Backup.
+    if (files.copy("/config.json.bak", "/config.json") && files.loadJson("/config.json"))
+        return CONFIG_BACKUP;
+
+    return CONFIG_NONE;
+}
+
+/**
+ * Persists the Config, binary first, JSON Export second.
+ *
+ * Every Copy is written to `<path>.tmp` and renamed over the Destination.
+ * LittleFS renames atomically, so a Power Loss leaves either the old or the
+ * new Copy intact, never a truncated one.
+ *
+ * @param files The File Operations.
+ * @return True if both Copies have been replaced.
+ */
+bool ConfigStore::store(const ConfigFiles& files)
+{
+    return files.writeBinary("/config.bin.tmp") &&
+        files.rename("/config.bin.tmp", "/config.bin") &&
+        files.writeJson("/config.json.tmp") &&
+        files.rename("/config.json.tmp", "/config.json");
+}
+
+/**
+ * Fills the Header of a binary Config.
+ *
+ * @param buffer The Buffer, the MessagePack Payload starts at `sizeof(ConfigHeader)`.
+ * @param length The Length of the Payload.
+ */
+void ConfigStore::writeHeader(uint8_t* buffer, uint32_t length)
+{
+    ConfigHeader header;
+    header.magic = CONFIG_MAGIC;
+    header.schema = CONFIG_SCHEMA;
+    header.reserved = 0;
+    header.length = length;
+    header.crc = crc32(buffer + sizeof(ConfigHeader), length);
+
+    memcpy(buffer, &header, sizeof(header));
+}
+
+/**
+ * Checks Magic, Schema, Length and CRC32 of a binary Config.
+ *
+ * @param buffer The File Content.
+ * @param size The Size of the File.
+ * @return True if the Payload behind the Header is intact.
+ */
+bool ConfigStore::checkHeader(const uint8_t* buffer, size_t size)
+{
+    if (size <= sizeof(ConfigHeader))
+        return false;
+
+    ConfigHeader header;
+    memcpy(&header, buffer, sizeof(header));
+
+    return header.magic == CONFIG_MAGIC &&
+        header.schema == CONFIG_SCHEMA &&
+        header.length == size - sizeof(header) &&
+        header.crc == crc32(buffer + sizeof(header), header.length);
+}
+
+/**
+ * Calculates the CRC32 (IEEE 802.3, same Result as `esp_rom_crc32_le(0, ...)`).
+ *
+ * @param data The Bytes.
+ * @param length The Number of Bytes.
+ * @return The CRC32.
+ */
+uint32_t ConfigStore::crc32(const uint8_t* data, size_t length)
+{
+    uint32_t crc = 0xFFFFFFFF;
+
+    for (size_t i = 0; i < length; i++)
+    {
+        crc ^= data[i];
+
+        for (int bit = 0; bit < 8; bit++)
+        {
+            crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+        }
+    }
+
+    return ~crc;
+}
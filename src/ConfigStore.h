@@ -0,0 +1,64 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#ifndef CONFIGSTORE_H
+#define CONFIGSTORE_H
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Define Config Sources (Result of `ConfigStore::load()`).
+ */
+#define CONFIG_NONE 0
+#define CONFIG_BINARY 1
+#define CONFIG_JSON 2
+#define CONFIG_TEMP 3
+#define CONFIG_BACKUP 4
+
+/**
+ * Define Header of the binary Config (/config.bin), followed by the Config
+ * encoded as MessagePack.
+ */
+struct ConfigHeader
+{
+    uint32_t magic;
+    uint16_t schema;
+    uint16_t reserved;
+    uint32_t length;
+    uint32_t crc;
+};
+
+/**
+ * Define File Operations used by the ConfigStore (LittleFS on the Device,
+ * RAM in the native Tests).
+ */
+struct ConfigFiles
+{
+    bool (*loadBinary)(const char* path);
+    bool (*loadJson)(const char* path);
+    bool (*writeBinary)(const char* path);
+    bool (*writeJson)(const char* path);
+    bool (*rename)(const char* from, const char* to);
+    bool (*copy)(const char* from, const char* to);
+};
+
+
+/**
+ * Decides which Config Copy is loaded at Boot and in which Order a Save
+ * replaces them, so a Power Loss at any Point leaves a valid Config.
+ *
+ * Free of Arduino Dependencies, the File Operations are passed in.
+ */
+class ConfigStore
+{
+public:
+    static uint8_t load(const ConfigFiles& files);
+    static bool store(const ConfigFiles& files);
+    static void writeHeader(uint8_t* buffer, uint32_t length);
+    static bool checkHeader(const uint8_t* buffer, size_t size);
+    static uint32_t crc32(const uint8_t* data, size_t length);
+};
+
+
+#endif //CONFIGSTORE_H
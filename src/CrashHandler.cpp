@@ -0,0 +1,290 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#include "CrashHandler.h"
+#include <Preferences.h>
+#include <esp_core_dump.h>
+#include <esp_partition.h>
+#include "DumpReader.h"
+#include "InternalConfig.h"
+
+// Define Magic of the Restart Marker (upper 24 Bits, Reason in the lower 8 Bits).
+#define RESTART_MAGIC 0x52535400
+
+// Store Restart Marker, survives a Software Reset (not initialized at Boot).
+RTC_NOINIT_ATTR uint32_t restartMarker;
+
+// Store Reset Reason and Counters (persisted in NVS).
+const char* resetReason = "unknown";
+uint32_t bootCount = 0;
+uint32_t crashCount = 0;
+
+// Store Core Dump Summary (read once at Boot).
+bool dumpPresent = false;
+uint32_t dumpAddress = 0;
+uint32_t dumpSize = 0;
+uint32_t dumpPC = 0;
+char dumpTask[16] = "";
+char dumpSHA[65] = "";
+
+// Store Core Dump Partition (found on the first Download).
+const esp_partition_t* dumpPartition = nullptr;
+
+/**
+ * Evaluates the Reset Reason, counts Boots and Crashes and reads the Summary
+ * of a stored Core Dump.
+ *
+ * Panics and Watchdog Resets count as Crash. The Counters are stored in NVS,
+ * the Crash Counter is only written after a Crash.
+ */
+void CrashHandler::setup()
+{
+    esp_reset_reason_t reason = esp_reset_reason();
+    bool crashed = false;
+
+    switch (reason)
+    {
+    case ESP_RST_POWERON: resetReason = "poweron"; break;
+    case ESP_RST_EXT: resetReason = "external"; break;
+    case ESP_RST_SW: resetReason = "software"; break;
+    case ESP_RST_PANIC: resetReason = "panic"; crashed = true; break;
+    case ESP_RST_INT_WDT: resetReason = "int_wdt"; crashed = true; break;
+    case ESP_RST_TASK_WDT: resetReason = "task_wdt"; crashed = true; break;
+    case ESP_RST_WDT: resetReason = "wdt"; crashed = true; break;
+    case ESP_RST_DEEPSLEEP: resetReason = "deepsleep"; break;
+    case ESP_RST_BROWNOUT: resetReason = "brownout"; break;
+    case ESP_RST_SDIO: resetReason = "sdio"; break;
+    default: break;
+    }
+
+    // Controlled Restarts mark their Reason before.
+    if (reason == ESP_RST_SW && (restartMarker & 0xFFFFFF00) == RESTART_MAGIC)
+    {
+        if ((restartMarker & 0xFF) == RESTART_API)
+            resetReason = "api";
+        else if ((restartMarker & 0xFF) == RESTART_MEMORY)
+            resetReason = "memory";
+        else if ((restartMarker & 0xFF) == RESTART_CONFIG)
+            resetReason = "config";
+        else if ((restartMarker & 0xFF) == RESTART_UPDATE)
+            resetReason = "update";
+    }
+
+    restartMarker = 0;
+
+    Preferences preferences;
+
+    if (preferences.begin("crash", false))
+    {
+        bootCount = preferences.getUInt("boots", 0) + 1;
+        crashCount = preferences.getUInt("crashes", 0) + (crashed ? 1 : 0);
+
+        preferences.putUInt("boots", bootCount);
+
+        if (crashed)
+            preferences.putUInt("crashes", crashCount);
+
+        preferences.end();
+    }
+
+    loadDump();
+
+    Serial.printf("Reset: %s (Crashes: %u, Core Dump: %s)\n", resetReason, crashCount, dumpPresent ? "yes" : "no");
+}
+
+/**
+ * Reads the Location and Summary of the Core Dump in the Flash Partition.
+ */
+void CrashHandler::loadDump()
+{
+    dumpPresent = false;
+
+#if CONFIG_ESP_COREDUMP_ENABLE_TO_FLASH
+    size_t address = 0;
+    size_t size = 0;
+
+    if (esp_core_dump_image_get(&address, &size) != ESP_OK || size == 0)
+        return;
+
+    dumpPresent = true;
+    dumpAddress = address;
+    dumpSize = size;
+
+#if CONFIG_ESP_COREDUMP_DATA_FORMAT_ELF
+    esp_core_dump_summary_t summary;
+
+    if (esp_core_dump_get_summary(&summary) == ESP_OK)
+    {
+        dumpPC = summary.exc_pc;
+        strlcpy(dumpTask, summary.exc_task, sizeof(dumpTask));
+        strlcpy(dumpSHA, (const char*)summary.app_elf_sha256, sizeof(dumpSHA));
+    }
+#endif
+#endif
+}
+
+/**
+ * Marks the Reason of the following Software Restart.
+ *
+ * Has to be called before every `ESP.restart()`, otherwise the Restart is
+ * reported as "software".
+ *
+ * @param reason RESTART_API, RESTART_MEMORY, RESTART_CONFIG or RESTART_UPDATE.
+ */
+void CrashHandler::markRestart(uint8_t reason)
+{
+    restartMarker = RESTART_MAGIC | reason;
+}
+
+/**
+ * Retrieves the Reason of the last Reset.
+ *
+ * @return poweron, external, software, api, memory, config, update, panic,
+ *         int_wdt, task_wdt, wdt, deepsleep, brownout, sdio or unknown.
+ */
+const char* CrashHandler::getResetReason()
+{
+    return resetReason;
+}
+
+/**
+ * Retrieves the Number of Boots.
+ *
+ * @return The Boots since the NVS has been erased.
+ */
+uint32_t CrashHandler::getBootCount()
+{
+    return bootCount;
+}
+
+/**
+ * Retrieves the Number of Crashes (Panic or Watchdog).
+ *
+ * @return The Crashes since the NVS has been erased.
+ */
+uint32_t CrashHandler::getCrashCount()
+{
+    return crashCount;
+}
+
+/**
+ * Checks if a valid Core Dump is stored.
+ *
+ * @return True if a Core Dump can be downloaded.
+ */
+bool CrashHandler::hasDump()
+{
+    return dumpPresent;
+}
+
+/**
+ * Retrieves the Size of the stored Core Dump.
+ *
+ * @return The Size in Bytes, or `0` if there is none.
+ */
+uint32_t CrashHandler::getDumpSize()
+{
+    return dumpPresent ? dumpSize : 0;
+}
+
+/**
+ * Retrieves the Name of the crashed Task.
+ *
+ * @return The Task Name, or an empty String if unknown.
+ */
+const char* CrashHandler::getDumpTask()
+{
+    return dumpTask;
+}
+
+/**
+ * Retrieves the Program Counter of the Exception.
+ *
+ * @return The Address, or `0` if unknown.
+ */
+uint32_t CrashHandler::getDumpPC()
+{
+    return dumpPC;
+}
+
+/**
+ * Retrieves the SHA256 of the ELF which produced the Core Dump.
+ *
+ * @return The (shortened) Hash as Hex String, or an empty String if unknown.
+ */
+const char* CrashHandler::getDumpSHA()
+{
+    return dumpSHA;
+}
+
+/**
+ * Streams the raw Core Dump from the Flash Partition (`GET /coredump`).
+ *
+ * The Dump is read in Chunks directly into the Response Buffer. Decode it
+ * with the matching ELF:
+ * `espcoredump.py info_corefile -t raw -c coredump.bin firmware.elf`
+ *
+ * @param request Pointer to the asynchronous web server request.
+ */
+void CrashHandler::streamDump(AsyncWebServerRequest* request)
+{
+    uint32_t offset;
+
+    if (dumpPartition == nullptr)
+        dumpPartition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_DATA_COREDUMP, NULL);
+
+    if (!dumpPresent || dumpPartition == nullptr ||
+        !DumpReader::locate(dumpPartition->address, dumpPartition->size, dumpAddress, dumpSize, &offset))
+    {
+        request->send(404, "application/json", R"({"type":"error","message":"No core dump"})");
+        return;
+    }
+
+    uint32_t size = dumpSize;
+
+    AsyncWebServerResponse* response = request->beginResponse(
+        "application/octet-stream", size,
+        [offset, size](uint8_t* buffer, size_t maxLen, size_t index) -> size_t
+        {
+            return DumpReader::read(readPartition, offset, size, buffer, maxLen, index);
+        });
+
+    response->addHeader("Content-Disposition", "attachment; filename=\"coredump.bin\"");
+    request->send(response);
+}
+
+/**
+ * Reads from the Core Dump Partition.
+ *
+ * @param offset The Offset inside the Partition.
+ * @param buffer The Buffer.
+ * @param length The Number of Bytes.
+ * @return True if the Bytes have been read.
+ */
+bool CrashHandler::readPartition(uint32_t offset, uint8_t* buffer, size_t length)
+{
+    return esp_partition_read(dumpPartition, offset, buffer, length) == ESP_OK;
+}
+
+/**
+ * Erases the stored Core Dump.
+ *
+ * @return True if the Partition has been erased.
+ */
+bool CrashHandler::eraseDump()
+{
+#if CONFIG_ESP_COREDUMP_ENABLE_TO_FLASH
+    if (esp_core_dump_image_erase() != ESP_OK)
+        return false;
+
+    dumpPresent = false;
+    dumpTask[0] = '\0';
+    dumpSHA[0] = '\0';
+    dumpPC = 0;
+
+    return true;
+#else
+    return false;
+#endif
+}
@@ -0,0 +1,41 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#ifndef CRASHHANDLER_H
+#define CRASHHANDLER_H
+#include <Arduino.h>
+#include "ESPAsyncWebServer.h"
+
+/**
+ * Define controlled Restart Reasons (reported instead of "software").
+ */
+#define RESTART_API 1
+#define RESTART_MEMORY 2
+#define RESTART_CONFIG 3
+#define RESTART_UPDATE 4
+
+
+class CrashHandler
+{
+private:
+    static void loadDump();
+    static bool readPartition(uint32_t offset, uint8_t* buffer, size_t length);
+
+public:
+    static void setup();
+    static void markRestart(uint8_t reason);
+    static const char* getResetReason();
+    static uint32_t getBootCount();
+    static uint32_t getCrashCount();
+    static bool hasDump();
+    static uint32_t getDumpSize();
+    static const char* getDumpTask();
+    static uint32_t getDumpPC();
+    static const char* getDumpSHA();
+    static void streamDump(AsyncWebServerRequest* request);
+    static bool eraseDump();
+};
+
+
+#endif //CRASHHANDLER_H
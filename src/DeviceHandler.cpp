@@ -8,8 +8,12 @@
 #include <Wire.h>
 
 #include "Adafruit_SSD1306.h"
+#include "BootHandler.h"
 #include "FileHandler.h"
+#include "FrameDiff.h"
 #include "InternalConfig.h"
+#include "LayoutHandler.h"
+#include "SensorHandler.h"
 #include "WiFiHandler.h"
 
 // Define a new Display Instance.
@@ -21,81 +25,50 @@ unsigned long previousMillis = 0;
 // Store last Scan Timestamp.
 unsigned long scanMillis = 0;
 
-// Store last Display Timestamp.
-unsigned long displayMillis = 0;
+// Store Display Task Handle.
+TaskHandle_t displayTask = NULL;
 
-// Store last Relais Duration Timestamp.
-unsigned long ch1 = -1;
-unsigned long ch2 = -1;
-
-// Store Relais States.
-bool relay1 = LOW;
-bool relay2 = LOW;
+// Store configured Display Brightness.
+uint8_t displayLevel = 255;
 
+// Store if the Debug Page (Memory Telemetry) replaces the Layout.
+bool displayDebug = false;
 
 // Current LED state
 bool ledState = LOW;
 
-// Store latest Voltage.
-float latestVoltage = 0.00;
-
 // Store State of System LED.
 bool systemLed = true;
 
-// Store Calibration Values.
-float maxV = 2.4;
-float minV = 0.0;
-
-// Store Tank Volume.
-float tankVolume = 1000.0;
-
 // Store scanned Values (Caching to save CPU)
 float scanCurrent = 0.00;
 float scanTemperature = 0.00;
 float scanWaterLevel = 0.00;
 float scanWaterVolume = 0.00;
 
+// Store if the cached Values are based on a valid Tank Sample.
+bool scanValid = false;
+
 // Store Display State.
 bool displayEnabled = false;
 
+// Guard the I2C Bus shared by the Display and Sensor Tasks.
+SemaphoreHandle_t wireMutex = NULL;
 
-/**
- * Monitors and manages the state of relays based on their configured timers.
- *
- * This method checks the elapsed time for two relay channels (`ch1` and `ch2`)
- * and switches the corresponding relay off if the configured timer (in milliseconds)
- * for that relay has expired. The relays are controlled through the `setRelais()`
- * method, which alters their state.
- *
- * Preconditions:
- * - `ch1` and `ch2` must be assigned appropriate millisecond timer values. A value of `-1`
- *   indicates that the respective channel is inactive and will not be processed.
- * - The relays must be properly initialized and capable of being toggled through the `setRelais()` method.
- *
- * Postconditions:
- * - If the current time exceeds the timer value for a given channel, the corresponding
- *   relay is switched off (set to `false`).
- *
- * Behavior:
- * - If `ch1` is active and its timer has expired, relay channel 1 is switched off.
- * - If `ch2` is active and its timer has expired, relay channel 2 is switched off.
- * - Relays with inactive or unconfigured timers (`-1`) remain unaffected.
- */
-void DeviceHandler::handleRelais()
-{
-    unsigned long currentMillis = millis();
+// Store Loop Duration (µs), Average as EMA over ~64 Loops (scaled by 64).
+uint32_t loopAverage = 0;
+uint32_t loopMax = 0;
 
-    // Check if the interval has passed
-    if (ch1 != -1 && (currentMillis >= ch1))
-    {
-        setRelais(1, false);
-    }
+// Store Transfer Stats of the last Frame.
+uint32_t displayBytes = 0;
+uint32_t displayMicros = 0;
+
+// Store Burn-In Protection State.
+unsigned long displayChangeMillis = 0;
+bool displayDimmed = false;
+int16_t displayShift = 0;
+bool displayShifted = false;
 
-    if (ch2 != -1 && (currentMillis >= ch2))
-    {
-        setRelais(2, false);
-    }
-}
 
 /**
  * Toggles the state of an LED at a fixed interval defined by BLINK_INTERVAL.
@@ -133,80 +106,20 @@ void DeviceHandler::handleBlink()
 
 
 /**
- * Executes an ADC (Analog-to-Digital Converter) reading task and terminates itself.
+ * Caches the Values of the Tank Sensor and the CPU Temperature.
  *
- * This task function retrieves the latest ADC value by invoking the `DeviceHandler::getADCValue` method.
- * The resulting value is stored in the `latestVoltage` variable, serving as a reference for subsequent operations
- * or calculations. Following the read operation, the task automatically deletes itself to free up system resources.
- *
- * Preconditions:
- * - The ADC and its associated configurations (e.g., `SENSE` pin defined in `InternalConfig.h`) must be properly initialized.
- * - The `DeviceHandler` class must be accessible and configured for ADC operations.
- *
- * Postconditions:
- * - The `latestVoltage` variable contains the most recent ADC-converted voltage value.
- * - The task is deleted and will no longer consume system resources.
- *
- * Behavior:
- * - Reads an analog voltage value through the `DeviceHandler::getADCValue` method.
- * - Transfers control to the FreeRTOS scheduler for task deletion via `vTaskDelete`.
- *
- * Note:
- * - This function runs once and is self-terminating upon completion.
- */
-void adcTaskFunction(void* parameter)
-{
-    // Read ADC First = latestVoltage as ref.
-    DeviceHandler::getADCValue();
-
-    // Task beendet sich automatisch
-    vTaskDelete(NULL);
-}
-
-
-/**
- * Conducts a sensor scan by initiating ADC conversion and retrieving sensor values.
- *
- * This method performs multiple actions:
- * - Starts a task to initiate ADC voltage reading, updating the `latestVoltage` reference.
- * - Reads and updates various sensor-related parameters, including current, CPU temperature,
- *   water level percentage, and water volume.
- *
- * Behavior:
- * - The ADC task (`adcTaskFunction`) is created to asynchronously read the voltage via ADC,
- *   updating the `latestVoltage` value. The task is automatically destroyed after execution.
- * - The `getCurrent()` method fetches the current sensor value based on the ADC reading.
- * - The `getCPUTemperature()` method retrieves the CPU's current temperature.
- * - The `getLevel()` method calculates the water level percentage using the latest ADC voltage.
- * - The `getVolume()` method computes the water tank's volume based on the water level percentage.
- *
- * Preconditions:
- * - The ADC hardware and associated pins must be properly configured and operational.
- * - The system should support task creation using `xTaskCreate`.
- * - The `minV`, `maxV`, and `tankVolume` must be configured appropriately to ensure accurate calculations.
+ * The Tank Input is sampled by the round-robin Sensor Task (see
+ * `SensorHandler`), so this method only copies its filtered Value and
+ * never blocks on an ADC Conversion.
  *
  * Postconditions:
  * - Updates the global variables `scanCurrent`, `scanTemperature`, `scanWaterLevel`, and `scanWaterVolume`
  *   with the most recent sensor readings.
- *
- * Threading Model:
- * - Utilizes FreeRTOS task functionality (`xTaskCreate`) to perform ADC reading asynchronously.
  */
 void DeviceHandler::scanSensors()
 {
-    // Read ADC First = latestVoltage as ref.
-    xTaskCreate(
-        adcTaskFunction,
-        "ADC Task",
-        2048,
-        NULL,
-        1,
-        NULL
-    );
-
-
     // Read Sensor Values.
-    scanCurrent = roundToTwoDecimals(getCurrent(false));
+    scanCurrent = roundToTwoDecimals(getCurrent());
     scanTemperature = roundToTwoDecimals(getCPUTemperature());
     scanWaterLevel = roundToTwoDecimals(getLevel());
     scanWaterVolume = roundToTwoDecimals(getVolume());
@@ -235,9 +148,15 @@ void DeviceHandler::handleScan()
 {
     unsigned long currentMillis = millis();
 
-    // Check if the interval has passed
-    if (currentMillis - scanMillis >= SCAN_INTERVAL)
+    // Check if the interval has passed, or the first Level is available
+    if (currentMillis - scanMillis >= SCAN_INTERVAL || (!scanValid && SensorHandler::isValid(SENSOR_TANK)))
     {
+        if (!scanValid && SensorHandler::isValid(SENSOR_TANK))
+        {
+            scanValid = true;
+            BootHandler::mark(BOOT_LEVEL);
+        }
+
         scanMillis = currentMillis;
 
         scanSensors();
@@ -245,42 +164,90 @@ void DeviceHandler::handleScan()
 }
 
 /**
- * Handles the periodic update of the display based on a predefined time interval.
- *
- * This method checks if the display functionality is enabled and if the scheduled
- * interval for updating the display has elapsed. If the conditions are met, the
- * display is updated using the `updateDisplay()` method.
- *
- * Preconditions:
- * - `displayEnabled` must be set to `true` for the display to be updated.
- * - `DISPLAY_INTERVAL` is defined as the time interval (in milliseconds) for updating the display.
- * - The display must be initialized and functional prior to calling this method.
- *
- * Postconditions:
- * - If the current time exceeds the last update time by the value of `DISPLAY_INTERVAL`,
- *   the display is refreshed through `updateDisplay()`, and `displayMillis` is updated
- *   with the current time.
- *
- * Behavior:
- * - If `displayEnabled` is `false`, no updates are performed, and the method exits.
- * - Compares the current system time (`millis()`) with the last recorded time
- *   (`displayMillis`). If the interval has passed, updates the display and resets
- *   the tracking timer (`displayMillis`).
+ * Runs the Display Refresh in its own FreeRTOS Task.
+ *
+ * The Display is initialized by the Task itself, so the Boot continues
+ * while the SSD1306 is configured via I2C (BOOT_SCREEN marks the End).
+ * The Task renders the latest cached Sensor Values every `DISPLAY_INTERVAL`
+ * and transmits the changed Regions via I2C. As it runs independently from
+ * `loop()`, a slow I2C Transfer never delays the Automation. The Task runs
+ * at the Priority of the Loop Task, so both get Time Slices and neither can
+ * starve the other.
+ *
+ * Burn-In Protection:
+ * - The Layout is shifted by one Pixel every `DISPLAY_SHIFT_INTERVAL`.
+ * - If the Frame Content did not change for `DISPLAY_DIM_TIMEOUT`, the
+ *   Display is dimmed to `DISPLAY_DIM_LEVEL` until the next Change.
+ *
+ * @param parameter Unused Task Parameter.
  */
-void DeviceHandler::handleDisplay()
+void DeviceHandler::handleDisplay(void* parameter)
 {
-    if (displayEnabled)
+    // Initialize the Display here, so the Boot doesn't wait for I2C.
+    bool locked = lockWire();
+    bool ready = display.begin(SSD1306_SWITCHCAPVCC, SCREEN_ADDRESS);
+
+    if (ready)
+        setBrightness(displayLevel);
+
+    if (locked)
+        unlockWire();
+
+    if (!ready)
     {
+        Serial.println(F("SSD1306 allocation failed"));
+        displayTask = NULL;
+        vTaskDelete(NULL);
+        return;
+    }
+
+    // Compile Display Layout.
+    if (displayDebug)
+        LayoutHandler::loadDebug();
+    else
+        LayoutHandler::load("/layout.json");
+
+    // Set Enabled State.
+    displayEnabled = true;
+    displayChangeMillis = millis();
+    BootHandler::mark(BOOT_SCREEN);
+
+    TickType_t wakeTime = xTaskGetTickCount();
+
+    for (;;)
+    {
+        // Limit Frame Rate.
+        vTaskDelayUntil(&wakeTime, pdMS_TO_TICKS(DISPLAY_INTERVAL));
+
+        // Share I2C Bus with the Sensor Task (ADS1115).
+        if (!lockWire())
+            continue;
+
+        // Update Display Content.
+        updateDisplay();
+
         unsigned long currentMillis = millis();
 
-        // Check if the interval has passed
-        if (currentMillis - displayMillis >= DISPLAY_INTERVAL)
+        // Content changed (ignore Changes caused by the Pixel Shift).
+        if (displayBytes > 0 && !displayShifted)
         {
-            displayMillis = currentMillis;
-
-            // Update Display Content.
-            updateDisplay();
+            displayChangeMillis = currentMillis;
+
+            // Restore Brightness on Change.
+            if (displayDimmed)
+            {
+                setBrightness(displayLevel);
+                displayDimmed = false;
+            }
+        }
+        else if (!displayDimmed && currentMillis - displayChangeMillis >= DISPLAY_DIM_TIMEOUT)
+        {
+            // Dim static Content.
+            setBrightness(min((uint8_t)DISPLAY_DIM_LEVEL, displayLevel));
+            displayDimmed = true;
         }
+
+        unlockWire();
     }
 }
 
@@ -295,9 +262,8 @@ void DeviceHandler::handleDisplay()
  * Behavior:
  * - Calls `handleBlink()` to manage the LED blinking operation based on the specified
  *   blink interval.
- * - Calls `handleRelais()` to monitor and control the state of relays based on their
- *   configured timers.
  * - Calls `handleScan()` to handle scanning-related tasks.
+ * - The Display is refreshed by its own Task (see `handleDisplay()`).
  *
  * Preconditions:
  * - The device and its components (e.g., relays, LED) must be properly initialized and
@@ -310,75 +276,22 @@ void DeviceHandler::handleDisplay()
 void DeviceHandler::loop()
 {
     handleBlink();
-    handleRelais();
     handleScan();
-    handleDisplay();
-}
-
-/**
- * Sets the state of the specified relay channel.
- *
- * This method controls the state of a relay by writing a HIGH or LOW signal
- * to its associated pin. It determines the appropriate pin based on the relay
- * channel number provided as input. Optionally, debug output is printed to the
- * serial monitor if DEBUG is enabled.
- *
- * Preconditions:
- * - RELAIS_CH1 and RELAIS_CH2 must be correctly defined as the pin numbers for relay channels 1 and 2, respectively.
- * - The associated pins for the relay channels must be configured as output using `pinMode()` before invoking this method.
- *
- * Postconditions:
- * - The specified relay's state will be set to either HIGH or LOW based on the input state.
- *
- * Behavior:
- * - If an invalid relay channel is provided, the function writes to an undefined pin.
- *
- * @param relais Specifies the relay channel to be controlled (1 or 2).
- * @param state The desired state for the relay: true for HIGH, false for LOW.
- */
-void DeviceHandler::setRelais(int8_t relais, bool state)
-{
-    unsigned int pin;
-
-    if (relais == 1)
-    {
-        pin = RELAIS_CH1;
-        ch1 = -1;
-        relay1 = state;
-    }
-    else if (relais == 2)
-    {
-        pin = RELAIS_CH2;
-        ch2 = -1;
-        relay2 = state;
-    }
-
-    // Set Relais State.
-    digitalWrite(pin, state);
-
-#if DEBUG == true
-    Serial.print("Relais ");
-    Serial.print(relais);
-    Serial.print(" set to ");
-    Serial.println(state);
-#endif
 }
 
 /**
- * Configures the pin modes for the device's LED and relay channels.
+ * Configures the pin modes for the device's LED and the ADC resolution.
  *
  * This method sets up the microcontroller's pins defined in InternalConfig.h
- * for the device's LED and relays. Each pin is configured as an output to
- * ensure proper control and operation during the program execution.
+ * for the device's LED. The Relais Channels are configured by
+ * `RelaisHandler::setup()`, the Sensor Inputs by `SensorHandler::setup()`.
  *
  * Preconditions:
- * - The pin numbers for LED_PIN, RELAIS_CH1, and RELAIS_CH2 must be correctly
+ * - The pin numbers for LED_PIN and RESET must be correctly
  *   defined in the configuration file (e.g., InternalConfig.h).
  *
  * Postconditions:
  * - LED_PIN is set to OUTPUT mode, enabling control of an external LED.
- * - RELAIS_CH1 and RELAIS_CH2 are set to OUTPUT mode, enabling control of
- *   external relays.
  *
  * Behavior:
  * - Each pin is configured using the `pinMode` function with the OUTPUT mode.
@@ -389,18 +302,13 @@ void DeviceHandler::setup()
     // Setup ADC Resolution.
     analogReadResolution(12);
 
-    // Set ADC Attenuation.
-    analogSetPinAttenuation(SENSE, ADC_11db);
-
-    // Input Pins.
-    pinMode(SENSE, INPUT);
-
     // Output Pins.
     pinMode(LED_PIN, OUTPUT);
-    pinMode(RELAIS_CH1, OUTPUT);
-    pinMode(RELAIS_CH2, OUTPUT);
     pinMode(RESET, OUTPUT);
 
+    // I2C Bus Guard (Display and external Sensors).
+    wireMutex = xSemaphoreCreateMutex();
+
     // If Pin 9 is HIGH, reset Configuration.
     if (digitalRead(RESET))
     {
@@ -413,9 +321,6 @@ void DeviceHandler::setup()
 
     // Set System LED State.
     systemLed = FileHandler::getConfig()["hardware"]["led"].as<bool>();
-    maxV = FileHandler::getConfig()["calibration"]["max"].as<float>();
-    minV = FileHandler::getConfig()["calibration"]["min"].as<float>();
-    tankVolume = FileHandler::getConfig()["calibration"]["volume"].as<float>();
 
     // Check if OLED is enabled.
     if (FileHandler::getConfig()["hardware"]["oled"].as<bool>())
@@ -426,88 +331,16 @@ void DeviceHandler::setup()
 }
 
 /**
- * Sets the duration for which a specific relay channel should remain active.
- *
- * This method schedules the deactivation of the specified relay channel by
- * setting an expiration time relative to the current time. The relay channel
- * will be turned off once the specified duration has elapsed.
- *
- * Preconditions:
- * - The `channel` parameter must be either 1 or 2 to correspond to valid relay channels.
- * - The `duration` parameter must specify the desired duration in milliseconds.
- *
- * Behavior:
- * - If the `channel` is 1, the expiration time for channel 1 is updated.
- * - If the `channel` is 2, the expiration time for channel 2 is updated.
- * - No action is taken if the `channel` value is invalid.
- *
- * @param channel The relay channel to set the duration for. Valid values are 1 or 2.
- * @param duration The duration in milliseconds for which the relay should remain active.
- */
-void DeviceHandler::setRelaisDuration(int channel, int duration)
-{
-    if (channel == 1)
-    {
-        ch1 = millis() + (duration * 1000);
-    }
-    else if (channel == 2)
-    {
-        ch2 = millis() + (duration * 1000);
-    }
-}
-
-/**
- * Retrieves the state of a specified relay.
- *
- * This method returns the current state of the relay identified by the given index.
- * The state indicates whether the relay is active (`true`) or inactive (`false`).
- *
- * Preconditions:
- * - The input index should correspond to a valid relay channel.
- * - Relay `1` corresponds to `relay1`.
- * - Relay `2` corresponds to `relay2`.
- *
- * Behavior:
- * - If `i` is `1`, the method returns the state of `relay1`.
- * - If `i` is `2`, the method returns the state of `relay2`.
- * - Undefined behavior occurs if the input index does not match a valid relay channel.
- *
- * @param i The index of the relay to retrieve the state for. Accepts `1` for `relay1`
- *          and `2` for `relay2`.
- * @return The state of the specified relay:
- *         - `true` if the relay is active.
- *         - `false` if the relay is inactive.
- */
-bool DeviceHandler::getState(int i)
-{
-    if (i == 1)
-        return relay1;
-    else if (i == 2)
-        return relay2;
-    return false;
-}
-
-/**
- * Reads the analog value from the defined sensor pin.
- *
- * This method fetches the current analog-to-digital converted value
- * from the microcontroller's `SENSE` pin, which is mapped to a specific
- * hardware input channel. The result is a 10-bit value (0 to 1023) by default,
- * depending on the resolution and configuration of the analog-to-digital converter (ADC).
- *
- * Preconditions:
- * - The `SENSE` pin must be properly configured and connected to an analog input source.
- * - The ADC feature must be enabled and configured in the microcontroller.
+ * Retrieves the filtered Voltage of the Tank Input.
  *
- * Postconditions:
- * - Returns a 16-bit unsigned value representing the current analog reading
- *   from the configured pin.
+ * The Value is sampled and filtered by the Sensor Task (Sensor 0 of the
+ * `SensorHandler` Registry, `SENSE` Pin).
  *
- * @return The analog-to-digital converted value from the `SENSE` pin.
+ * @return The Voltage in V.
  */
 float DeviceHandler::getADCValue()
 {
-    return readVoltage(SENSE, 64);
+    return SensorHandler::getValue(SENSOR_TANK);
 }
 
 /**
@@ -528,57 +361,11 @@ float DeviceHandler::getADCValue()
  * - The method performs a voltage-to-current transformation using a constant scaling factor.
  * - No additional error handling for invalid ADC readings or division by zero is implemented.
  */
-float DeviceHandler::getCurrent(bool newReading = false)
+float DeviceHandler::getCurrent()
 {
-    return ((newReading ? getADCValue() : latestVoltage) / 120) * 1000.0;
+    return (getADCValue() / 120) * 1000.0;
 }
 
-/**
- * Reads and calculates the voltage at a specified analog pin by averaging multiple samples.
- *
- * This method performs multiple analog readings from the specified pin, averages these readings, and
- * calculates the corresponding voltage based on the reference voltage and ADC resolution.
- *
- * Preconditions:
- * - The specified analog pin must be properly configured and capable of returning ADC values.
- * - The number of samples must be positive. The default value is 10 samples.
- * - The ADC resolution is assumed to be 12-bit with a full-scale value of 4095, and the reference voltage is 3.3V.
- *
- * Behavior:
- * - The method performs a loop to read the ADC value `samples` times.
- * - A short delay of 10 milliseconds is applied between successive readings to reduce fluctuations.
- * - The average ADC value is computed and converted to a voltage based on the ADC characteristics.
- *
- * @param pin The analog pin to read from.
- * @param samples The number of readings to average. Default value is 10.
- * @return The calculated voltage based on the averaged ADC readings.
- */
-float DeviceHandler::readVoltage(int pin, int samples = 10)
-{
-    uint32_t sum = 0;
-
-    for (int i = 0; i < samples; i++)
-    {
-        // Read Voltage via ADC.
-        sum += analogReadMilliVolts(pin);
-
-        // Short delay between reads.
-        delay(10);
-    }
-
-    // Calculate average voltage.
-    float average = (sum / (float)samples) / 1000.0f;
-
-    // Do some EMA Filtering.
-    float voltage = (latestVoltage * (1.0f - EMA_ALPHA)) + (average * EMA_ALPHA);
-
-    // Cache latest voltage.
-    latestVoltage = voltage;
-
-    return voltage;
-}
-
-
 /**
  * Retrieves the current CPU temperature.
  *
@@ -603,97 +390,23 @@ float DeviceHandler::getCPUTemperature()
 }
 
 /**
- * Retrieves the remaining duration (in milliseconds) for a specified relay channel.
- *
- * This method calculates the time remaining for the specified relay channel (`ch1` for `i=1`
- * or `ch2` for `i=2`) before it is expected to timeout. The duration is determined based on
- * the current time and the channel's configured timer value.
- *
- * Arguments:
- * - `i`: The index of the relay channel to query (1 for `ch1` or 2 for `ch2`).
- *
- * Behavior:
- * - If the channel's timer value is `-1`, indicating it is inactive, the returned duration
- *   will be `0`.
- * - If the channel's timer value is configured and has not expired, the method calculates
- *   the remaining duration in milliseconds by subtracting the current time (`millis()`)
- *   from the timer value.
- * - If the timer value has already expired or is less than the current time, the returned
- *   duration will be `0`.
- *
- * Returns:
- * - The time remaining in milliseconds for the specified relay channel, or `0` if the
- *   channel is inactive or its timer has already expired.
+ * Calculates the current level in percentage of the Tank Sensor.
  *
- * Preconditions:
- * - `i` must be either `1` for channel `ch1` or `2` for channel `ch2`. Other values may lead
- *   to undefined results.
- * - The `millis()` function must provide a valid, non-negative time value.
- *
- * Postconditions:
- * - The method will ensure a non-negative remaining duration is returned, even in cases
- *   where the timer has expired.
- */
-int DeviceHandler::getDuration(int i)
-{
-    int duration = 0;
-
-    if (i == 1)
-    {
-        duration = (ch1 <= 0 ? 0 : ch1);
-    }
-
-    if (i == 2)
-    {
-        duration = (ch2 <= 0 ? 0 : ch2);
-    }
-
-    // Timestamp to Seconds.
-    if (duration > 0 && (duration - millis()) > 0)
-    {
-        return (duration - millis());
-    }
-
-    return 0;
-}
-
-/**
- * Calculates the current level in percentage based on the latest voltage reading.
- *
- * This method computes the relative percentage of the latest voltage reading
- * (`latestVoltage`) within the specified range (`minV` to `maxV`).
- * The value is constrained to lie within the range of 0% to 100%.
- *
- * Behavior:
- * - If the latest voltage is below `minV`, the level is set to 0%.
- * - If the latest voltage is above `maxV`, the level is set to 100%.
- * - For all other values, the percentage is calculated as:
- *   `(latestVoltage - minV) / (maxV - minV) * 100.0f`.
- *
- * Preconditions:
- * - `minV` and `maxV` define the valid range for voltage values, where `minV < maxV`.
- *
- * Postconditions:
- * - The returned value is a floating-point percentage value within the range of 0 to 100.
+ * The Voltage is mapped between the calibrated `min` and `max` Voltage and
+ * limited to 0% to 100% (see `SensorHandler::getLevel()`).
  *
  * @return The calculated level as a percentage within the range of 0% to 100%.
  */
 float DeviceHandler::getLevel()
 {
-    float percent = (latestVoltage - minV) / (maxV - minV) * 100.0f;
-
-    // Limit to 0–100 %
-    if (percent < 0.0f) percent = 0.0f;
-    if (percent > 100.0f) percent = 100.0f;
-
-    return percent;
+    return SensorHandler::getLevel(SENSOR_TANK);
 }
 
 /**
  * Calculates the current volume of liquid in the tank.
  *
  * This method determines the volume of liquid in the tank by using the
- * predefined total tank capacity (`tankVolume`) and the current liquid
+ * calibrated total tank capacity (`calibration.volume`) and the current liquid
  * level percentage (`getLevel()`), returning the resulting volume in
  * liters. The level percentage is expected to be a value between 0 and 100.
  *
@@ -701,7 +414,7 @@ float DeviceHandler::getLevel()
  */
 float DeviceHandler::getVolume()
 {
-    return tankVolume * (getLevel() / 100.0f);
+    return SensorHandler::getVolume(SENSOR_TANK);
 }
 
 /**
@@ -801,21 +514,20 @@ float DeviceHandler::getCurrentCached()
  * readings are unnecessary or when the cached value suffices.
  *
  * Preconditions:
- * - The `latestVoltage` variable must have been updated previously
- *   through a measurement or initialization process.
+ * - The Sensor Task must have sampled the Tank Input at least once.
  *
  * Postconditions:
  * - The returned value reflects the last stored ADC voltage reading,
  *   which may not represent the current state of the ADC.
  *
  * Behavior:
- * - Always returns the cached ADC voltage value stored in `latestVoltage`.
+ * - Always returns the filtered Voltage of the Tank Sensor (`SENSOR_TANK`).
  *
  * @return The cached ADC voltage value as a floating-point number.
  */
 float DeviceHandler::getADCValueCached()
 {
-    return latestVoltage;
+    return SensorHandler::getValue(SENSOR_TANK);
 }
 
 /**
@@ -837,71 +549,70 @@ float DeviceHandler::roundToTwoDecimals(float value)
 /**
  * Updates the device's display with relevant information and graphics.
  *
- * This method refreshes the display by first clearing it and then rendering a
- * series of text indicators and graphical elements. The presented data includes
- * WiFi status, fluid level, volume, ADC voltage, and current measurements. It also
- * displays a graphical filled rectangle for visual representation of data.
- *
- * Rendered elements:
- * - A header with "BYTE LEVEL".
- * - A horizontal dividing line below the header.
- * - System status information such as WiFi signal strength, fluid level percentage,
- *   fluid volume, ADC voltage, and electrical current.
- * - A graphical representation of a filled rectangle positioned on the right side of the display.
+ * This method refreshes the display by clearing the framebuffer and rendering
+ * the compiled Layout (see `LayoutHandler`), which binds live Values like
+ * level, volume, ADC voltage, current, RSSI and relay states to the Screen.
+ * The tank graphic is filled proportional to the current level.
  *
  * Postconditions:
  * - The display is refreshed with the updated information and visuals.
  *
  * Behavior:
  * - The method assumes that the display is properly initialized and connected.
- * - Existing content on the display is fully cleared before rendering updated information.
- * - Data is rendered at specific, pre-determined positions on the display.
+ * - Existing content on the framebuffer is fully cleared before rendering updated information,
+ *   only changed regions are transmitted via `flushDisplay()`.
+ * - The Layout is loaded once at boot from `/layout.json`, so it can be changed without reflashing.
  */
 void DeviceHandler::updateDisplay()
 {
     display.clearDisplay();
-    display.setCursor(0, 0);
 
-    // Print Header
-    display.print("BYTE");
-    display.print("LEVEL");
+    // Shift Layout by one Pixel periodically (Burn-In Protection).
+    int16_t shift = (millis() / DISPLAY_SHIFT_INTERVAL) % 2;
 
-    // Draw Header Line.
-    display.drawLine(0, 9, 128, 9, 1);
+    displayShifted = (shift != displayShift);
+    displayShift = shift;
 
-    // Set Center Text Position.
-    display.setCursor(0, 18);
+    // Render compiled Layout with live Values.
+    LayoutHandler::render(display, shift, shift);
 
-    // Print WiFi.
-    display.print("WiFi: ");
-    display.println((WiFiHandler::isConnected() ? "OK" : "AP"));
+    // Update changed Regions of the Display.
+    flushDisplay();
+}
 
-    // Print Water Level.
-    display.print("Level: ");
-    display.print(getLevelCached(), 1);
-    display.println("%");
+/**
+ * Transmits only the changed Parts of the Framebuffer to the OLED display.
+ *
+ * The Page Diff is done by `FrameDiff::flush()`, this Method only provides
+ * the I2C Transfers. If nothing changed, no I2C Transfer happens at all.
+ *
+ * Postconditions:
+ * - `displayBytes` and `displayMicros` hold the Data Bytes and Time of the Transfer.
+ */
+void DeviceHandler::flushDisplay()
+{
+    unsigned long start = micros();
 
-    // Print Volume.
-    display.print("Volume: ");
-    display.println(getVolumeCached(), 2);
-    display.println("L");
+    // Data Bytes follow the Control Byte in one I2C Transmission.
+    DisplayBus bus = {
+        [](uint8_t command) { display.ssd1306_command(command); },
+        [](const uint8_t* bytes, size_t length)
+        {
+            Wire.beginTransmission(SCREEN_ADDRESS);
+            Wire.write((uint8_t)0x40);
+            Wire.write(bytes, length);
+            Wire.endTransmission();
+        },
+        I2C_BUFFER_LENGTH - 1
+    };
 
-    // Print ADC.
-    display.print("ADC: ");
-    display.print(roundToTwoDecimals(getADCValueCached()), 2);
-    display.println("V");
+    Wire.setClock(400000);
 
-    // Print Current.
-    display.println("Current: ");
-    display.println(roundToTwoDecimals(getCurrentCached()), 2);
-    display.println("mA");
+    displayBytes = FrameDiff::flush(bus, display.getBuffer());
 
-    // Print Tank Mockup.
-    display.drawRect(95, 18, 30, 40, 1);
-    display.fillRect(97, 20, 26, 36, 1);
+    Wire.setClock(100000);
 
-    // Update Display.
-    display.display();
+    displayMicros = micros() - start;
 }
 
 /**
@@ -942,21 +653,136 @@ void DeviceHandler::setBrightness(uint8_t brightness)
  *   to the serial monitor.
  *
  * Behavior:
- * - The method attempts to initialize the display. If the initialization fails, it does not
- *   crash the program but logs the failure to the serial output.
+ * - The initialization runs in the Display Task (see `handleDisplay()`), this method only
+ *   loads the Brightness and starts the Task. If the initialization fails, the Task logs the
+ *   failure to the serial output and ends.
  */
 void DeviceHandler::setupDisplay()
 {
-    if (!display.begin(SSD1306_SWITCHCAPVCC, SCREEN_ADDRESS))
+    // Set Display Brightness.
+    displayLevel = FileHandler::getConfig()["hardware"]["level"].as<uint8_t>();
+    displayDebug = FileHandler::getConfig()["hardware"]["debug"] | false;
+
+    // Initialize and refresh Display in Background.
+    xTaskCreate(
+        handleDisplay,
+        "Display Task",
+        4096,
+        NULL,
+        1,
+        &displayTask
+    );
+}
+
+/**
+ * Retrieves the Number of Data Bytes transmitted for the last Frame.
+ *
+ * @return The transmitted Bytes (0 if the Frame was unchanged).
+ */
+uint32_t DeviceHandler::getDisplayBytes()
+{
+    return displayBytes;
+}
+
+/**
+ * Retrieves the Duration of the last Frame Transfer.
+ *
+ * @return The Duration in Microseconds.
+ */
+uint32_t DeviceHandler::getDisplayMicros()
+{
+    return displayMicros;
+}
+
+/**
+ * Takes exclusive Access to the I2C Bus.
+ *
+ * The Display Task and the Sensor Task (ADS1115) share `Wire`, every
+ * Transaction must be enclosed by `lockWire()` and `unlockWire()`.
+ *
+ * @return False if the Bus could not be taken within one SCAN_INTERVAL.
+ */
+bool DeviceHandler::lockWire()
+{
+    if (wireMutex == NULL)
+        return true;
+
+    return xSemaphoreTake(wireMutex, pdMS_TO_TICKS(SCAN_INTERVAL)) == pdTRUE;
+}
+
+/**
+ * Releases the I2C Bus taken by `lockWire()`.
+ */
+void DeviceHandler::unlockWire()
+{
+    if (wireMutex != NULL)
+        xSemaphoreGive(wireMutex);
+}
+
+/**
+ * Checks if the cached Values are based on a valid Tank Sample.
+ *
+ * @return False until the Sensor Task delivered the first Level.
+ */
+bool DeviceHandler::isScanValid()
+{
+    return scanValid;
+}
+
+/**
+ * Collects the current Fault Flags (published via mDNS and Modbus).
+ *
+ * @return FAULT_TANK if the Tank Sensor is invalid, FAULT_SENSOR if another
+ *         Sensor is invalid and FAULT_AP if the Device fell back to AP Mode.
+ */
+uint8_t DeviceHandler::getFaults()
+{
+    uint8_t faults = 0;
+
+    if (!SensorHandler::isValid(SENSOR_TANK))
+        faults |= FAULT_TANK;
+
+    for (uint8_t i = 1; i < SensorHandler::getCount(); i++)
     {
-        Serial.println(F("SSD1306 allocation failed"));
+        if (!SensorHandler::isValid(i))
+            faults |= FAULT_SENSOR;
     }
-    else
-    {
-        // Set Display Brightness.
-        setBrightness(FileHandler::getConfig()["hardware"]["level"].as<uint8_t>());
 
-        // Set Enabled State.
-        displayEnabled = true;
-    }
+    if (WiFiHandler::isAPActive())
+        faults |= FAULT_AP;
+
+    return faults;
+}
+
+/**
+ * Records the Duration of a Main Loop Iteration.
+ *
+ * @param duration The Duration in µs.
+ */
+void DeviceHandler::recordLoop(uint32_t duration)
+{
+    loopAverage += duration - (loopAverage >> 6);
+
+    if (duration > loopMax)
+        loopMax = duration;
+}
+
+/**
+ * Retrieves the average Main Loop Duration.
+ *
+ * @return The Duration in µs.
+ */
+uint32_t DeviceHandler::getLoopAverage()
+{
+    return loopAverage >> 6;
+}
+
+/**
+ * Retrieves the longest Main Loop Duration since Boot.
+ *
+ * @return The Duration in µs.
+ */
+uint32_t DeviceHandler::getLoopMax()
+{
+    return loopMax;
 }
@@ -8,30 +8,32 @@
 #ifndef DEVICEHANDLER_H
 #define DEVICEHANDLER_H
 
+/**
+ * Define Fault Flags (mDNS `flt` TXT Record, Modbus Input Register 4).
+ */
+#define FAULT_TANK 0x01
+#define FAULT_SENSOR 0x02
+#define FAULT_AP 0x04
+
 
 class DeviceHandler
 {
 private:
-    static void handleRelais();
     static void handleBlink();
     static void scanSensors();
     static void handleScan();
-    static void handleDisplay();
+    static void handleDisplay(void* parameter);
     static void updateDisplay();
+    static void flushDisplay();
     static void setBrightness(uint8_t brightness);
     static void setupDisplay();
 
 public:
     static void loop();
-    static void setRelais(int8_t relais, bool state);
     static void setup();
-    static void setRelaisDuration(int as, int as1);
-    static bool getState(int i);
     static float getADCValue();
-    static float getCurrent(bool newReading);
-    static float readVoltage(int pin, int samples);
+    static float getCurrent();
     static float getCPUTemperature();
-    static int getDuration(int i);
     static float getLevel();
     static float getVolume();
     static float getVolumeCached();
@@ -40,6 +42,15 @@ public:
     static float getCurrentCached();
     static float getADCValueCached();
     static float roundToTwoDecimals(float value);
+    static uint32_t getDisplayBytes();
+    static uint32_t getDisplayMicros();
+    static bool lockWire();
+    static bool isScanValid();
+    static uint8_t getFaults();
+    static void recordLoop(uint32_t duration);
+    static uint32_t getLoopAverage();
+    static uint32_t getLoopMax();
+    static void unlockWire();
 };
 
 
@@ -0,0 +1,59 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#include "DumpReader.h"
+
+/**
+ * Calculates the Offset of the Core Dump inside its Partition.
+ *
+ * @param partitionAddress The Flash Address of the Partition.
+ * @param partitionSize The Size of the Partition.
+ * @param dumpAddress The Flash Address of the Core Dump.
+ * @param dumpSize The Size of the Core Dump.
+ * @param offset Receives the Offset of the Core Dump inside the Partition.
+ * @return True if the Core Dump lies completely inside the Partition.
+ */
+bool DumpReader::locate(uint32_t partitionAddress, uint32_t partitionSize, uint32_t dumpAddress, uint32_t dumpSize,
+                        uint32_t* offset)
+{
+    if (dumpSize == 0 || dumpAddress < partitionAddress)
+        return false;
+
+    uint32_t start = dumpAddress - partitionAddress;
+
+    // Compare without Overflow of start + dumpSize.
+    if (start > partitionSize || dumpSize > partitionSize - start)
+        return false;
+
+    *offset = start;
+    return true;
+}
+
+/**
+ * Reads the next Chunk of the Core Dump.
+ *
+ * @param read The Flash Read (Partition Offset, Buffer, Length).
+ * @param offset The Offset of the Core Dump inside the Partition.
+ * @param size The Size of the Core Dump.
+ * @param buffer The Response Buffer.
+ * @param maxLen The Size of the Response Buffer.
+ * @param index The Number of Bytes already sent.
+ * @return The Length of the Chunk, `0` at the End or on a Read Error.
+ */
+size_t DumpReader::read(bool (*read)(uint32_t, uint8_t*, size_t), uint32_t offset, uint32_t size, uint8_t* buffer,
+                        size_t maxLen, size_t index)
+{
+    if (index >= size)
+        return 0;
+
+    size_t length = size - index;
+
+    if (length > maxLen)
+        length = maxLen;
+
+    if (!read(offset + index, buffer, length))
+        return 0;
+
+    return length;
+}
@@ -0,0 +1,28 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#ifndef DUMPREADER_H
+#define DUMPREADER_H
+#include <stddef.h>
+#include <stdint.h>
+
+
+/**
+ * Locates the Core Dump inside its Flash Partition and splits it into the
+ * Chunks of the chunked HTTP Response.
+ *
+ * Free of Arduino Dependencies, the Flash Read is passed as Callback so the
+ * CrashHandler reads the Partition and the native Tests a RAM Image.
+ */
+class DumpReader
+{
+public:
+    static bool locate(uint32_t partitionAddress, uint32_t partitionSize, uint32_t dumpAddress, uint32_t dumpSize,
+                       uint32_t* offset);
+    static size_t read(bool (*read)(uint32_t, uint8_t*, size_t), uint32_t offset, uint32_t size, uint8_t* buffer,
+                       size_t maxLen, size_t index);
+};
+
+
+#endif //DUMPREADER_H
@@ -10,6 +10,8 @@
 #include <ArduinoJson.h>
 #include <LittleFS.h>
 
+#include "ConfigStore.h"
+
 // Definition der statischen Member-Variable
 JsonDocument FileHandler::config;
 
@@ -37,29 +39,37 @@ void FileHandler::begin()
 }
 
 /**
- * @brief Reads the content of a file from the LittleFS file system.
+ * @brief Parses a JSON File directly from the LittleFS file system.
  *
- * This method opens the specified file in read mode, retrieves its content
- * as a string, and then closes the file. If the file cannot be opened, an error
- * message is logged via Serial, and an empty string is returned.
+ * The File is passed as Stream into ArduinoJson, so the Content is never
+ * materialized as String and only the resulting Document occupies the Heap.
  *
  * @param path The file path as a C-style string to be read from the file system.
- * @return The content of the file as a String. Returns an empty string if the
- * file cannot be opened or does not exist.
+ * @param doc The Document to deserialize into.
+ * @return True if the File exists and contains valid JSON.
  */
-String FileHandler::readFile(const char* path)
+bool FileHandler::readJson(const char* path, JsonDocument& doc)
 {
     File file = LittleFS.open(path, "r");
 
     if (!file)
     {
         Serial.println("Failed to open file");
-        return "";
+        return false;
     }
 
-    String content = file.readString();
+    DeserializationError error = deserializeJson(doc, file);
     file.close();
-    return content;
+
+    if (error)
+    {
+#if DEBUG == true
+        Serial.printf("JSON %s: %s\n", path, error.c_str());
+#endif
+        return false;
+    }
+
+    return true;
 }
 
 /**
@@ -69,35 +79,269 @@ String FileHandler::readFile(const char* path)
  * parsing the configuration file stored in the file system. It ensures
  * that the application retrieves and utilizes the necessary settings
  * for its operation based on the configuration data.
+ *
+ * The Copy is picked by `ConfigStore::load()` (binary, JSON, interrupted
+ * Save, factory Backup). Afterwards the Config is migrated to the running
+ * Firmware Version.
  */
 JsonDocument FileHandler::loadConfig()
 {
-    // Copy file if not exists.
-    if (!LittleFS.exists("/config.json"))
+#if DEBUG == true
+    unsigned long start = micros();
+    uint32_t heap = ESP.getFreeHeap();
+#endif
+
+    uint8_t source = ConfigStore::load(getFiles());
+
+#if DEBUG == true
+    if (source == CONFIG_BACKUP)
+        Serial.println("Config invalid, restored backup");
+#endif
+
+    // Add Keys of newer Firmware Versions (stores the Config if migrated).
+    if (strcmp(config["version"] | "", VERSION) != 0)
+        migrateConfig("/config.json.bak");
+    else if (source != CONFIG_BINARY)
+        storeConfig();
+
+#if DEBUG == true
+    Serial.printf("Config loaded (%u) in %lu us, heap %u -> %u\n", source, micros() - start, heap, ESP.getFreeHeap());
+#endif
+
+    return config;
+}
+
+/**
+ * @brief Retrieves the LittleFS File Operations for the ConfigStore.
+ *
+ * @return The File Operations.
+ */
+ConfigFiles FileHandler::getFiles()
+{
+    ConfigFiles files;
+    files.loadBinary = loadBinary;
+    files.loadJson = parseConfig;
+    files.writeBinary = writeBinary;
+    files.writeJson = writeJson;
+    files.rename = [](const char* from, const char* to) { return LittleFS.rename(from, to); };
+    files.copy = copyFile;
+
+    return files;
+}
+
+/**
+ * @brief Loads the binary Config with a single Read.
+ *
+ * The File consists of a `ConfigHeader` followed by the Config encoded as
+ * MessagePack. Magic, Schema, Length and CRC32 are checked by the
+ * ConfigStore before decoding, a Mismatch falls back to the JSON Config.
+ *
+ * @param path The Path of the binary Config.
+ * @return True if the File is valid and has been decoded into the Config.
+ */
+bool FileHandler::loadBinary(const char* path)
+{
+    File file = LittleFS.open(path, "r");
+
+    if (!file)
+        return false;
+
+    size_t size = file.size();
+
+    if (size <= sizeof(ConfigHeader))
     {
-        copyFile("/config.json.bak", "/config.json");
+        file.close();
+        return false;
     }
 
-    // Deserialize Json Config.
-    deserializeJson(config, readFile("/config.json"));
+    uint8_t* buffer = (uint8_t*)malloc(size);
 
-    return config;
+    if (buffer == NULL)
+    {
+        file.close();
+        return false;
+    }
+
+    size_t length = file.read(buffer, size);
+    file.close();
+
+    bool valid = (length == size && ConfigStore::checkHeader(buffer, size));
+
+    if (valid)
+    {
+        valid = !deserializeMsgPack(config, buffer + sizeof(ConfigHeader), size - sizeof(ConfigHeader)) &&
+            config.is<JsonObject>();
+    }
+
+    free(buffer);
+
+    if (!valid)
+    {
+#if DEBUG == true
+        Serial.println("Config bin invalid");
+#endif
+        config.clear();
+    }
+
+    return valid;
+}
+
+/**
+ * @brief Writes the Config as MessagePack with Header and CRC32.
+ *
+ * Writes the Path directly, `ConfigStore::store()` passes a Temp File.
+ *
+ * @param path The Path of the binary Config.
+ * @return True if the File has been written completely.
+ */
+bool FileHandler::writeBinary(const char* path)
+{
+    size_t length = measureMsgPack(config);
+    uint8_t* buffer = (uint8_t*)malloc(sizeof(ConfigHeader) + length);
+
+    if (buffer == NULL)
+        return false;
+
+    serializeMsgPack(config, buffer + sizeof(ConfigHeader), length);
+    ConfigStore::writeHeader(buffer, length);
+
+    File file = LittleFS.open(path, "w");
+    bool result = file && file.write(buffer, sizeof(ConfigHeader) + length) == sizeof(ConfigHeader) + length;
+
+    if (file)
+    {
+        // Flush to Flash before Rename.
+        file.flush();
+        file.close();
+    }
+
+    free(buffer);
+
+    return result;
+}
+
+/**
+ * @brief Writes the Config as JSON Export.
+ *
+ * The Document is streamed into the File, no intermediate String is built.
+ * Writes the Path directly, `ConfigStore::store()` passes a Temp File.
+ *
+ * @param path The Path of the JSON Config.
+ * @return True if the File has been written completely.
+ */
+bool FileHandler::writeJson(const char* path)
+{
+    File file = LittleFS.open(path, "w");
+
+    if (!file)
+        return false;
+
+    bool result = serializeJson(config, file) == measureJson(config);
+
+    // Flush to Flash before Rename.
+    file.flush();
+    file.close();
+
+    return result;
+}
+
+/**
+ * @brief Persists the current Config.
+ *
+ * The binary Config is used for Boot, the JSON Config is kept as readable
+ * Export and Fallback (see `ConfigStore::store()`).
+ *
+ * @return True if both Files have been written.
+ */
+bool FileHandler::storeConfig()
+{
+    return ConfigStore::store(getFiles());
+}
+
+/**
+ * @brief Parses a JSON File into the Config Document.
+ *
+ * @param path The Path of the File to parse.
+ * @return True if the File exists and contains a valid JSON Object.
+ */
+bool FileHandler::parseConfig(const char* path)
+{
+    if (!LittleFS.exists(path))
+        return false;
+
+    if (!readJson(path, config) || !config.is<JsonObject>())
+    {
+        config.clear();
+        return false;
+    }
+
+    return true;
 }
 
 /**
  * @brief Saves a string to a file in the LittleFS file system.
  *
- * This method opens or creates a file with the specified name and writes
- * the provided string into it. After writing, the file is closed.
+ * The Content is written to `<path>.tmp` first and then renamed over the
+ * Destination. LittleFS renames atomically, so a Power Loss at any Point
+ * leaves either the old or the new File intact, never a truncated one.
  *
  * @param str The name or path of the file to which the string will be saved.
  * @param string The string content to be written into the file.
+ * @return True if the File has been written completely.
  */
-void FileHandler::saveFile(const char* str, const String& string)
+bool FileHandler::saveFile(const char* str, const String& string)
 {
-    File file = LittleFS.open(str, "w");
-    file.println(string);
+    return saveFile(str, (const uint8_t*)string.c_str(), string.length());
+}
+
+/**
+ * @brief Saves a Buffer atomically to a file in the LittleFS file system.
+ *
+ * @param str The name or path of the file to which the Buffer will be saved.
+ * @param data The Buffer to write.
+ * @param length The Number of Bytes to write.
+ * @return True if the File has been written completely.
+ */
+bool FileHandler::saveFile(const char* str, const uint8_t* data, size_t length)
+{
+    String temp = String(str) + ".tmp";
+
+    File file = LittleFS.open(temp, "w");
+
+    if (!file)
+    {
+        Serial.println("W500");
+        return false;
+    }
+
+    size_t written = file.write(data, length);
+
+    return commitFile(file, temp, str, written == length);
+}
+
+/**
+ * @brief Finishes an atomic Write by renaming the Temp File over the Destination.
+ *
+ * @param file The open Temp File, will be flushed and closed.
+ * @param temp The Path of the Temp File.
+ * @param path The Path of the Destination File.
+ * @param complete True if every Byte has been written to the Temp File.
+ * @return True if the Destination has been replaced.
+ */
+bool FileHandler::commitFile(File& file, const String& temp, const char* path, bool complete)
+{
+    // Flush to Flash before Rename.
+    file.flush();
     file.close();
+
+    if (!complete)
+    {
+        Serial.println("W507");
+        LittleFS.remove(temp);
+        return false;
+    }
+
+    return LittleFS.rename(temp, path);
 }
 
 /**
@@ -130,18 +374,50 @@ void FileHandler::saveConfig(JsonObject object)
 /**
  * @brief Copies the contents of one file to another.
  *
- * This method reads the contents of the source file and writes them
- * to the destination file. If the debug mode is enabled, a success
+ * This method copies the source file block by block into a temp file and
+ * renames it over the destination, so only a small Stack Buffer is used
+ * regardless of the File Size. If the debug mode is enabled, a success
  * message is printed to Serial.
  *
  * @param source The path to the source file to be copied.
  * @param destination The path to the destination file where the contents
  * will be written.
- * @return true if the file has been successfully copied.
+ * @return true if the file has been successfully copied (atomically, see saveFile).
  */
 bool FileHandler::copyFile(const char* source, const char* destination)
 {
-    saveFile(destination, readFile(source));
+    File input = LittleFS.open(source, "r");
+
+    if (!input)
+    {
+        Serial.println("F404");
+        return false;
+    }
+
+    String temp = String(destination) + ".tmp";
+    File output = LittleFS.open(temp, "w");
+
+    if (!output)
+    {
+        input.close();
+        Serial.println("W500");
+        return false;
+    }
+
+    uint8_t buffer[FILE_BLOCK];
+    bool complete = true;
+
+    while (complete && input.available())
+    {
+        size_t length = input.read(buffer, sizeof(buffer));
+
+        complete = (length > 0 && output.write(buffer, length) == length);
+    }
+
+    input.close();
+
+    if (!commitFile(output, temp, destination, complete))
+        return false;
 
 #if DEBUG == true
     Serial.println("File successfully created.");
@@ -154,27 +430,33 @@ bool FileHandler::copyFile(const char* source, const char* destination)
  * @brief Resets the configuration file to its backup state.
  *
  * This method replaces the current configuration file with its backup version
- * by copying "/config.json.bak" to "/config.json", effectively restoring
- * the settings to a known backup state.
+ * by copying "/config.json.bak" to "/config.json" and removing the binary
+ * Config, effectively restoring the settings to a known backup state.
  */
 void FileHandler::reset()
 {
     copyFile("/config.json.bak", "/config.json");
+
+    // Force Import of the restored JSON on next Boot.
+    LittleFS.remove("/config.bin");
 }
 
 /**
- * @brief Merges configuration data from a backup file into the main configuration.
+ * @brief Migrates the loaded Configuration to the running Firmware Version.
  *
- * Reads a backup JSON file and the main configuration JSON file, then merges
- * missing keys or values from the backup into the main configuration. Finally,
- * saves the updated configuration back to the file system.
+ * If the `version` Key of the Config differs from `VERSION`, missing Keys
+ * are merged from the Backup (factory) Config, the Version is bumped and the
+ * Result is saved atomically. Existing Values are never overwritten.
  *
- * @param configPath The file path to the main configuration file.
  * @param backupPath The file path to the backup configuration file.
- * @return True if the merge and update process completes successfully, false otherwise.
+ * @return True if the Config is up to date or has been migrated successfully.
  */
-bool FileHandler::mergeConfigFromBackup(const char* configPath, const char* backupPath)
+bool FileHandler::migrateConfig(const char* backupPath)
 {
+    // Config already matches Firmware.
+    if (strcmp(config["version"] | "", VERSION) == 0)
+        return true;
+
     // Load Backup File.
     File backupFile = LittleFS.open(backupPath, "r");
     if (!backupFile)
@@ -195,38 +477,20 @@ bool FileHandler::mergeConfigFromBackup(const char* configPath, const char* back
         return false;
     }
 
-    // Load Primary File.
-    File configFile = LittleFS.open(configPath, "r");
-    JsonDocument configDoc;
-
-    if (configFile)
-    {
-        DeserializationError configError = deserializeJson(configDoc, configFile);
-        configFile.close();
-
-        if (configError)
-        {
-            Serial.print("P500 ");
-            Serial.println(configError.c_str());
-            configDoc.clear();
-        }
-    }
-
     // Add missing Keys.
-    mergeJsonObjects(configDoc, backupDoc);
+    mergeJsonObjects(config, backupDoc);
 
-    // Save missing Keys.
-    File outputFile = LittleFS.open(configPath, "w");
-    if (!outputFile)
-    {
-        Serial.println("W500");
+    // Bump Config Version.
+    config["version"] = VERSION;
+
+    // Save migrated Config.
+    if (!storeConfig())
         return false;
-    }
 
-    serializeJsonPretty(configDoc, outputFile);
-    outputFile.close();
+#if DEBUG == true
+    Serial.printf("Config migrated to %s\n", VERSION);
+#endif
 
-    Serial.println("WOK");
     return true;
 }
 
@@ -262,7 +526,7 @@ void FileHandler::mergeJsonObjects(JsonVariant target, JsonVariant source)
             // If Primary Config is missing Object, add new one.
             if (!target[p.key()].is<JsonObject>())
             {
-                target[p.key()] = target.to<JsonObject>().createNestedObject(p.key());
+                target[p.key()].to<JsonObject>();
             }
 
             // Rekursiv merge
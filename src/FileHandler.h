@@ -6,20 +6,33 @@
 #define FILEHANDLER_H
 #include <Arduino.h>
 #include <ArduinoJson.h>
+#include <FS.h>
+
+#include "ConfigStore.h"
 
 
 class FileHandler
 {
+private:
+    static bool parseConfig(const char* path);
+    static bool loadBinary(const char* path);
+    static bool writeBinary(const char* path);
+    static bool writeJson(const char* path);
+    static ConfigFiles getFiles();
+    static bool commitFile(fs::File& file, const String& temp, const char* path, bool complete);
+
 public:
     static void begin();
-    static String readFile(const char* path);
+    static bool readJson(const char* path, JsonDocument& doc);
     static JsonDocument loadConfig();
-    static void saveFile(const char* str, const String& string);
+    static bool saveFile(const char* str, const String& string);
+    static bool saveFile(const char* str, const uint8_t* data, size_t length);
     static JsonDocument getConfig();
     static void saveConfig(JsonObject object);
+    static bool storeConfig();
     static bool copyFile(const char* source, const char* destination);
     static void reset();
-    static bool mergeConfigFromBackup(const char* configPath, const char* backupPath);
+    static bool migrateConfig(const char* backupPath);
     static void mergeJsonObjects(JsonVariant target, JsonVariant source);
     static JsonDocument config;
 };
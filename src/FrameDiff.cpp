@@ -0,0 +1,101 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#include "FrameDiff.h"
+#include <string.h>
+
+#include "InternalConfig.h"
+
+// Store last transmitted Frame (1 Bit per Pixel, 8 Pages of OLED_WIDTH Columns).
+uint8_t frameShadow[OLED_WIDTH * OLED_HEIGHT / 8];
+bool frameShadowValid = false;
+
+/**
+ * Forces a full Transfer on the next Flush (eq. after the Display Reset).
+ */
+void FrameDiff::invalidate()
+{
+    frameShadowValid = false;
+}
+
+/**
+ * Finds the changed Column Range of a Page.
+ *
+ * @param row The rendered Page (OLED_WIDTH Columns).
+ * @param shadow The transmitted Page.
+ * @param first The first changed Column.
+ * @param last The last changed Column.
+ * @return False if the Page is unchanged.
+ */
+bool FrameDiff::findRange(const uint8_t* row, const uint8_t* shadow, uint8_t* first, uint8_t* last)
+{
+    int start = 0;
+    int end = OLED_WIDTH - 1;
+
+    while (start < OLED_WIDTH && row[start] == shadow[start])
+        start++;
+
+    if (start == OLED_WIDTH)
+        return false;
+
+    while (row[end] == shadow[end])
+        end--;
+
+    *first = start;
+    *last = end;
+
+    return true;
+}
+
+/**
+ * Transmits the changed Parts of the Framebuffer.
+ *
+ * For every Page containing Changes the Address Window is set to the Column
+ * Range between the first and last changed Column, unchanged Pages are
+ * skipped. If nothing changed, nothing is transmitted at all.
+ *
+ * @param bus The Display Transfers.
+ * @param frame The rendered Framebuffer.
+ * @return The Number of transmitted Data Bytes.
+ */
+uint32_t FrameDiff::flush(const DisplayBus& bus, const uint8_t* frame)
+{
+    uint32_t bytes = 0;
+
+    for (uint8_t page = 0; page < OLED_HEIGHT / 8; page++)
+    {
+        const uint8_t* row = frame + (page * OLED_WIDTH);
+        uint8_t* shadow = frameShadow + (page * OLED_WIDTH);
+
+        uint8_t first = 0;
+        uint8_t last = OLED_WIDTH - 1;
+
+        if (frameShadowValid && !findRange(row, shadow, &first, &last))
+            continue;
+
+        // Set Address Window.
+        bus.command(FRAME_PAGEADDR);
+        bus.command(page);
+        bus.command(page);
+        bus.command(FRAME_COLUMNADDR);
+        bus.command(first);
+        bus.command(last);
+
+        // Send Data in Chunks of the Bus.
+        for (size_t column = first; column <= last; column += bus.chunk)
+        {
+            size_t length = last + 1 - column;
+
+            bus.data(row + column, length < bus.chunk ? length : bus.chunk);
+        }
+
+        bytes += (last - first) + 1;
+
+        memcpy(shadow + first, row + first, (last - first) + 1);
+    }
+
+    frameShadowValid = true;
+
+    return bytes;
+}
@@ -0,0 +1,44 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#ifndef FRAMEDIFF_H
+#define FRAMEDIFF_H
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Define SSD1306 Addressing Commands (Horizontal Addressing Mode).
+ */
+#define FRAME_COLUMNADDR 0x21
+#define FRAME_PAGEADDR 0x22
+
+/**
+ * Define Transfers to the Display (I2C on the Device, a Display RAM Mock in
+ * the native Tests). `data` sends at most `chunk` Bytes per Call.
+ */
+struct DisplayBus
+{
+    void (*command)(uint8_t command);
+    void (*data)(const uint8_t* bytes, size_t length);
+    size_t chunk;
+};
+
+
+/**
+ * Compares the rendered Framebuffer against the last transmitted Frame and
+ * only transmits the changed Column Range of every changed Page.
+ *
+ * Free of Arduino Dependencies, so the Transfers are counted against a
+ * Display RAM Mock in the native Tests.
+ */
+class FrameDiff
+{
+public:
+    static void invalidate();
+    static bool findRange(const uint8_t* row, const uint8_t* shadow, uint8_t* first, uint8_t* last);
+    static uint32_t flush(const DisplayBus& bus, const uint8_t* frame);
+};
+
+
+#endif //FRAMEDIFF_H
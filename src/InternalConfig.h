@@ -16,6 +16,69 @@
 #define MQTT_INTERVAL 1000
 #define AUTO_INTERVAL 1000
 
+/**
+ * Define Time (ms) to wait for the first IP before the AP is started next to
+ * the Station. The Connection runs in the Background, Boot never waits.
+ */
+#define WIFI_BOOT_TIMEOUT 15000
+
+/**
+ * Define Reconnect Backoff (ms), the Delay doubles after every failed Attempt.
+ * A failed Attempt on the cached BSSID/Channel falls back to a full Scan.
+ */
+#define WIFI_RETRY_MIN 4000
+#define WIFI_RETRY_MAX 60000
+
+/**
+ * Define Roaming: if the RSSI (dBm) stays below the Threshold for
+ * WIFI_ROAM_SAMPLES Checks (every WIFI_ROAM_INTERVAL ms), a Background Scan
+ * looks for a known BSSID at least WIFI_ROAM_HYSTERESIS dB stronger. Scans
+ * are at most started every WIFI_ROAM_COOLDOWN ms to avoid Flapping.
+ */
+#define WIFI_NETWORKS_MAX 4
+#define WIFI_ROAM_THRESHOLD (-75)
+#define WIFI_ROAM_HYSTERESIS 8
+#define WIFI_ROAM_INTERVAL 10000
+#define WIFI_ROAM_SAMPLES 3
+#define WIFI_ROAM_COOLDOWN 300000
+
+/**
+ * Define mDNS TXT Check Interval (ms) and the minimum Level Change (%) that is
+ * announced.
+ */
+#define MDNS_INTERVAL 5000
+#define MDNS_LEVEL_STEP 2.0f
+
+/**
+ * Define Modbus TCP Port, maximum Clients and Register Image Refresh (ms).
+ */
+#define MODBUS_PORT 502
+#define MODBUS_CLIENTS 4
+#define MODBUS_INTERVAL 100
+
+/**
+ * Define Memory Sampling: Interval (ms), Ring Buffer Size and default
+ * Low-Memory Thresholds (Bytes, overridden by "memory.heap" and
+ * "memory.block"). MEMORY_LOW_SAMPLES low Samples in a Row restart the Device.
+ */
+#define MEMORY_INTERVAL 60000
+#define MEMORY_SAMPLES 32
+#define MEMORY_MIN_HEAP 16384
+#define MEMORY_MIN_BLOCK 4096
+#define MEMORY_LOW_SAMPLES 3
+
+/**
+ * Define binary Config Format (/config.bin).
+ * Increase CONFIG_SCHEMA if the Header Layout changes.
+ */
+#define CONFIG_MAGIC 0x46434C42
+#define CONFIG_SCHEMA 1
+
+/**
+ * Define Block Size for streamed File Copies.
+ */
+#define FILE_BLOCK 512
+
 /**
  * Define Display Settings.
  */
@@ -24,6 +87,21 @@
 #define OLED_RESET     -1
 #define SCREEN_ADDRESS 0x3D
 
+/**
+ * Define Burn-In Protection.
+ * DISPLAY_SHIFT_INTERVAL => Shift Layout by one Pixel (ms).
+ * DISPLAY_DIM_TIMEOUT => Dim if the Content did not change (ms).
+ */
+#define DISPLAY_SHIFT_INTERVAL 60000
+#define DISPLAY_DIM_TIMEOUT 300000
+#define DISPLAY_DIM_LEVEL 16
+
+/**
+ * Define Layout Limits (compiled /layout.json).
+ */
+#define LAYOUT_OPS 48
+#define LAYOUT_TEXT_POOL 256
+
 /**
  * Define EMA Filtering
  * 0.05 very good, very slow => 5% from new Value
@@ -32,6 +110,25 @@
  */
 #define EMA_ALPHA 0.3
 
+/**
+ * Define Sensor Registry.
+ * Sensor 0 is always the built-in Tank Input (SENSE), further Sensors are
+ * configured in "sensors". All Sensors share SCAN_INTERVAL round-robin.
+ */
+#define SENSOR_MAX 8
+#define SENSOR_SAMPLES 16
+#define SENSOR_STACK 3072
+
+/**
+ * Define ADC Linearization Table (eFuse Characterization and Calibration Points).
+ * One Entry every 2^ADC_TABLE_SHIFT Counts of the 12 Bit ADC.
+ * ADC_POINTS => Maximum Number of Calibration Points ("calibration.points").
+ * ADC_TC_REFERENCE => Temperature (°C) without Drift Compensation.
+ */
+#define ADC_TABLE_SHIFT 6
+#define ADC_POINTS 8
+#define ADC_TC_REFERENCE 25
+
 /**
  * Define Pinouts.
  */
@@ -41,6 +138,30 @@
 #define SENSE 3
 #define RESET 6
 
+/**
+ * Define Relais Channel Table (Channel 1..N).
+ * {Pin, Active High, maximum On-Time in Seconds (0 = unlimited)}
+ * Expansion Boards may override the Table via build_flags, eq.
+ * -D RELAIS_TABLE="{{0,true,0},{1,true,0},{4,false,600}}"
+ */
+#ifndef RELAIS_TABLE
+#define RELAIS_TABLE {{RELAIS_CH1, true, 0}, {RELAIS_CH2, true, 0}}
+#endif
+
+/**
+ * Define default minimum Gap between two Relais Starts in ms (Inrush Current).
+ */
+#define RELAIS_START_GAP 500
+
+/**
+ * Define Relais Statistics (Run Hours, Starts, Energy).
+ * STATS_INTERVAL => Flush Interval in ms, at most this Time is lost on Power Loss.
+ * STATS_SLOTS => Number of rotating Slot Files (/stats0.bin ...).
+ */
+#define STATS_MAGIC 0x53544154
+#define STATS_INTERVAL 900000
+#define STATS_SLOTS 4
+
 /**
  * Define default Automation.
  */
@@ -50,7 +171,24 @@
 
 /**
  * Define Update Server
+ * Can be overridden via build_flags (eq. -DUPDATE_SERVER=\"http://192.168.1.10:8080/versions.json\")
+ * to test against a local Stand-In.
  */
+#ifndef UPDATE_SERVER
 #define UPDATE_SERVER "https://space.byte-store.de/external/waterlevel/versions.json"
+#endif
+
+/**
+ * Define Update Task Settings.
+ * UPDATE_TTL => Default Manifest Check Interval (ms), overridden by "update.interval" (s).
+ * UPDATE_AUTO => Install Updates without User Interaction.
+ * UPDATE_RETRY_MIN / UPDATE_RETRY_MAX => Backoff (ms) before a failed Version
+ * is installed again automatically, doubled after every Failure.
+ */
+#define UPDATE_TTL 3600000
+#define UPDATE_AUTO true
+#define UPDATE_STACK 8192
+#define UPDATE_RETRY_MIN 600000
+#define UPDATE_RETRY_MAX 86400000
 
 #endif //INTERNALCONFIG_H
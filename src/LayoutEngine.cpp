@@ -0,0 +1,342 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#include "LayoutEngine.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "InternalConfig.h"
+
+// Define Layout Opcodes.
+#define LAYOUT_CURSOR 0
+#define LAYOUT_TEXT 1
+#define LAYOUT_VALUE 2
+#define LAYOUT_NEWLINE 3
+#define LAYOUT_LINE 4
+#define LAYOUT_RECT 5
+#define LAYOUT_FILL 6
+#define LAYOUT_LEVEL 7
+
+// Define Binding Names (Index = BIND_*).
+const char* const layoutBindings[] = {
+    "level", "volume", "voltage", "current", "rssi", "cpu", "relay1", "relay2", "wifi", "heap", "block", "minheap",
+    "stack"
+};
+
+// Define compiled Operation (16 Bytes).
+struct LayoutOp
+{
+    uint8_t op;
+    uint8_t binding;
+    uint8_t decimals;
+    uint8_t color;
+    int16_t args[4];
+    uint16_t text;
+};
+
+// Store compiled Layout.
+LayoutOp layoutOps[LAYOUT_OPS];
+uint8_t layoutCount = 0;
+
+// Store Text Pool (zero terminated Strings referenced by LayoutOp::text).
+char layoutText[LAYOUT_TEXT_POOL];
+uint16_t layoutTextLength = 0;
+
+// Define builtin Layout (used if /layout.json is missing or invalid).
+const char layoutDefault[] = R"([
+  {"op": "setCursor", "x": 0, "y": 0},
+  {"op": "print", "text": "BYTELEVEL"},
+  {"op": "drawLine", "x0": 0, "y0": 9, "x1": 128, "y1": 9, "color": 1},
+  {"op": "setCursor", "x": 0, "y": 18},
+  {"op": "println", "text": "WiFi: {wifi}"},
+  {"op": "println", "text": "Level: {level:1}%"},
+  {"op": "println", "text": "Volume: {volume:1}L"},
+  {"op": "println", "text": "ADC: {voltage:2}V"},
+  {"op": "println", "text": "Current: {current:2}mA"},
+  {"op": "drawRect", "x": 95, "y": 18, "w": 30, "h": 40, "color": 1},
+  {"op": "fillLevel", "x": 97, "y": 20, "w": 26, "h": 36, "color": 1, "value": "level"}
+])";
+
+// Define builtin Debug Layout (Heap and Stacks in KB, "hardware.debug").
+const char layoutDebug[] = R"([
+  {"op": "setCursor", "x": 0, "y": 0},
+  {"op": "print", "text": "DEBUG"},
+  {"op": "drawLine", "x0": 0, "y0": 9, "x1": 128, "y1": 9, "color": 1},
+  {"op": "setCursor", "x": 0, "y": 18},
+  {"op": "println", "text": "Heap: {heap:1}K"},
+  {"op": "println", "text": "Min:  {minheap:1}K"},
+  {"op": "println", "text": "Block: {block:1}K"},
+  {"op": "println", "text": "Stack: {stack:2}K"},
+  {"op": "println", "text": "Level: {level:1}%"}
+])";
+
+/**
+ * Compiles a Layout Array into `layoutOps`.
+ *
+ * @param layout The Array of Drawing Operations.
+ * @return True if every Operation has been compiled.
+ */
+bool LayoutEngine::compile(JsonArrayConst layout)
+{
+    layoutCount = 0;
+    layoutTextLength = 0;
+
+    if (layout.isNull())
+        return false;
+
+    for (JsonObjectConst entry : layout)
+    {
+        const char* op = entry["op"] | "";
+        uint8_t color = entry["color"] | 1;
+        bool ok = true;
+
+        if (strcmp(op, "setCursor") == 0)
+        {
+            ok = addOp(LAYOUT_CURSOR, entry["x"].as<int>(), entry["y"].as<int>(), 0, 0, color);
+        }
+        else if (strcmp(op, "print") == 0 || strcmp(op, "println") == 0)
+        {
+            ok = compileText(entry["text"] | "", strcmp(op, "println") == 0);
+        }
+        else if (strcmp(op, "drawLine") == 0)
+        {
+            ok = addOp(LAYOUT_LINE, entry["x0"].as<int>(), entry["y0"].as<int>(), entry["x1"].as<int>(),
+                       entry["y1"].as<int>(), color);
+        }
+        else if (strcmp(op, "drawRect") == 0 || strcmp(op, "fillRect") == 0)
+        {
+            ok = addOp((strcmp(op, "drawRect") == 0 ? LAYOUT_RECT : LAYOUT_FILL), entry["x"].as<int>(),
+                       entry["y"].as<int>(), entry["w"].as<int>(), entry["h"].as<int>(), color);
+        }
+        else if (strcmp(op, "fillLevel") == 0)
+        {
+            const char* value = entry["value"] | "level";
+            int8_t binding = findBinding(value, strlen(value));
+
+            ok = binding >= 0 && addOp(LAYOUT_LEVEL, entry["x"].as<int>(), entry["y"].as<int>(),
+                                       entry["w"].as<int>(), entry["h"].as<int>(), color);
+
+            if (ok)
+                layoutOps[layoutCount - 1].binding = binding;
+        }
+        else
+        {
+            ok = false;
+        }
+
+        // Unknown Operation or Layout too large.
+        if (!ok)
+        {
+            layoutCount = 0;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Splits a Text into static Text and Value Operations.
+ *
+ * "Level: {level:1}%" compiles into TEXT "Level: ", VALUE level (1 Decimal)
+ * and TEXT "%".
+ *
+ * @param text The Text including Bindings.
+ * @param newline True to append a Line Break (println).
+ * @return True on Success.
+ */
+bool LayoutEngine::compileText(const char* text, bool newline)
+{
+    uint16_t start = layoutTextLength;
+
+    while (true)
+    {
+        char c = *text;
+
+        // Flush static Text before Binding or End.
+        if ((c == '{' || c == '\0') && layoutTextLength > start)
+        {
+            if (layoutTextLength >= LAYOUT_TEXT_POOL || !addOp(LAYOUT_TEXT, 0, 0, 0, 0, 1))
+                return false;
+
+            layoutText[layoutTextLength++] = '\0';
+            layoutOps[layoutCount - 1].text = start;
+            start = layoutTextLength;
+        }
+
+        if (c == '\0')
+            break;
+
+        if (c == '{')
+        {
+            const char* end = strchr(text, '}');
+
+            if (end == NULL)
+                return false;
+
+            // Split Name and Decimals.
+            const char* colon = (const char*)memchr(text + 1, ':', end - text - 1);
+            int8_t binding = findBinding(text + 1, (colon != NULL ? colon : end) - text - 1);
+
+            if (binding < 0 || !addOp(LAYOUT_VALUE, 0, 0, 0, 0, 1))
+                return false;
+
+            layoutOps[layoutCount - 1].binding = binding;
+            layoutOps[layoutCount - 1].decimals = (colon != NULL ? atoi(colon + 1) : 0);
+
+            text = end + 1;
+            continue;
+        }
+
+        if (layoutTextLength >= LAYOUT_TEXT_POOL - 1)
+            return false;
+
+        layoutText[layoutTextLength++] = c;
+        text++;
+    }
+
+    return !newline || addOp(LAYOUT_NEWLINE, 0, 0, 0, 0, 1);
+}
+
+/**
+ * Appends an Operation to the compiled Layout.
+ *
+ * @return False if the Layout is full.
+ */
+bool LayoutEngine::addOp(uint8_t op, int16_t a, int16_t b, int16_t c, int16_t d, uint8_t color)
+{
+    if (layoutCount >= LAYOUT_OPS)
+        return false;
+
+    LayoutOp& entry = layoutOps[layoutCount++];
+
+    entry.op = op;
+    entry.binding = 0;
+    entry.decimals = 0;
+    entry.color = color;
+    entry.args[0] = a;
+    entry.args[1] = b;
+    entry.args[2] = c;
+    entry.args[3] = d;
+    entry.text = 0;
+
+    return true;
+}
+
+/**
+ * Resolves a Binding Name.
+ *
+ * @param name The Name (not zero terminated).
+ * @param length The Length of the Name.
+ * @return The Binding Index or -1 if unknown.
+ */
+int8_t LayoutEngine::findBinding(const char* name, size_t length)
+{
+    for (uint8_t i = 0; i < sizeof(layoutBindings) / sizeof(layoutBindings[0]); i++)
+    {
+        if (strlen(layoutBindings[i]) == length && strncmp(layoutBindings[i], name, length) == 0)
+            return i;
+    }
+
+    return -1;
+}
+
+/**
+ * Retrieves the Number of compiled Operations.
+ *
+ * @return The Number of Operations, `0` if the last Compile failed.
+ */
+uint8_t LayoutEngine::getCount()
+{
+    return layoutCount;
+}
+
+/**
+ * Renders the compiled Layout.
+ *
+ * The Framebuffer has to be cleared before, transmitting it is up to the Caller.
+ *
+ * @param canvas The Drawing Operations.
+ * @param dx Horizontal Offset of every Operation (Burn-In Protection).
+ * @param dy Vertical Offset of every Operation (Burn-In Protection).
+ */
+void LayoutEngine::render(const LayoutCanvas& canvas, int16_t dx, int16_t dy)
+{
+    for (uint8_t i = 0; i < layoutCount; i++)
+    {
+        const LayoutOp& entry = layoutOps[i];
+        const int16_t* args = entry.args;
+
+        switch (entry.op)
+        {
+        case LAYOUT_CURSOR:
+            canvas.setCursor(args[0] + dx, args[1] + dy);
+            break;
+        case LAYOUT_TEXT:
+            canvas.print(layoutText + entry.text);
+            break;
+        case LAYOUT_VALUE:
+            printBinding(canvas, entry.binding, entry.decimals);
+            break;
+        case LAYOUT_NEWLINE:
+            canvas.newline();
+            break;
+        case LAYOUT_LINE:
+            canvas.drawLine(args[0] + dx, args[1] + dy, args[2] + dx, args[3] + dy, entry.color);
+            break;
+        case LAYOUT_RECT:
+            canvas.drawRect(args[0] + dx, args[1] + dy, args[2], args[3], entry.color);
+            break;
+        case LAYOUT_FILL:
+            canvas.fillRect(args[0] + dx, args[1] + dy, args[2], args[3], entry.color);
+            break;
+        case LAYOUT_LEVEL:
+            {
+                // Fill from Bottom proportional to Value.
+                float value = canvas.getBinding(entry.binding);
+
+                if (!(value > 0.0f))
+                    value = 0.0f;
+                else if (value > 100.0f)
+                    value = 100.0f;
+
+                int16_t height = (int16_t)((args[3] * value) / 100.0f);
+
+                if (height > 0)
+                    canvas.fillRect(args[0] + dx, args[1] + dy + args[3] - height, args[2], height, entry.color);
+            }
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+/**
+ * Prints the live Value of a Binding.
+ *
+ * @param canvas The Drawing Operations.
+ * @param binding The Binding Index.
+ * @param decimals The Number of Decimals for numeric Values.
+ */
+void LayoutEngine::printBinding(const LayoutCanvas& canvas, uint8_t binding, uint8_t decimals)
+{
+    char text[24];
+
+    switch (binding)
+    {
+    case BIND_WIFI:
+        canvas.print(canvas.getBinding(binding) > 0 ? "OK" : "AP");
+        break;
+    case BIND_RELAY1:
+    case BIND_RELAY2:
+        canvas.print(canvas.getBinding(binding) > 0 ? "ON" : "OFF");
+        break;
+    default:
+        snprintf(text, sizeof(text), "%.*f", decimals, canvas.getBinding(binding));
+        canvas.print(text);
+        break;
+    }
+}
@@ -0,0 +1,69 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#ifndef LAYOUTENGINE_H
+#define LAYOUTENGINE_H
+#include <ArduinoJson.h>
+#include <stdint.h>
+
+/**
+ * Define Bindings (Index of `layoutBindings`).
+ */
+#define BIND_LEVEL 0
+#define BIND_VOLUME 1
+#define BIND_VOLTAGE 2
+#define BIND_CURRENT 3
+#define BIND_RSSI 4
+#define BIND_CPU 5
+#define BIND_RELAY1 6
+#define BIND_RELAY2 7
+#define BIND_WIFI 8
+#define BIND_HEAP 9
+#define BIND_BLOCK 10
+#define BIND_MINHEAP 11
+#define BIND_STACK 12
+
+/**
+ * Define Drawing Operations of a Frame (the SSD1306 on the Device, a
+ * Framebuffer in the native Tests). `getBinding` reads the live Values.
+ */
+struct LayoutCanvas
+{
+    void (*setCursor)(int16_t x, int16_t y);
+    void (*print)(const char* text);
+    void (*newline)();
+    void (*drawLine)(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t color);
+    void (*drawRect)(int16_t x, int16_t y, int16_t w, int16_t h, uint8_t color);
+    void (*fillRect)(int16_t x, int16_t y, int16_t w, int16_t h, uint8_t color);
+    float (*getBinding)(uint8_t binding);
+};
+
+// Builtin Layouts (Status and Debug Screen).
+extern const char layoutDefault[];
+extern const char layoutDebug[];
+
+
+/**
+ * Compiles a Layout (the Format of `layout.json`) into a compact Op Array and
+ * renders it with live Values.
+ *
+ * Free of Arduino Dependencies, so the Layouts are rendered into a
+ * Framebuffer in the native Tests.
+ */
+class LayoutEngine
+{
+private:
+    static bool compileText(const char* text, bool newline);
+    static bool addOp(uint8_t op, int16_t a, int16_t b, int16_t c, int16_t d, uint8_t color);
+    static void printBinding(const LayoutCanvas& canvas, uint8_t binding, uint8_t decimals);
+
+public:
+    static bool compile(JsonArrayConst layout);
+    static int8_t findBinding(const char* name, size_t length);
+    static uint8_t getCount();
+    static void render(const LayoutCanvas& canvas, int16_t dx, int16_t dy);
+};
+
+
+#endif //LAYOUTENGINE_H
@@ -0,0 +1,160 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#include "LayoutHandler.h"
+#include <LittleFS.h>
+
+#include "DeviceHandler.h"
+#include "FileHandler.h"
+#include "InternalConfig.h"
+#include "LayoutEngine.h"
+#include "MemoryHandler.h"
+#include "RelaisHandler.h"
+#include "WiFiHandler.h"
+
+// Store Display of the running Render (the Canvas Operations are plain Functions).
+Adafruit_SSD1306* layoutDisplay = NULL;
+
+/**
+ * Loads and compiles the builtin Debug Layout (Memory Telemetry).
+ */
+void LayoutHandler::loadDebug()
+{
+    JsonDocument doc;
+
+    deserializeJson(doc, layoutDebug);
+    LayoutEngine::compile(doc.as<JsonArrayConst>());
+}
+
+/**
+ * Loads and compiles the Display Layout.
+ *
+ * The Layout is an Array of Drawing Operations (the Format of `layout.json`).
+ * It is compiled once into the compact `layoutOps` Array, so rendering a Frame
+ * does not touch JSON or parse Strings. If the File is missing or invalid,
+ * the builtin Layout is used.
+ *
+ * Supported Operations:
+ * - setCursor (x, y)
+ * - print / println (text), Text may contain Bindings like `{level:1}`
+ *   (Name and optional Decimals).
+ * - drawLine (x0, y0, x1, y1, color)
+ * - drawRect / fillRect (x, y, w, h, color)
+ * - fillLevel (x, y, w, h, color, value) => fills the Rect from the Bottom
+ *   proportional to the bound Value (0-100).
+ *
+ * Bindings: level, volume, voltage, current, rssi, cpu, relay1, relay2, wifi,
+ * heap, minheap, block (KB) and stack (lowest free Stack in KB).
+ *
+ * @param path The Path of the Layout File.
+ */
+void LayoutHandler::load(const char* path)
+{
+    JsonDocument doc;
+
+    if (LittleFS.exists(path) && FileHandler::readJson(path, doc) && LayoutEngine::compile(doc.as<JsonArrayConst>()))
+    {
+#if DEBUG == true
+        Serial.printf("Layout %s: %u ops\n", path, LayoutEngine::getCount());
+#endif
+        return;
+    }
+
+#if DEBUG == true
+    Serial.printf("Layout %s missing or invalid, using builtin\n", path);
+#endif
+
+    // Fall back to builtin Layout.
+    deserializeJson(doc, layoutDefault);
+    LayoutEngine::compile(doc.as<JsonArrayConst>());
+}
+
+/**
+ * Renders the compiled Layout into the Framebuffer (see `LayoutEngine::render()`).
+ *
+ * The Framebuffer has to be cleared before, transmitting it is up to the Caller.
+ *
+ * @param display The Display to draw on.
+ * @param dx Horizontal Offset of every Operation (Burn-In Protection).
+ * @param dy Vertical Offset of every Operation (Burn-In Protection).
+ */
+void LayoutHandler::render(Adafruit_SSD1306& display, int16_t dx, int16_t dy)
+{
+    layoutDisplay = &display;
+
+    LayoutCanvas canvas = {
+        [](int16_t x, int16_t y) { layoutDisplay->setCursor(x, y); },
+        [](const char* text) { layoutDisplay->print(text); },
+        []() { layoutDisplay->println(); },
+        [](int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t color)
+        {
+            layoutDisplay->drawLine(x0, y0, x1, y1, color);
+        },
+        [](int16_t x, int16_t y, int16_t w, int16_t h, uint8_t color) { layoutDisplay->drawRect(x, y, w, h, color); },
+        [](int16_t x, int16_t y, int16_t w, int16_t h, uint8_t color) { layoutDisplay->fillRect(x, y, w, h, color); },
+        getBinding
+    };
+
+    LayoutEngine::render(canvas, dx, dy);
+}
+
+/**
+ * Reads the live Value of a Binding from the cached Scan Values.
+ *
+ * @param binding The Binding Index.
+ * @return The Value (Booleans as 0/1).
+ */
+float LayoutHandler::getBinding(uint8_t binding)
+{
+    switch (binding)
+    {
+    case BIND_LEVEL:
+        return DeviceHandler::getLevelCached();
+    case BIND_VOLUME:
+        return DeviceHandler::getVolumeCached();
+    case BIND_VOLTAGE:
+        return DeviceHandler::getADCValueCached();
+    case BIND_CURRENT:
+        return DeviceHandler::getCurrentCached();
+    case BIND_RSSI:
+        return WiFiHandler::getRSSI();
+    case BIND_CPU:
+        return DeviceHandler::getCPUTemperatureCached();
+    case BIND_RELAY1:
+        return RelaisHandler::getState(1);
+    case BIND_RELAY2:
+        return RelaisHandler::getState(2);
+    case BIND_WIFI:
+        return WiFiHandler::isConnected();
+    case BIND_HEAP:
+        return MemoryHandler::getSample(0).free / 1024.0f;
+    case BIND_BLOCK:
+        return MemoryHandler::getSample(0).largest / 1024.0f;
+    case BIND_MINHEAP:
+        return MemoryHandler::getSample(0).minimum / 1024.0f;
+    case BIND_STACK:
+        return getLowestStack() / 1024.0f;
+    default:
+        return 0.0f;
+    }
+}
+
+/**
+ * Retrieves the lowest Stack High-Water Mark of the newest Memory Sample.
+ *
+ * @return The free Stack in Bytes of the Task closest to an Overflow.
+ */
+uint16_t LayoutHandler::getLowestStack()
+{
+    MemorySample sample = MemoryHandler::getSample(0);
+    uint16_t lowest = sample.loopStack;
+
+    if (sample.tcpStack != 0 && sample.tcpStack < lowest)
+        lowest = sample.tcpStack;
+
+    if (sample.sensorStack != 0 && sample.sensorStack < lowest)
+        lowest = sample.sensorStack;
+
+    return lowest;
+}
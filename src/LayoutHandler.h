@@ -0,0 +1,24 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#ifndef LAYOUTHANDLER_H
+#define LAYOUTHANDLER_H
+#include <Adafruit_SSD1306.h>
+#include <ArduinoJson.h>
+
+
+class LayoutHandler
+{
+private:
+    static float getBinding(uint8_t binding);
+    static uint16_t getLowestStack();
+
+public:
+    static void load(const char* path);
+    static void loadDebug();
+    static void render(Adafruit_SSD1306& display, int16_t dx, int16_t dy);
+};
+
+
+#endif //LAYOUTHANDLER_H
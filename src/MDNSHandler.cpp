@@ -0,0 +1,102 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#include "MDNSHandler.h"
+#include <ESPmDNS.h>
+#include "DeviceHandler.h"
+#include "FileHandler.h"
+#include "InternalConfig.h"
+#include "SensorHandler.h"
+
+// Store if the Responder is running.
+bool mdnsStarted = false;
+
+// Store last TXT Check Timestamp.
+unsigned long lastMDNSUpdate = 0;
+
+// Store published TXT Values (only Changes are announced).
+float mdnsLevel = NAN;
+int mdnsFaults = -1;
+
+/**
+ * Starts the mDNS Responder and advertises the Device.
+ *
+ * The Hostname is the AP SSID (like the OTA Hostname). `_http._tcp` points
+ * Browsers to the Web Interface, `_bytelevel._tcp` carries the Firmware
+ * Version (`ver`), Device ID (`id`), Level (`lvl`) and Fault Flags (`flt`),
+ * so a Fleet Scanner needs one Multicast Query instead of polling every IP.
+ * If OTA is enabled, the `_arduino._tcp` Service is advertised here as well.
+ */
+void MDNSHandler::setup()
+{
+    JsonDocument config = FileHandler::getConfig();
+
+    if (!MDNS.begin(config["wifi"]["ap"]["ssid"].as<String>().c_str()))
+    {
+        Serial.println("mDNS failed");
+        return;
+    }
+
+    mdnsStarted = true;
+
+    // Web Interface.
+    MDNS.addService("http", "tcp", 80);
+
+    // Device Service with Status Records.
+    char id[13];
+    snprintf(id, sizeof(id), "%012llx", ESP.getEfuseMac());
+
+    MDNS.addService("bytelevel", "tcp", 80);
+    MDNS.addServiceTxt("bytelevel", "tcp", "ver", VERSION);
+    MDNS.addServiceTxt("bytelevel", "tcp", "id", id);
+
+    updateRecords(true);
+
+    // Local OTA (ArduinoOTA has its own mDNS disabled).
+    if (config["ota"].as<bool>())
+        MDNS.enableArduino(3232, config["admin"]["state"].as<bool>());
+
+#if DEBUG == true
+    Serial.println("mDNS started");
+#endif
+}
+
+/**
+ * Checks the TXT Records every MDNS_INTERVAL.
+ */
+void MDNSHandler::loop()
+{
+    if (!mdnsStarted || millis() - lastMDNSUpdate < MDNS_INTERVAL)
+        return;
+
+    lastMDNSUpdate = millis();
+
+    updateRecords(false);
+}
+
+/**
+ * Updates the Level and Fault Records.
+ *
+ * Every Change is announced by Multicast, so the Level is only updated if it
+ * moved by at least MDNS_LEVEL_STEP, Faults on every Change.
+ *
+ * @param force True to set the Records regardless of the last Values.
+ */
+void MDNSHandler::updateRecords(bool force)
+{
+    float level = SensorHandler::getLevel(SENSOR_TANK);
+    uint8_t faults = DeviceHandler::getFaults();
+
+    if (force || isnan(mdnsLevel) || fabsf(level - mdnsLevel) >= MDNS_LEVEL_STEP)
+    {
+        mdnsLevel = level;
+        MDNS.addServiceTxt("bytelevel", "tcp", "lvl", String(level, 0));
+    }
+
+    if (force || faults != mdnsFaults)
+    {
+        mdnsFaults = faults;
+        MDNS.addServiceTxt("bytelevel", "tcp", "flt", String(faults, HEX));
+    }
+}
@@ -0,0 +1,21 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#ifndef MDNSHANDLER_H
+#define MDNSHANDLER_H
+#include <Arduino.h>
+
+
+class MDNSHandler
+{
+private:
+    static void updateRecords(bool force);
+
+public:
+    static void setup();
+    static void loop();
+};
+
+
+#endif //MDNSHANDLER_H
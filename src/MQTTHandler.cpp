@@ -6,6 +6,10 @@
 #include "DeviceHandler.h"
 #include "FileHandler.h"
 #include "InternalConfig.h"
+#include "MemoryHandler.h"
+#include "RelaisHandler.h"
+#include "SensorHandler.h"
+#include "StatsHandler.h"
 #include "WiFiHandler.h"
 #include <espMqttClientAsync.h>
 
@@ -21,6 +25,14 @@ unsigned long previousMillisMQTT = 0;
 // Stores last Reconnect Timestamp.
 unsigned long reconnectMQTT = 0;
 
+// Stores Number of Connects since Boot.
+volatile uint32_t mqttConnects = 0;
+
+// Stores Broker Settings, the Client only keeps Pointers for its Reconnects.
+String mqttHost;
+String mqttUser;
+String mqttPassword;
+
 /**
  * @brief Sets the MQTT Last Will and Testament (LWT) message.
  *
@@ -54,6 +66,9 @@ void MQTTHandler::setLastWill()
  *
  * If the MQTT configuration is missing or incomplete, it logs appropriate debug/diagnostic messages.
  *
+ * Must only be called once (on the first IP), the Listeners would be registered
+ * again. Reconnects are handled by `loop()`.
+ *
  * Debugging output may be printed to `Serial` depending on the build configuration (e.g., with `DEBUG` enabled).
  */
 void MQTTHandler::setup()
@@ -62,21 +77,20 @@ void MQTTHandler::setup()
 
     if (config["mqtt"]["state"].as<bool>())
     {
-        // Set Enabled State.
-        isEnabled = true;
-
         reconnectMQTT = millis();
 
-        // Store strings in local variables to prevent temporary object destruction
-        String mqttHost = config["mqtt"]["host"].as<String>();
-        String mqttUser = config["mqtt"]["user"].as<String>();
-        String mqttPassword = config["mqtt"]["password"].as<String>();
+        mqttHost = config["mqtt"]["host"].as<String>();
+        mqttUser = config["mqtt"]["user"].as<String>();
+        mqttPassword = config["mqtt"]["password"].as<String>();
 
         int mqttPort = config["mqtt"]["port"].as<int>();
 
         // Check if Hostname is Set.
         if (mqttHost.length() > 0 && mqttPort > 0)
         {
+            // Set Enabled State.
+            isEnabled = true;
+
             // Set Client Destination.
             client.setServer(mqttHost.c_str(), mqttPort);
 
@@ -109,6 +123,8 @@ void MQTTHandler::setup()
             {
                 Serial.printf("MQTT connected, sessionPresent=%s\n", (sessionPresent ? "true" : "false"));
 
+                mqttConnects++;
+
                 // Reset last Will.
                 publish("waterlevel/status", "online");
             });
@@ -181,21 +197,60 @@ void MQTTHandler::loop()
                 // Voltage (Float)
                 publish("waterlevel/voltage", String(DeviceHandler::getADCValueCached(), 2).c_str());
 
-                // Channel 1 (Bool)
-                publish("waterlevel/channel/1/state", DeviceHandler::getState(1) ? "1" : "0");
+                for (uint8_t i = 1; i <= RelaisHandler::getCount(); i++)
+                {
+                    char topic[40];
+
+                    // Channel State (Bool)
+                    snprintf(topic, sizeof(topic), "waterlevel/channel/%u/state", i);
+                    publish(topic, RelaisHandler::getState(i) ? "1" : "0");
+
+                    // Channel Duration  (Int)
+                    snprintf(topic, sizeof(topic), "waterlevel/channel/%u/duration", i);
+                    publish(topic, String(RelaisHandler::getDuration(i)).c_str());
+
+                    // Channel Run Hours (Float)
+                    snprintf(topic, sizeof(topic), "waterlevel/channel/%u/hours", i);
+                    publish(topic, String(StatsHandler::getOnTime(i) / 3600000.0, 2).c_str());
+
+                    // Channel Starts (Int)
+                    snprintf(topic, sizeof(topic), "waterlevel/channel/%u/starts", i);
+                    publish(topic, String(StatsHandler::getStarts(i)).c_str());
+
+                    // Channel longest Run in s (Int)
+                    snprintf(topic, sizeof(topic), "waterlevel/channel/%u/longest", i);
+                    publish(topic, String(StatsHandler::getLongest(i) / 1000).c_str());
 
-                // Channel 1 Duration  (Int)
-                publish("waterlevel/channel/1/duration", String(DeviceHandler::getDuration(1)).c_str());
+                    // Channel Energy in kWh (Float)
+                    snprintf(topic, sizeof(topic), "waterlevel/channel/%u/energy", i);
+                    publish(topic, String(StatsHandler::getEnergy(i) / 1000.0f, 3).c_str());
+                }
 
-                // Channel 2 (Bool)
-                publish("waterlevel/channel/2/state", DeviceHandler::getState(2) ? "1" : "0");
+                // Additional Sensors (Sensor 0 is published as Voltage/Level/Volume).
+                for (uint8_t i = 1; i < SensorHandler::getCount(); i++)
+                {
+                    char topic[48];
 
-                // Channel 2 Duration  (Int)
-                publish("waterlevel/channel/2/duration", String(DeviceHandler::getDuration(2)).c_str());
+                    if (!SensorHandler::isValid(i))
+                        continue;
+
+                    snprintf(topic, sizeof(topic), "waterlevel/sensor/%s/value", SensorHandler::getName(i));
+                    publish(topic, String(SensorHandler::getValue(i), 2).c_str());
+
+                    snprintf(topic, sizeof(topic), "waterlevel/sensor/%s/level", SensorHandler::getName(i));
+                    publish(topic, String(SensorHandler::getLevel(i), 1).c_str());
+                }
 
                 // CPU Temperature
                 publish("waterlevel/cpu", String(DeviceHandler::getCPUTemperatureCached(), 1).c_str());
 
+                // Memory (Bytes)
+                MemorySample memory = MemoryHandler::getSample(0);
+
+                publish("waterlevel/memory/free", String(memory.free).c_str());
+                publish("waterlevel/memory/min", String(memory.minimum).c_str());
+                publish("waterlevel/memory/largest", String(memory.largest).c_str());
+
                 // Level (Float)
                 publish("waterlevel/level", String(DeviceHandler::getLevelCached(), 1).c_str());
 
@@ -214,10 +269,12 @@ void MQTTHandler::loop()
         }
         else
         {
-            if (currentMillis - reconnectMQTT > 5000)
+            // Reconnect with the Settings and Listeners of the Setup.
+            if (currentMillis - reconnectMQTT > 5000 && WiFiHandler::isConnected())
             {
-                // Rerun Setup.
-                setup();
+                reconnectMQTT = currentMillis;
+
+                client.connect();
             }
         }
     }
@@ -237,3 +294,13 @@ bool MQTTHandler::isConnected()
 {
     return client.connected();
 }
+
+/**
+ * Retrieves the Number of Broker Connects since Boot.
+ *
+ * @return The Number of Connects (Reconnects = Connects - 1).
+ */
+uint32_t MQTTHandler::getConnects()
+{
+    return mqttConnects;
+}
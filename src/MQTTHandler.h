@@ -4,6 +4,7 @@
 
 #ifndef MQTTHANDLER_H
 #define MQTTHANDLER_H
+#include <Arduino.h>
 
 class MQTTHandler
 {
@@ -13,6 +14,7 @@ public:
     static void publish(const char* topic, const char* payload);
     static void loop();
     static bool isConnected();
+    static uint32_t getConnects();
 };
 
 
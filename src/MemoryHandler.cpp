@@ -0,0 +1,161 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#include "MemoryHandler.h"
+#include <esp_heap_caps.h>
+#include "CrashHandler.h"
+#include "FileHandler.h"
+#include "InternalConfig.h"
+#include "RelaisHandler.h"
+#include "SensorHandler.h"
+#include "StatsHandler.h"
+
+// Store Ring Buffer of Samples (memoryHead = next Slot).
+MemorySample memorySamples[MEMORY_SAMPLES];
+uint8_t memoryHead = 0;
+uint8_t memoryCount = 0;
+portMUX_TYPE memoryMux = portMUX_INITIALIZER_UNLOCKED;
+
+// Store last Sample Timestamp.
+unsigned long memoryMillis = 0;
+
+// Store Low-Memory Thresholds (Bytes) and consecutive low Samples.
+uint32_t memoryMinHeap = MEMORY_MIN_HEAP;
+uint32_t memoryMinBlock = MEMORY_MIN_BLOCK;
+uint8_t memoryLow = 0;
+
+// Store AsyncTCP Task (looked up once it exists).
+TaskHandle_t tcpTask = NULL;
+
+/**
+ * Loads the Low-Memory Thresholds (`memory.heap`, `memory.block`) and takes
+ * the first Sample.
+ */
+void MemoryHandler::setup()
+{
+    JsonDocument config = FileHandler::getConfig();
+
+    memoryMinHeap = config["memory"]["heap"] | MEMORY_MIN_HEAP;
+    memoryMinBlock = config["memory"]["block"] | MEMORY_MIN_BLOCK;
+
+    sample();
+}
+
+/**
+ * Samples the Memory every MEMORY_INTERVAL, runs in the Loop Task.
+ */
+void MemoryHandler::loop()
+{
+    if (millis() - memoryMillis < MEMORY_INTERVAL)
+        return;
+
+    sample();
+}
+
+/**
+ * Takes a Sample into the Ring Buffer and checks the Thresholds.
+ *
+ * If the free Heap or the largest free Block stays below its Threshold for
+ * MEMORY_LOW_SAMPLES Samples in a Row, the Device restarts in a controlled
+ * Way before an Allocation fails somewhere (eq. in the TCP Stack).
+ */
+void MemoryHandler::sample()
+{
+    MemorySample current;
+
+    memoryMillis = millis();
+
+    if (tcpTask == NULL)
+        tcpTask = xTaskGetHandle("async_tcp");
+
+    TaskHandle_t sensorTask = SensorHandler::getTask();
+
+    current.time = memoryMillis / 1000;
+    current.free = ESP.getFreeHeap();
+    current.minimum = ESP.getMinFreeHeap();
+    current.largest = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+    current.loopStack = uxTaskGetStackHighWaterMark(NULL);
+    current.tcpStack = tcpTask != NULL ? uxTaskGetStackHighWaterMark(tcpTask) : 0;
+    current.sensorStack = sensorTask != NULL ? uxTaskGetStackHighWaterMark(sensorTask) : 0;
+
+    taskENTER_CRITICAL(&memoryMux);
+    memorySamples[memoryHead] = current;
+    memoryHead = (memoryHead + 1) % MEMORY_SAMPLES;
+
+    if (memoryCount < MEMORY_SAMPLES)
+        memoryCount++;
+    taskEXIT_CRITICAL(&memoryMux);
+
+    if (current.free < memoryMinHeap || current.largest < memoryMinBlock)
+    {
+        if (++memoryLow >= MEMORY_LOW_SAMPLES)
+            restart(current);
+    }
+    else
+        memoryLow = 0;
+}
+
+/**
+ * Restarts into a clean State: Relais off, Statistics flushed.
+ *
+ * @param sample The Sample which triggered the Restart.
+ */
+void MemoryHandler::restart(const MemorySample& sample)
+{
+    Serial.printf("Low Memory (%u free, %u block), restarting\n", sample.free, sample.largest);
+
+    for (uint8_t i = 1; i <= RelaisHandler::getCount(); i++)
+        RelaisHandler::set(i, false);
+
+    // Keep Run Hours since the last Flush.
+    StatsHandler::flush();
+
+    CrashHandler::markRestart(RESTART_MEMORY);
+    ESP.restart();
+}
+
+/**
+ * Retrieves the Number of stored Samples.
+ *
+ * @return The Number of Samples (up to MEMORY_SAMPLES).
+ */
+uint8_t MemoryHandler::getCount()
+{
+    return memoryCount;
+}
+
+/**
+ * Retrieves a stored Sample.
+ *
+ * @param age The Age of the Sample (0 = newest, up to getCount() - 1).
+ * @return The Sample, zeroed if the Age is invalid.
+ */
+MemorySample MemoryHandler::getSample(uint8_t age)
+{
+    MemorySample result = {};
+
+    taskENTER_CRITICAL(&memoryMux);
+
+    if (age < memoryCount)
+        result = memorySamples[(memoryHead + MEMORY_SAMPLES - 1 - age) % MEMORY_SAMPLES];
+
+    taskEXIT_CRITICAL(&memoryMux);
+
+    return result;
+}
+
+/**
+ * Calculates the Heap Fragmentation of the newest Sample.
+ *
+ * @return The Fragmentation in % (0 = the free Heap is one Block).
+ */
+uint8_t MemoryHandler::getFragmentation()
+{
+    MemorySample latest = getSample(0);
+
+    if (latest.free == 0)
+        return 0;
+
+    return 100 - (uint8_t)((uint64_t)latest.largest * 100 / latest.free);
+}
@@ -0,0 +1,39 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#ifndef MEMORYHANDLER_H
+#define MEMORYHANDLER_H
+#include <Arduino.h>
+
+/**
+ * Describes a Memory Sample (Heap in Bytes, Stack High-Water Marks in Bytes).
+ */
+struct MemorySample
+{
+    uint32_t time;
+    uint32_t free;
+    uint32_t minimum;
+    uint32_t largest;
+    uint16_t loopStack;
+    uint16_t tcpStack;
+    uint16_t sensorStack;
+};
+
+
+class MemoryHandler
+{
+private:
+    static void sample();
+    static void restart(const MemorySample& sample);
+
+public:
+    static void setup();
+    static void loop();
+    static uint8_t getCount();
+    static MemorySample getSample(uint8_t age);
+    static uint8_t getFragmentation();
+};
+
+
+#endif //MEMORYHANDLER_H
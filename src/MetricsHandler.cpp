@@ -0,0 +1,110 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#include "MetricsHandler.h"
+#include <esp_heap_caps.h>
+#include <memory>
+#include "DeviceHandler.h"
+#include "MQTTHandler.h"
+#include "MetricsRenderer.h"
+#include "RelaisHandler.h"
+#include "WiFiHandler.h"
+
+// Define exposed Metrics, every Family reads its Samples via `value`.
+const Metric metrics[] = {
+    {"bytelevel_level_percent", "gauge", "percent", "Tank Level", 1, nullptr,
+        [](uint8_t) -> double { return DeviceHandler::getLevelCached(); }},
+    {"bytelevel_volume_liters", "gauge", "liters", "Tank Volume", 1, nullptr,
+        [](uint8_t) -> double { return DeviceHandler::getVolumeCached(); }},
+    {"bytelevel_voltage_volts", "gauge", "volts", "Sensor Voltage", 1, nullptr,
+        [](uint8_t) -> double { return DeviceHandler::getADCValueCached(); }},
+    {"bytelevel_current_milliamperes", "gauge", "milliamperes", "Sensor Current", 1, nullptr,
+        [](uint8_t) -> double { return DeviceHandler::getCurrentCached(); }},
+    {"bytelevel_cpu_temperature_celsius", "gauge", "celsius", "CPU Temperature", 1, nullptr,
+        [](uint8_t) -> double { return DeviceHandler::getCPUTemperatureCached(); }},
+    {"bytelevel_wifi_rssi_dbm", "gauge", "dbm", "Wi-Fi Signal Strength", 1, nullptr,
+        [](uint8_t) -> double { return WiFiHandler::isConnected() ? WiFiHandler::getRSSI() : 0; }},
+    {"bytelevel_relais_state", "gauge", "", "Relais State (1 = on)", RELAIS_COUNT, "channel",
+        [](uint8_t sample) -> double { return RelaisHandler::getState(sample + 1) ? 1 : 0; }},
+    {"bytelevel_uptime_seconds", "gauge", "seconds", "Time since Boot", 1, nullptr,
+        [](uint8_t) -> double { return millis() / 1000; }},
+    {"bytelevel_heap_free_bytes", "gauge", "bytes", "Free Heap", 1, nullptr,
+        [](uint8_t) -> double { return ESP.getFreeHeap(); }},
+    {"bytelevel_heap_min_free_bytes", "gauge", "bytes", "Lowest Free Heap since Boot", 1, nullptr,
+        [](uint8_t) -> double { return ESP.getMinFreeHeap(); }},
+    {"bytelevel_heap_largest_block_bytes", "gauge", "bytes", "Largest Free Heap Block", 1, nullptr,
+        [](uint8_t) -> double { return heap_caps_get_largest_free_block(MALLOC_CAP_8BIT); }},
+    {"bytelevel_loop_average_microseconds", "gauge", "microseconds", "Average Loop Duration", 1, nullptr,
+        [](uint8_t) -> double { return DeviceHandler::getLoopAverage(); }},
+    {"bytelevel_loop_max_microseconds", "gauge", "microseconds", "Longest Loop Duration since Boot", 1, nullptr,
+        [](uint8_t) -> double { return DeviceHandler::getLoopMax(); }},
+    {"bytelevel_wifi_connects", "counter", "", "Wi-Fi Connects since Boot", 1, nullptr,
+        [](uint8_t) -> double { return WiFiHandler::getConnects(); }},
+    {"bytelevel_wifi_retries", "counter", "", "Wi-Fi Reconnect Attempts since Boot", 1, nullptr,
+        [](uint8_t) -> double { return WiFiHandler::getRetries(); }},
+    {"bytelevel_mqtt_connects", "counter", "", "MQTT Connects since Boot", 1, nullptr,
+        [](uint8_t) -> double { return MQTTHandler::getConnects(); }},
+};
+
+constexpr uint8_t METRIC_COUNT = sizeof(metrics) / sizeof(metrics[0]);
+
+/**
+ * Describes the Stream Position of a running Response.
+ *
+ * A Line is rendered once into `text` and copied over as many Chunks as
+ * needed, so a Value can't change in the middle of a Line.
+ */
+struct MetricsStream
+{
+    uint16_t line;
+    uint8_t offset;
+    uint8_t length;
+    char text[160];
+};
+
+/**
+ * Streams all Metrics as OpenMetrics Text (`GET /metrics`).
+ *
+ * The Response is chunked and rendered Line by Line directly into the
+ * Response Buffer, no String or JsonDocument is built.
+ *
+ * @param request Pointer to the asynchronous web server request.
+ */
+void MetricsHandler::handle(AsyncWebServerRequest* request)
+{
+    std::shared_ptr<MetricsStream> stream = std::make_shared<MetricsStream>();
+
+    AsyncWebServerResponse* response = request->beginChunkedResponse(
+        "application/openmetrics-text; version=1.0.0; charset=utf-8",
+        [stream](uint8_t* buffer, size_t maxLen, size_t index) -> size_t
+        {
+            size_t written = 0;
+
+            while (written < maxLen)
+            {
+                // Render next Line.
+                if (stream->offset >= stream->length)
+                {
+                    stream->length = MetricsRenderer::renderLine(metrics, METRIC_COUNT, stream->line, stream->text,
+                                                                  sizeof(stream->text));
+                    stream->offset = 0;
+
+                    if (stream->length == 0)
+                        break;
+
+                    stream->line++;
+                }
+
+                size_t part = min((size_t)(stream->length - stream->offset), maxLen - written);
+
+                memcpy(buffer + written, stream->text + stream->offset, part);
+                stream->offset += part;
+                written += part;
+            }
+
+            return written;
+        });
+
+    request->send(response);
+}
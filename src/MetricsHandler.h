@@ -0,0 +1,18 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#ifndef METRICSHANDLER_H
+#define METRICSHANDLER_H
+#include <Arduino.h>
+#include "ESPAsyncWebServer.h"
+
+
+class MetricsHandler
+{
+public:
+    static void handle(AsyncWebServerRequest* request);
+};
+
+
+#endif //METRICSHANDLER_H
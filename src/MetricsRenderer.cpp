@@ -0,0 +1,98 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#include "MetricsRenderer.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * Renders a Line of the Exposition.
+ *
+ * Every Family has a TYPE, UNIT (if set) and HELP Line followed by its
+ * Samples, the Exposition ends with `# EOF`.
+ *
+ * @param metrics The Metric Families.
+ * @param count The Number of Families.
+ * @param line The Line Number.
+ * @param buffer The Target Buffer.
+ * @param size The Size of the Buffer.
+ * @return The Length of the Line, or `0` after the last Line.
+ */
+size_t MetricsRenderer::renderLine(const Metric* metrics, uint8_t count, uint16_t line, char* buffer, size_t size)
+{
+    for (uint8_t i = 0; i < count; i++)
+    {
+        const Metric& metric = metrics[i];
+        uint8_t header = metric.unit[0] != '\0' ? 3 : 2;
+
+        if (line >= header + metric.samples)
+        {
+            line -= header + metric.samples;
+            continue;
+        }
+
+        if (line == 0)
+            return snprintf(buffer, size, "# TYPE %s %s\n", metric.name, metric.type);
+
+        if (line == 1 && header == 3)
+            return snprintf(buffer, size, "# UNIT %s %s\n", metric.name, metric.unit);
+
+        if (line == header - 1)
+            return snprintf(buffer, size, "# HELP %s %s\n", metric.name, metric.help);
+
+        return renderSample(metric, line - header, buffer, size);
+    }
+
+    if (line == 0)
+        return snprintf(buffer, size, "# EOF\n");
+
+    return 0;
+}
+
+/**
+ * Renders a Sample Line.
+ *
+ * @param metric The Metric Family.
+ * @param sample The Sample Index.
+ * @param buffer The Target Buffer.
+ * @param size The Size of the Buffer.
+ * @return The Length of the Line.
+ */
+size_t MetricsRenderer::renderSample(const Metric& metric, uint8_t sample, char* buffer, size_t size)
+{
+    const char* suffix = strcmp(metric.type, "counter") == 0 ? "_total" : "";
+    int length;
+
+    if (metric.label != nullptr)
+        length = snprintf(buffer, size, "%s%s{%s=\"%u\"} ", metric.name, suffix, metric.label, sample + 1);
+    else
+        length = snprintf(buffer, size, "%s%s ", metric.name, suffix);
+
+    if (length < 0 || (size_t)length >= size)
+        return 0;
+
+    return length + renderValue(metric.value(sample), buffer + length, size - length);
+}
+
+/**
+ * Renders a Value with its Line Break.
+ *
+ * OpenMetrics spells special Values as `NaN`, `+Inf` and `-Inf`.
+ *
+ * @param value The Value.
+ * @param buffer The Target Buffer.
+ * @param size The Size of the Buffer.
+ * @return The Length of the Value.
+ */
+size_t MetricsRenderer::renderValue(double value, char* buffer, size_t size)
+{
+    if (isnan(value))
+        return snprintf(buffer, size, "NaN\n");
+
+    if (isinf(value))
+        return snprintf(buffer, size, value > 0 ? "+Inf\n" : "-Inf\n");
+
+    return snprintf(buffer, size, "%.10g\n", value);
+}
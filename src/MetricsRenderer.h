@@ -0,0 +1,46 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#ifndef METRICSRENDERER_H
+#define METRICSRENDERER_H
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Describes a Metric Family of the Exposition.
+ *
+ * `samples` is the Number of Samples. With a `label`, every Sample is labeled
+ * with its Number (1-based, e.g. `channel="1"`). Counters get the `_total`
+ * Suffix on their Sample. `value` reads the current Value of a Sample.
+ */
+struct Metric
+{
+    const char* name;
+    const char* type;
+    const char* unit;
+    const char* help;
+    uint8_t samples;
+    const char* label;
+    double (*value)(uint8_t sample);
+};
+
+
+/**
+ * Renders Metric Families as OpenMetrics Text, one Line at a Time.
+ *
+ * Free of Arduino Dependencies, so the Exposition can be checked in the
+ * native Tests.
+ */
+class MetricsRenderer
+{
+private:
+    static size_t renderSample(const Metric& metric, uint8_t sample, char* buffer, size_t size);
+    static size_t renderValue(double value, char* buffer, size_t size);
+
+public:
+    static size_t renderLine(const Metric* metrics, uint8_t count, uint16_t line, char* buffer, size_t size);
+};
+
+
+#endif //METRICSRENDERER_H
@@ -0,0 +1,272 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#include "ModbusHandler.h"
+#include "AutomationHandler.h"
+#include "DeviceHandler.h"
+#include "FileHandler.h"
+#include "InternalConfig.h"
+#include "RelaisHandler.h"
+
+// Store Server (created if enabled).
+AsyncServer* modbusServer = nullptr;
+
+// Store Number of connected Clients.
+volatile uint8_t modbusClients = 0;
+
+// Store Register Image (refreshed by the Loop, served by the TCP Task).
+uint16_t inputImage[MB_INPUT_COUNT];
+uint16_t holdingImage[MB_HOLDING_COUNT];
+portMUX_TYPE modbusMux = portMUX_INITIALIZER_UNLOCKED;
+
+// Store last Refresh Timestamp.
+unsigned long modbusMillis = 0;
+
+/**
+ * Starts the Modbus TCP Server if enabled (`modbus.state`, `modbus.port`).
+ *
+ * Input Registers expose the cached Scan Values, Coils the Relais and Holding
+ * Registers the Automation Mode and Thresholds. Modbus has no Authentication,
+ * so the Server is disabled by Default.
+ */
+void ModbusHandler::setup()
+{
+    JsonDocument config = FileHandler::getConfig();
+
+    if (!config["modbus"]["state"].as<bool>())
+        return;
+
+    refresh();
+
+    modbusServer = new AsyncServer(config["modbus"]["port"] | MODBUS_PORT);
+    modbusServer->onClient(handleClient, nullptr);
+    modbusServer->begin();
+
+#if DEBUG == true
+    Serial.println("Modbus started");
+#endif
+}
+
+/**
+ * Refreshes the Register Image every MODBUS_INTERVAL.
+ */
+void ModbusHandler::loop()
+{
+    if (modbusServer == nullptr || millis() - modbusMillis < MODBUS_INTERVAL)
+        return;
+
+    modbusMillis = millis();
+
+    refresh();
+}
+
+/**
+ * Builds the Register Image from the cached Values.
+ *
+ * Values are scaled to Integers: Level and Thresholds in 0.1 %, Volume in L,
+ * Voltage in mV, Current in 0.01 mA, CPU Temperature in 0.1 °C (signed),
+ * Relais as Bitmask (Bit 0 = Channel 1) and the Uptime in s (high Word first).
+ */
+void ModbusHandler::refresh()
+{
+    uint16_t inputs[MB_INPUT_COUNT];
+    uint16_t holding[MB_HOLDING_COUNT];
+    uint16_t relais = 0;
+    uint32_t uptime = millis() / 1000;
+
+    for (uint8_t i = 1; i <= RelaisHandler::getCount() && i <= 16; i++)
+    {
+        if (RelaisHandler::getState(i))
+            relais |= 1 << (i - 1);
+    }
+
+    inputs[MB_INPUT_LEVEL] = lroundf(DeviceHandler::getLevelCached() * 10.0f);
+    inputs[MB_INPUT_VOLUME] = lroundf(DeviceHandler::getVolumeCached());
+    inputs[MB_INPUT_VOLTAGE] = lroundf(DeviceHandler::getADCValueCached() * 1000.0f);
+    inputs[MB_INPUT_CURRENT] = lroundf(DeviceHandler::getCurrentCached() * 100.0f);
+    inputs[MB_INPUT_FAULTS] = DeviceHandler::getFaults();
+    inputs[MB_INPUT_CPU] = (uint16_t)(int16_t)lroundf(DeviceHandler::getCPUTemperatureCached() * 10.0f);
+    inputs[MB_INPUT_RELAIS] = relais;
+    inputs[MB_INPUT_MODE] = AutomationHandler::getMode();
+    inputs[MB_INPUT_UPTIME] = uptime >> 16;
+    inputs[MB_INPUT_UPTIME + 1] = uptime & 0xFFFF;
+
+    holding[MB_HOLDING_MODE] = AutomationHandler::getMode();
+    holding[MB_HOLDING_MAX] = lroundf(AutomationHandler::getThreshold(AUTO_MAX) * 10.0f);
+    holding[MB_HOLDING_FILL] = lroundf(AutomationHandler::getThreshold(AUTO_FILL) * 10.0f);
+    holding[MB_HOLDING_MIN] = lroundf(AutomationHandler::getThreshold(AUTO_MIN) * 10.0f);
+
+    taskENTER_CRITICAL(&modbusMux);
+    memcpy(inputImage, inputs, sizeof(inputImage));
+    memcpy(holdingImage, holding, sizeof(holdingImage));
+    taskEXIT_CRITICAL(&modbusMux);
+}
+
+/**
+ * Accepts a Client up to MODBUS_CLIENTS, runs in the TCP Task.
+ *
+ * @param arg Unused.
+ * @param client The new Client.
+ */
+void ModbusHandler::handleClient(void* arg, AsyncClient* client)
+{
+    if (modbusClients >= MODBUS_CLIENTS)
+    {
+        client->onDisconnect([](void* arg, AsyncClient* client) { delete client; });
+        client->close(true);
+        return;
+    }
+
+    modbusClients++;
+
+    // Reassembly Buffer lives as long as the Connection.
+    ModbusBuffer* buffer = new ModbusBuffer();
+
+    client->setNoDelay(true);
+    client->setRxTimeout(60);
+    client->onData(handleData, buffer);
+    client->onDisconnect([](void* arg, AsyncClient* client)
+    {
+        modbusClients--;
+        delete (ModbusBuffer*)arg;
+        delete client;
+    }, buffer);
+}
+
+/**
+ * Passes received Data to the Reassembly Buffer of the Client, runs in the
+ * TCP Task. A Client sending an invalid Header is disconnected.
+ *
+ * @param arg The Reassembly Buffer of the Client.
+ * @param client The Client.
+ * @param data The received Data.
+ * @param len The Length of the Data.
+ */
+void ModbusHandler::handleData(void* arg, AsyncClient* client, void* data, size_t len)
+{
+    if (!ModbusProtocol::receive(getDevice(), (ModbusBuffer*)arg, client, (const uint8_t*)data, len))
+        client->close(true);
+}
+
+/**
+ * Retrieves the Device Access of the Protocol.
+ *
+ * @return The Callbacks for Relais and Register Image.
+ */
+ModbusDevice ModbusHandler::getDevice()
+{
+    return {getCoilCount, getCoil, setCoil, readImage, isValidHolding, setHolding, send};
+}
+
+/**
+ * Retrieves the Number of Coils.
+ *
+ * @return The Number of Relais Channels.
+ */
+uint16_t ModbusHandler::getCoilCount()
+{
+    return RelaisHandler::getCount();
+}
+
+/**
+ * Reads a Coil.
+ *
+ * @param address The Coil Address, Coil 0 = Relais Channel 1.
+ * @return True if the Relais is on.
+ */
+bool ModbusHandler::getCoil(uint16_t address)
+{
+    return RelaisHandler::getState(address + 1);
+}
+
+/**
+ * Switches a Coil with RELAIS_MANUAL Arbitration, so Interlocks and
+ * Automation Priorities apply like for the API.
+ *
+ * @param address The Coil Address, Coil 0 = Relais Channel 1.
+ * @param state The new State.
+ * @return False if the Start has been rejected.
+ */
+bool ModbusHandler::setCoil(uint16_t address, bool state)
+{
+    return RelaisHandler::set(address + 1, state, RELAIS_MANUAL);
+}
+
+/**
+ * Copies the Register Image.
+ *
+ * @param holding True for the Holding, false for the Input Registers.
+ * @param image Receives the Registers.
+ */
+void ModbusHandler::readImage(bool holding, uint16_t* image)
+{
+    taskENTER_CRITICAL(&modbusMux);
+
+    if (holding)
+        memcpy(image, holdingImage, sizeof(holdingImage));
+    else
+        memcpy(image, inputImage, sizeof(inputImage));
+
+    taskEXIT_CRITICAL(&modbusMux);
+}
+
+/**
+ * Sends a Response to the Client.
+ *
+ * @param client The Client.
+ * @param data The Response Frame.
+ * @param length The Length of the Frame.
+ */
+void ModbusHandler::send(void* client, const uint8_t* data, size_t length)
+{
+    ((AsyncClient*)client)->write((const char*)data, length);
+}
+
+/**
+ * Checks a Holding Register Value.
+ *
+ * @param address The Register Address.
+ * @param value The Value.
+ * @return True if the Mode is 0 - 2 or the Threshold 0 - 1000 (0.1 %).
+ */
+bool ModbusHandler::isValidHolding(uint16_t address, uint16_t value)
+{
+    if (address == MB_HOLDING_MODE)
+        return value <= 2;
+
+    return value <= 1000;
+}
+
+/**
+ * Applies a Holding Register and updates the Image.
+ *
+ * Changes are applied at Runtime and are not persisted.
+ *
+ * @param address The Register Address.
+ * @param value The validated Value.
+ */
+void ModbusHandler::setHolding(uint16_t address, uint16_t value)
+{
+    switch (address)
+    {
+    case MB_HOLDING_MODE:
+        AutomationHandler::setMode(value);
+        break;
+    case MB_HOLDING_MAX:
+        AutomationHandler::setThreshold(AUTO_MAX, value / 10.0f);
+        break;
+    case MB_HOLDING_FILL:
+        AutomationHandler::setThreshold(AUTO_FILL, value / 10.0f);
+        break;
+    case MB_HOLDING_MIN:
+        AutomationHandler::setThreshold(AUTO_MIN, value / 10.0f);
+        break;
+    default:
+        return;
+    }
+
+    taskENTER_CRITICAL(&modbusMux);
+    holdingImage[address] = value;
+    taskEXIT_CRITICAL(&modbusMux);
+}
@@ -0,0 +1,34 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#ifndef MODBUSHANDLER_H
+#define MODBUSHANDLER_H
+#include <Arduino.h>
+#include <AsyncTCP.h>
+
+#include "ModbusProtocol.h"
+
+
+class ModbusHandler
+{
+private:
+    static void handleClient(void* arg, AsyncClient* client);
+    static void handleData(void* arg, AsyncClient* client, void* data, size_t len);
+    static ModbusDevice getDevice();
+    static uint16_t getCoilCount();
+    static bool getCoil(uint16_t address);
+    static bool setCoil(uint16_t address, bool state);
+    static void readImage(bool holding, uint16_t* image);
+    static bool isValidHolding(uint16_t address, uint16_t value);
+    static void setHolding(uint16_t address, uint16_t value);
+    static void send(void* client, const uint8_t* data, size_t length);
+    static void refresh();
+
+public:
+    static void setup();
+    static void loop();
+};
+
+
+#endif //MODBUSHANDLER_H
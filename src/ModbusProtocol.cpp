@@ -0,0 +1,319 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#include "ModbusProtocol.h"
+#include <string.h>
+
+/**
+ * Define Modbus Function and Exception Codes.
+ */
+#define MB_READ_COILS 0x01
+#define MB_READ_HOLDING 0x03
+#define MB_READ_INPUT 0x04
+#define MB_WRITE_COIL 0x05
+#define MB_WRITE_REGISTER 0x06
+#define MB_WRITE_COILS 0x0F
+#define MB_WRITE_REGISTERS 0x10
+
+#define MB_ILLEGAL_FUNCTION 0x01
+#define MB_ILLEGAL_ADDRESS 0x02
+#define MB_ILLEGAL_VALUE 0x03
+#define MB_DEVICE_FAILURE 0x04
+
+/**
+ * Collects received Bytes and answers every complete Frame (MBAP Header + PDU).
+ *
+ * Frames split across TCP Segments are reassembled in the Buffer of the
+ * Client, several Frames in one Segment are answered in Order. The Response
+ * is built on the Stack, nothing is allocated per Request.
+ *
+ * @param device The Device Access.
+ * @param buffer The Reassembly Buffer of the Client.
+ * @param client The Client, passed to `device.send()`.
+ * @param data The received Data.
+ * @param length The Length of the Data.
+ * @return False if the Header is invalid and the Connection has to be closed.
+ */
+bool ModbusProtocol::receive(const ModbusDevice& device, ModbusBuffer* buffer, void* client, const uint8_t* data,
+                             size_t length)
+{
+    uint8_t* frame = buffer->frame;
+    uint8_t response[MB_FRAME_SIZE];
+
+    while (length > 0)
+    {
+        // Header first, then Unit ID and PDU as announced by the Header.
+        size_t needed = buffer->length < 6 ? 6 : 6u + ((frame[4] << 8) | frame[5]);
+        size_t chunk = needed - buffer->length;
+
+        if (chunk > length)
+            chunk = length;
+
+        memcpy(frame + buffer->length, data, chunk);
+        buffer->length += chunk;
+        data += chunk;
+        length -= chunk;
+
+        if (buffer->length == 6)
+        {
+            uint16_t size = (frame[4] << 8) | frame[5];
+
+            // Protocol ID must be 0, Length covers Unit ID and PDU.
+            if (frame[2] != 0 || frame[3] != 0 || size < 2 || size > MB_FRAME_SIZE - 6)
+            {
+                buffer->length = 0;
+                return false;
+            }
+
+            continue;
+        }
+
+        if (buffer->length < needed)
+            continue;
+
+        // Echo Transaction, Protocol and Unit ID.
+        memcpy(response, frame, 4);
+        response[6] = frame[6];
+
+        size_t size = handleFrame(device, frame + 7, buffer->length - 7, response + 7);
+
+        response[4] = (size + 1) >> 8;
+        response[5] = (size + 1) & 0xFF;
+
+        buffer->length = 0;
+
+        device.send(client, response, size + 7);
+    }
+
+    return true;
+}
+
+/**
+ * Dispatches a Request PDU.
+ *
+ * @param device The Device Access.
+ * @param pdu The Request PDU (Function Code first).
+ * @param length The Length of the PDU (at least 1).
+ * @param response The Response PDU.
+ * @return The Length of the Response PDU.
+ */
+size_t ModbusProtocol::handleFrame(const ModbusDevice& device, const uint8_t* pdu, size_t length, uint8_t* response)
+{
+    uint8_t function = pdu[0];
+
+    bool fixed = function == MB_READ_COILS || function == MB_READ_HOLDING || function == MB_READ_INPUT ||
+        function == MB_WRITE_COIL || function == MB_WRITE_REGISTER;
+
+    // Read and single Write Requests have a fixed Length.
+    if (fixed && length != 5)
+        return exception(response, function, MB_ILLEGAL_VALUE);
+
+    // Multiple Writes need at least Address, Quantity and Byte Count.
+    if ((function == MB_WRITE_COILS || function == MB_WRITE_REGISTERS) && length < 6)
+        return exception(response, function, MB_ILLEGAL_VALUE);
+
+    switch (function)
+    {
+    case MB_READ_COILS:
+        return readCoils(device, pdu, response);
+    case MB_READ_HOLDING:
+    case MB_READ_INPUT:
+        return readRegisters(device, pdu, response);
+    case MB_WRITE_COIL:
+    case MB_WRITE_COILS:
+        return writeCoils(device, pdu, length, response);
+    case MB_WRITE_REGISTER:
+    case MB_WRITE_REGISTERS:
+        return writeRegisters(device, pdu, length, response);
+    default:
+        return exception(response, function, MB_ILLEGAL_FUNCTION);
+    }
+}
+
+/**
+ * Reads Coils (Function 01), Coil 0 = Relais Channel 1.
+ *
+ * @param device The Device Access.
+ * @param pdu The Request PDU.
+ * @param response The Response PDU.
+ * @return The Length of the Response PDU.
+ */
+size_t ModbusProtocol::readCoils(const ModbusDevice& device, const uint8_t* pdu, uint8_t* response)
+{
+    uint16_t start = (pdu[1] << 8) | pdu[2];
+    uint16_t quantity = (pdu[3] << 8) | pdu[4];
+
+    if (quantity < 1 || quantity > 2000)
+        return exception(response, pdu[0], MB_ILLEGAL_VALUE);
+
+    if (start + quantity > device.getCoilCount())
+        return exception(response, pdu[0], MB_ILLEGAL_ADDRESS);
+
+    uint8_t bytes = (quantity + 7) / 8;
+
+    response[0] = pdu[0];
+    response[1] = bytes;
+    memset(response + 2, 0, bytes);
+
+    for (uint16_t i = 0; i < quantity; i++)
+    {
+        if (device.getCoil(start + i))
+            response[2 + i / 8] |= 1 << (i % 8);
+    }
+
+    return 2 + bytes;
+}
+
+/**
+ * Reads Holding (Function 03) or Input Registers (Function 04) from a
+ * consistent Copy of the Image.
+ *
+ * @param device The Device Access.
+ * @param pdu The Request PDU.
+ * @param response The Response PDU.
+ * @return The Length of the Response PDU.
+ */
+size_t ModbusProtocol::readRegisters(const ModbusDevice& device, const uint8_t* pdu, uint8_t* response)
+{
+    uint16_t start = (pdu[1] << 8) | pdu[2];
+    uint16_t quantity = (pdu[3] << 8) | pdu[4];
+    bool holding = pdu[0] == MB_READ_HOLDING;
+    uint16_t count = holding ? MB_HOLDING_COUNT : MB_INPUT_COUNT;
+    uint16_t image[MB_INPUT_COUNT > MB_HOLDING_COUNT ? MB_INPUT_COUNT : MB_HOLDING_COUNT];
+
+    if (quantity < 1 || quantity > 125)
+        return exception(response, pdu[0], MB_ILLEGAL_VALUE);
+
+    if (start + quantity > count)
+        return exception(response, pdu[0], MB_ILLEGAL_ADDRESS);
+
+    device.readImage(holding, image);
+
+    response[0] = pdu[0];
+    response[1] = quantity * 2;
+
+    for (uint16_t i = 0; i < quantity; i++)
+    {
+        response[2 + i * 2] = image[start + i] >> 8;
+        response[3 + i * 2] = image[start + i] & 0xFF;
+    }
+
+    return 2 + quantity * 2;
+}
+
+/**
+ * Writes a single (Function 05) or multiple Coils (Function 15).
+ *
+ * A rejected Start answers with Exception 04.
+ *
+ * @param device The Device Access.
+ * @param pdu The Request PDU.
+ * @param length The Length of the PDU.
+ * @param response The Response PDU.
+ * @return The Length of the Response PDU.
+ */
+size_t ModbusProtocol::writeCoils(const ModbusDevice& device, const uint8_t* pdu, size_t length, uint8_t* response)
+{
+    uint16_t start = (pdu[1] << 8) | pdu[2];
+    uint16_t quantity = 1;
+    bool accepted = true;
+
+    if (pdu[0] == MB_WRITE_COIL)
+    {
+        uint16_t value = (pdu[3] << 8) | pdu[4];
+
+        if (value != 0xFF00 && value != 0x0000)
+            return exception(response, pdu[0], MB_ILLEGAL_VALUE);
+
+        if (start >= device.getCoilCount())
+            return exception(response, pdu[0], MB_ILLEGAL_ADDRESS);
+
+        accepted = device.setCoil(start, value == 0xFF00);
+    }
+    else
+    {
+        quantity = (pdu[3] << 8) | pdu[4];
+
+        if (quantity < 1 || quantity > 1968 || pdu[5] != (quantity + 7) / 8 || length != 6u + pdu[5])
+            return exception(response, pdu[0], MB_ILLEGAL_VALUE);
+
+        if (start + quantity > device.getCoilCount())
+            return exception(response, pdu[0], MB_ILLEGAL_ADDRESS);
+
+        for (uint16_t i = 0; i < quantity; i++)
+        {
+            if (!device.setCoil(start + i, pdu[6 + i / 8] & (1 << (i % 8))))
+                accepted = false;
+        }
+    }
+
+    if (!accepted)
+        return exception(response, pdu[0], MB_DEVICE_FAILURE);
+
+    // Echo Address and Value/Quantity.
+    memcpy(response, pdu, 5);
+
+    return 5;
+}
+
+/**
+ * Writes a single (Function 06) or multiple Holding Registers (Function 16).
+ *
+ * All Values are validated before any is applied.
+ *
+ * @param device The Device Access.
+ * @param pdu The Request PDU.
+ * @param length The Length of the PDU.
+ * @param response The Response PDU.
+ * @return The Length of the Response PDU.
+ */
+size_t ModbusProtocol::writeRegisters(const ModbusDevice& device, const uint8_t* pdu, size_t length,
+                                      uint8_t* response)
+{
+    uint16_t start = (pdu[1] << 8) | pdu[2];
+    uint16_t quantity = 1;
+    const uint8_t* values = pdu + 3;
+
+    if (pdu[0] == MB_WRITE_REGISTERS)
+    {
+        quantity = (pdu[3] << 8) | pdu[4];
+        values = pdu + 6;
+
+        if (quantity < 1 || quantity > 123 || pdu[5] != quantity * 2 || length != 6u + pdu[5])
+            return exception(response, pdu[0], MB_ILLEGAL_VALUE);
+    }
+
+    if (start + quantity > MB_HOLDING_COUNT)
+        return exception(response, pdu[0], MB_ILLEGAL_ADDRESS);
+
+    for (uint16_t i = 0; i < quantity; i++)
+    {
+        if (!device.isValidHolding(start + i, (values[i * 2] << 8) | values[i * 2 + 1]))
+            return exception(response, pdu[0], MB_ILLEGAL_VALUE);
+    }
+
+    for (uint16_t i = 0; i < quantity; i++)
+        device.setHolding(start + i, (values[i * 2] << 8) | values[i * 2 + 1]);
+
+    // Echo Address and Value/Quantity.
+    memcpy(response, pdu, 5);
+
+    return 5;
+}
+
+/**
+ * Builds an Exception Response.
+ *
+ * @param response The Response PDU.
+ * @param function The Function Code of the Request.
+ * @param code The Exception Code.
+ * @return The Length of the Response PDU.
+ */
+size_t ModbusProtocol::exception(uint8_t* response, uint8_t function, uint8_t code)
+{
+    response[0] = function | 0x80;
+    response[1] = code;
+
+    return 2;
+}
@@ -0,0 +1,85 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#ifndef MODBUSPROTOCOL_H
+#define MODBUSPROTOCOL_H
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Define Input Registers (Function 04, read only).
+ */
+#define MB_INPUT_LEVEL 0
+#define MB_INPUT_VOLUME 1
+#define MB_INPUT_VOLTAGE 2
+#define MB_INPUT_CURRENT 3
+#define MB_INPUT_FAULTS 4
+#define MB_INPUT_CPU 5
+#define MB_INPUT_RELAIS 6
+#define MB_INPUT_MODE 7
+#define MB_INPUT_UPTIME 8
+#define MB_INPUT_COUNT 10
+
+/**
+ * Define Holding Registers (Function 03, 06, 16).
+ */
+#define MB_HOLDING_MODE 0
+#define MB_HOLDING_MAX 1
+#define MB_HOLDING_FILL 2
+#define MB_HOLDING_MIN 3
+#define MB_HOLDING_COUNT 4
+
+/**
+ * Define maximum Size of a Modbus TCP Frame (MBAP Header + Unit ID + PDU).
+ */
+#define MB_FRAME_SIZE 260
+
+/**
+ * Define Device Access used by the Protocol (Relais and Register Image on the
+ * Device, RAM in the native Tests).
+ */
+struct ModbusDevice
+{
+    uint16_t (*getCoilCount)();
+    bool (*getCoil)(uint16_t address);
+    bool (*setCoil)(uint16_t address, bool state);
+    void (*readImage)(bool holding, uint16_t* image);
+    bool (*isValidHolding)(uint16_t address, uint16_t value);
+    void (*setHolding)(uint16_t address, uint16_t value);
+    void (*send)(void* client, const uint8_t* data, size_t length);
+};
+
+/**
+ * Reassembly Buffer of a Client, Frames may be split across TCP Segments.
+ */
+struct ModbusBuffer
+{
+    uint8_t frame[MB_FRAME_SIZE];
+    uint16_t length;
+};
+
+
+/**
+ * Parses Modbus TCP Frames and answers them.
+ *
+ * Free of Arduino Dependencies, the Device is accessed via Callbacks so the
+ * ModbusHandler serves the Relais and the native Tests a fake Device.
+ */
+class ModbusProtocol
+{
+private:
+    static size_t handleFrame(const ModbusDevice& device, const uint8_t* pdu, size_t length, uint8_t* response);
+    static size_t readCoils(const ModbusDevice& device, const uint8_t* pdu, uint8_t* response);
+    static size_t readRegisters(const ModbusDevice& device, const uint8_t* pdu, uint8_t* response);
+    static size_t writeCoils(const ModbusDevice& device, const uint8_t* pdu, size_t length, uint8_t* response);
+    static size_t writeRegisters(const ModbusDevice& device, const uint8_t* pdu, size_t length, uint8_t* response);
+    static size_t exception(uint8_t* response, uint8_t function, uint8_t code);
+
+public:
+    static bool receive(const ModbusDevice& device, ModbusBuffer* buffer, void* client, const uint8_t* data,
+                        size_t length);
+};
+
+
+#endif //MODBUSPROTOCOL_H
@@ -4,10 +4,16 @@
 
 #include "OTAHandler.h"
 #include <ArduinoOTA.h>
+#include <HTTPClient.h>
+#include <WiFiClientSecure.h>
 
 #include "esp32FOTA.hpp"
+#include "CrashHandler.h"
 #include "FileHandler.h"
 #include "InternalConfig.h"
+#include "PatchHandler.h"
+#include "StatsHandler.h"
+#include "UpdateSchedule.h"
 
 // Store OTA Server State.
 bool otaEnabled = false;
@@ -15,6 +21,36 @@ bool otaEnabled = false;
 // Store Pull Instance.
 esp32FOTA pull("stable", VERSION, false, true);
 
+// Store Update Task Handle.
+TaskHandle_t otaTask = NULL;
+
+// Define Update States (Index of otaStates).
+#define OTA_IDLE 0
+#define OTA_CHECKING 1
+#define OTA_AVAILABLE 2
+#define OTA_UPDATING 3
+#define OTA_FAILED 4
+
+const char* otaStates[] = {"idle", "checking", "available", "updating", "failed"};
+
+// Store Update State (written by Update Task, read by Web/Loop).
+volatile uint8_t otaState = OTA_IDLE;
+volatile uint8_t otaProgress = 0;
+
+// Store cached Manifest Result.
+volatile bool updateAvailable = false;
+char latestVersion[16] = "";
+String firmwareURL;
+String firmwareHash;
+bool firmwareGzip = false;
+
+// Store Delta Patch against running Version (if offered by Manifest).
+String deltaURL;
+bool deltaGzip = false;
+
+// Store pending Request for the Update Task.
+volatile bool updateRequested = false;
+
 /**
  * @brief Sets up the OTA (Over-The-Air) update functionality if enabled in
  *        the configuration.
@@ -41,8 +77,8 @@ void OTAHandler::setup()
         // Set OTA Hostname.
         ArduinoOTA.setHostname(FileHandler::getConfig()["wifi"]["ap"]["ssid"].as<String>().c_str());
 
-        // Enable MDNS.
-        ArduinoOTA.setMdnsEnabled(true);
+        // mDNS is handled by the MDNSHandler.
+        ArduinoOTA.setMdnsEnabled(false);
 
         // Reboot on Success.
         ArduinoOTA.setRebootOnSuccess(true);
@@ -75,6 +111,310 @@ void OTAHandler::setup()
     // Remote OTA Server.
     // Set Manifest URL.
     pull.setManifestURL(UPDATE_SERVER);
+
+    // Set Check Interval (s), fall back to Default.
+    unsigned long interval = FileHandler::getConfig()["update"]["interval"].as<unsigned long>();
+
+    UpdateSchedule::reset(interval > 0 ? interval * 1000UL : UPDATE_TTL);
+
+    // Report Download Progress in %.
+    pull.setProgressCb([](size_t progress, size_t size)
+    {
+        otaProgress = (size > 0 ? (progress * 100) / size : 0);
+    });
+
+    // Mark the Restart only once the Image is written, esp32FOTA restarts right after.
+    pull.setUpdateFinishedCb([](int partition, bool restart)
+    {
+        if (!restart)
+            return;
+
+        StatsHandler::flush();
+        CrashHandler::markRestart(RESTART_UPDATE);
+    });
+
+    // Run Manifest Check and Download in Background.
+    xTaskCreate(
+        runTask,
+        "OTA Task",
+        UPDATE_STACK,
+        NULL,
+        1,
+        &otaTask
+    );
+}
+
+/**
+ * @brief Background Task which owns every blocking Update Operation.
+ *
+ * The Task sleeps until it gets notified (by `refresh()` or `update()`) or the next Tick
+ * elapses. It refreshes the cached Manifest Result once the configured Check
+ * Interval has expired and runs requested Firmware Downloads, so neither the
+ * AsyncTCP Callbacks nor the main Loop ever wait for the Update Server.
+ *
+ * Automatic Updates of a Version which failed before are retried with
+ * exponential Backoff (see UpdateSchedule), not on every Tick.
+ *
+ * @param parameter Unused Task Parameter.
+ */
+void OTAHandler::runTask(void* parameter)
+{
+    for (;;)
+    {
+        // Wait for a Request or the next Tick.
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(1000));
+
+        if (!checkWAN())
+            continue;
+
+        // Download requested Firmware.
+        if (updateRequested)
+        {
+            updateRequested = false;
+            runUpdate();
+            continue;
+        }
+
+        // Refresh cached Manifest Result.
+        if (UpdateSchedule::isCheckDue(millis()))
+        {
+            runCheck();
+        }
+
+#if UPDATE_AUTO == true
+        // Install new Version, retry failed Version after Backoff.
+        if (UpdateSchedule::isInstallDue(getLatestVersion(), millis()))
+        {
+            runUpdate();
+        }
+#endif
+    }
+}
+
+/**
+ * @brief Fetches the Manifest from the Update Server and caches the Result.
+ *
+ * The Request carries the `ETag` and `Last-Modified` Validators of the last
+ * Response as `If-None-Match` / `If-Modified-Since`, so an unchanged Manifest
+ * is answered with an empty 304 and the cached Result is kept.
+ *
+ * A failed Update stays reported as "failed" until it is requested again or
+ * the Manifest offers another Version.
+ *
+ * Must only be called from the Update Task, as the Request blocks until the
+ * Server has answered.
+ */
+void OTAHandler::runCheck()
+{
+    if (otaState != OTA_FAILED)
+        otaState = OTA_CHECKING;
+
+    fetchManifest();
+
+    UpdateSchedule::checked(millis());
+
+    if (!updateAvailable)
+        otaState = OTA_IDLE;
+    else if (UpdateSchedule::hasFailed(latestVersion))
+        otaState = OTA_FAILED;
+    else
+        otaState = OTA_AVAILABLE;
+
+#if DEBUG == true
+    Serial.printf("OTA check: %s\n", (updateAvailable ? latestVersion : "latest"));
+#endif
+}
+
+/**
+ * @brief Requests the Manifest and parses it into the cached Result.
+ *
+ * Supports the esp32FOTA Manifest Format (single Object or Array of Objects
+ * with `type`, `version` and either `url` or `host`/`port`/`bin`). Only
+ * Entries matching the "stable" Firmware Type are considered. Entries may
+ * additionally carry `sha256`, `gzip` and a `delta` Object (`from`, `url`,
+ * `gzip`) which are used by the PatchHandler.
+ *
+ * @return True if the Server answered with 200 or 304; otherwise, false.
+ */
+bool OTAHandler::fetchManifest()
+{
+    const char* headers[] = {"ETag", "Last-Modified"};
+
+    HTTPClient http;
+    WiFiClient plain;
+    WiFiClientSecure secure;
+
+    // Same Behaviour as esp32FOTA (allow insecure HTTPS).
+    secure.setInsecure();
+
+    if (strncmp(UPDATE_SERVER, "https", 5) == 0)
+        http.begin(secure, UPDATE_SERVER);
+    else
+        http.begin(plain, UPDATE_SERVER);
+
+    http.collectHeaders(headers, 2);
+
+    // Add Validators of the last Response.
+    if (UpdateSchedule::getETag()[0] != '\0')
+        http.addHeader("If-None-Match", UpdateSchedule::getETag());
+
+    if (UpdateSchedule::getModified()[0] != '\0')
+        http.addHeader("If-Modified-Since", UpdateSchedule::getModified());
+
+    int code = http.GET();
+
+    // Manifest unchanged, keep cached Result.
+    if (code == HTTP_CODE_NOT_MODIFIED)
+    {
+        http.end();
+        return true;
+    }
+
+    if (code != HTTP_CODE_OK)
+    {
+#if DEBUG == true
+        Serial.printf("OTA manifest %d\n", code);
+#endif
+        http.end();
+        return false;
+    }
+
+    JsonDocument doc;
+    DeserializationError error = deserializeJson(doc, http.getStream());
+
+    // Store Validators for the next Request.
+    if (error)
+        UpdateSchedule::storeValidators("", "");
+    else
+        UpdateSchedule::storeValidators(http.header("ETag").c_str(), http.header("Last-Modified").c_str());
+
+    http.end();
+
+    if (error)
+        return false;
+
+    // Pick newest Entry of the Manifest.
+    updateAvailable = false;
+
+    if (doc.is<JsonArray>())
+    {
+        for (JsonVariant entry : doc.as<JsonArray>())
+        {
+            readManifestEntry(entry);
+        }
+    }
+    else
+    {
+        readManifestEntry(doc.as<JsonVariant>());
+    }
+
+    return true;
+}
+
+/**
+ * @brief Caches a single Manifest Entry if it is newer than the running
+ *        Firmware and every Entry seen before.
+ *
+ * @param entry The Manifest Entry to check.
+ */
+void OTAHandler::readManifestEntry(JsonVariant entry)
+{
+    // Skip other Firmware Types.
+    if (entry["type"].is<const char*>() && strcmp(entry["type"].as<const char*>(), "stable") != 0)
+        return;
+
+    const char* version = entry["version"] | "";
+
+    if (!UpdateSchedule::isNewer(version, (updateAvailable ? latestVersion : VERSION)))
+        return;
+
+    // Build Firmware URL.
+    if (entry["url"].is<const char*>())
+    {
+        firmwareURL = entry["url"].as<String>();
+    }
+    else if (entry["host"].is<const char*>() && entry["bin"].is<const char*>())
+    {
+        int port = entry["port"] | 80;
+
+        firmwareURL = String(port == 443 ? "https://" : "http://") + entry["host"].as<String>() + ":" + port +
+            entry["bin"].as<String>();
+    }
+    else
+        return;
+
+    // Store optional Compression and Hash of the full Image.
+    firmwareGzip = entry["gzip"] | false;
+    firmwareHash = entry["sha256"] | "";
+
+    // Store Delta Patch if it applies to the running Version, a Delta is only
+    // used with a Hash of the resulting Image.
+    deltaURL = "";
+    deltaGzip = false;
+
+    if (firmwareHash.length() > 0 && strcmp(entry["delta"]["from"] | "", VERSION) == 0 &&
+        entry["delta"]["url"].is<const char*>())
+    {
+        deltaURL = entry["delta"]["url"].as<String>();
+        deltaGzip = entry["delta"]["gzip"] | false;
+    }
+
+    strlcpy(latestVersion, version, sizeof(latestVersion));
+    updateAvailable = true;
+}
+
+/**
+ * @brief Downloads and flashes the latest Firmware.
+ *
+ * Delta Patches and compressed or hashed Images are streamed by the
+ * PatchHandler, plain Images are flashed by esp32FOTA.
+ *
+ * Must only be called from the Update Task. On Success the Device reboots,
+ * so returning from this Function means the Update has failed.
+ */
+void OTAHandler::runUpdate()
+{
+    otaState = OTA_UPDATING;
+    otaProgress = 0;
+
+    // Progress Callback for the Patch Decoder.
+    auto progress = [](size_t done, size_t size)
+    {
+        otaProgress = (size > 0 ? (done * 100) / size : 0);
+    };
+
+    // Prefer verified Delta Patch, fall back to full Image on Failure.
+    if (deltaURL.length() > 0 && firmwareHash.length() > 0 && PatchHandler::update(deltaURL.c_str(), deltaGzip, true, firmwareHash.c_str(), progress))
+    {
+        StatsHandler::flush();
+        CrashHandler::markRestart(RESTART_UPDATE);
+        ESP.restart();
+    }
+
+    if (firmwareGzip || firmwareHash.length() > 0)
+    {
+        // Stream compressed / verified Image.
+        if (PatchHandler::update(firmwareURL.c_str(), firmwareGzip, false, firmwareHash.c_str(), progress))
+        {
+            StatsHandler::flush();
+            CrashHandler::markRestart(RESTART_UPDATE);
+            ESP.restart();
+        }
+    }
+    else
+    {
+        // Flash cached Firmware URL, the Manifest was already checked (restarts on Success).
+        pull.forceUpdate(firmwareURL.c_str(), false);
+    }
+
+    otaState = OTA_FAILED;
+
+    // Back off before the automatic Retry of this Version.
+    UpdateSchedule::failed(latestVersion, millis());
+
+#if DEBUG == true
+    Serial.println("OTA failed");
+#endif
 }
 
 /**
@@ -96,13 +436,6 @@ void OTAHandler::loop()
         // Handle incoming OTA.
         ArduinoOTA.handle();
     }
-
-
-    if (checkWAN())
-    {
-        // Handle Pull.
-        pull.handle();
-    }
 }
 
 /**
@@ -125,47 +458,76 @@ bool OTAHandler::checkWAN()
 /**
  * @brief Checks if a new firmware update is available on the update server.
  *
- * This function communicates with the update server to determine if a newer
- * version of the firmware is available. It compares the current firmware
- * version with the available version on the server without initiating
- * the update process.
- *
- * The function uses the `ESP32OTAPull` class to check for updates by querying
- * the server defined by `UPDATE_SERVER` and comparing it to the software
- * version defined by `VERSION`. The check only determines the availability
- * of an update without performing the update itself.
+ * This function only reads the cached Manifest Result and never touches the
+ * Network, so it is safe to call from AsyncTCP Callbacks. The Result is
+ * refreshed by the Update Task on the configured Check Interval.
  *
- * @return True if an update is available; otherwise, false.
+ * @return True if the last Manifest Check reported a newer Version; otherwise, false.
  */
 bool OTAHandler::hasUpdate()
 {
-    if (checkWAN())
-    {
-        return pull.execHTTPcheck();
-    }
+    return updateAvailable;
+}
+
+/**
+ * @brief Requests the Update Task to check the Manifest ahead of the Interval.
+ *
+ * Returns immediately, the cached Result is updated in the Background.
+ */
+void OTAHandler::refresh()
+{
+    if (otaTask == NULL)
+        return;
 
-    return false;
+    UpdateSchedule::requestCheck();
+    xTaskNotifyGive(otaTask);
 }
 
 /**
- * @brief Initiates the OTA update process by checking for available updates.
+ * @brief Requests the Update Task to download and boot the latest Firmware.
+ *
+ * The Download runs in the Update Task, the Progress can be polled via
+ * `getState()` and `getProgress()`.
  *
- * This function uses the `ESP32OTAPull` library to check for firmware updates
- * from a specified update server. It compares the current firmware version
- * against the versions available on the server and decides whether to update
- * and boot the device into the new firmware.
+ * @return True if an Update is available and has been scheduled; otherwise, false.
+ */
+bool OTAHandler::update()
+{
+    if (otaTask == NULL || !updateAvailable || otaState == OTA_UPDATING)
+        return false;
+
+    updateRequested = true;
+    xTaskNotifyGive(otaTask);
+
+    return true;
+}
+
+/**
+ * @brief Returns the current State of the Update Task.
  *
- * The update server and current version are defined in the configuration
- * headers as `UPDATE_SERVER` and `VERSION`, respectively. The update action
- * performed is specified as `ESP32OTAPull::UPDATE_AND_BOOT`, which updates
- * the firmware and reboots the device to apply the update.
+ * @return One of "idle", "checking", "available", "updating" or "failed".
+ */
+const char* OTAHandler::getState()
+{
+    return otaStates[otaState];
+}
+
+/**
+ * @brief Returns the newest Version reported by the Update Server.
  *
- * @note Ensure a stable network connection is available for contacting the
- *       update server and downloading the firmware.
+ * @return The cached Version or an empty String if no Update is available.
+ */
+const char* OTAHandler::getLatestVersion()
+{
+    return (updateAvailable ? latestVersion : "");
+}
+
+/**
+ * @brief Returns the Download Progress of a running Update.
  *
- * @see ESP32OTAPull::CheckForOTAUpdate
-     */
-void OTAHandler::update()
+ * @return The Progress in % (0-100).
+ */
+uint8_t OTAHandler::getProgress()
 {
-    pull.execOTA();
+    return otaProgress;
 }
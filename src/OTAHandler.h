@@ -4,16 +4,29 @@
 
 #ifndef OTAHANDLER_H
 #define OTAHANDLER_H
+#include <Arduino.h>
+#include <ArduinoJson.h>
 
 
 class OTAHandler
 {
+private:
+    static void runTask(void* parameter);
+    static void runCheck();
+    static void runUpdate();
+    static bool fetchManifest();
+    static void readManifestEntry(JsonVariant entry);
+
 public:
     static void setup();
     static void loop();
     static bool checkWAN();
     static bool hasUpdate();
-    static void update();
+    static void refresh();
+    static bool update();
+    static const char* getState();
+    static const char* getLatestVersion();
+    static uint8_t getProgress();
 };
 
 
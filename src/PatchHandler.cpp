@@ -0,0 +1,472 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#include "PatchHandler.h"
+#include <HTTPClient.h>
+#include <WiFiClientSecure.h>
+#include <esp_ota_ops.h>
+#include <esp_partition.h>
+#include <mbedtls/sha256.h>
+#include "rom/miniz.h"
+
+#include "InternalConfig.h"
+#include "PatchParser.h"
+
+// Define Gzip Parser States.
+#define GZIP_HEADER 0
+#define GZIP_EXTRA_LENGTH 1
+#define GZIP_EXTRA 2
+#define GZIP_NAME 3
+#define GZIP_COMMENT 4
+#define GZIP_CRC 5
+#define GZIP_BODY 6
+#define GZIP_DONE 7
+
+// Define Gzip Header Flags.
+#define GZIP_FHCRC 0x02
+#define GZIP_FEXTRA 0x04
+#define GZIP_FNAME 0x08
+#define GZIP_FCOMMENT 0x10
+
+// Define Buffer Sizes.
+#define PATCH_CHUNK 1024
+#define PATCH_OUTPUT 4096
+#define PATCH_TIMEOUT 10000
+
+// Store Partitions and OTA Handle.
+const esp_partition_t* sourcePartition = NULL;
+const esp_partition_t* targetPartition = NULL;
+esp_ota_handle_t otaHandle = 0;
+
+// Store Hash of the written Image.
+mbedtls_sha256_context shaContext;
+
+// Store buffered Output (flash is written in PATCH_OUTPUT Blocks), followed
+// by PATCH_CHUNK Bytes for the Download.
+uint8_t* outputBuffer = NULL;
+size_t outputLength = 0;
+size_t outputWritten = 0;
+
+// Store Decoder Modes.
+bool patchDelta = false;
+bool patchGzip = false;
+
+// Store Gzip Parser State.
+uint8_t gzipState = GZIP_HEADER;
+uint8_t gzipFlags = 0;
+uint8_t gzipHeader[10];
+size_t gzipFill = 0;
+uint32_t gzipSkip = 0;
+
+// Store Inflate State (dictionary is used as circular Output Buffer).
+tinfl_decompressor* inflator = NULL;
+uint8_t* dictionary = NULL;
+size_t dictionaryOffset = 0;
+
+/**
+ * Downloads a Firmware Image (plain, gzip compressed or as Delta Patch against
+ * the running Partition) and streams it into the inactive OTA Slot.
+ *
+ * The Download is decoded on the fly, nothing but a 5 KB Heap Buffer (and
+ * the 32 KB Inflate Dictionary for gzip) is held in RAM. The SHA-256 of the
+ * resulting Image is compared against the Manifest before the new Slot gets
+ * marked as Boot Partition. On any Failure the Slot is aborted and the running
+ * Firmware stays untouched.
+ *
+ * Preconditions:
+ * - Must be called from the Update Task, the Download blocks until finished.
+ * - Delta Patches (see PatchParser) need a Hash, as a Patch against the wrong
+ *   running Version only fails the Hash Check.
+ *
+ * @param url The URL of the Image or Patch.
+ * @param gzip True if the Download is gzip compressed.
+ * @param delta True if the (decompressed) Download is a Delta Patch.
+ * @param sha256 Hex encoded SHA-256 of the resulting Image or empty to skip (full Images only).
+ * @param progress Callback receiving downloaded and total Bytes (may be NULL).
+ * @return True if the new Image has been written, verified and marked for Boot.
+ */
+bool PatchHandler::update(const char* url, bool gzip, bool delta, const char* sha256,
+                          void (*progress)(size_t, size_t))
+{
+    // Never boot an unverified Delta.
+    if (delta && (sha256 == NULL || sha256[0] == '\0'))
+        return false;
+
+    HTTPClient http;
+    WiFiClient plain;
+    WiFiClientSecure secure;
+
+    // Same Behaviour as esp32FOTA (allow insecure HTTPS).
+    secure.setInsecure();
+
+    if (strncmp(url, "https", 5) == 0)
+        http.begin(secure, url);
+    else
+        http.begin(plain, url);
+
+    if (http.GET() != HTTP_CODE_OK)
+    {
+        http.end();
+        return false;
+    }
+
+    sourcePartition = esp_ota_get_running_partition();
+    targetPartition = esp_ota_get_next_update_partition(NULL);
+
+    if (targetPartition == NULL || esp_ota_begin(targetPartition, OTA_SIZE_UNKNOWN, &otaHandle) != ESP_OK)
+    {
+        http.end();
+        return false;
+    }
+
+    // Reset Decoder State.
+    patchDelta = delta;
+    patchGzip = gzip;
+    PatchParser::begin(copySource, writeOutput);
+    gzipState = GZIP_HEADER;
+    gzipFill = 0;
+    dictionaryOffset = 0;
+    outputLength = 0;
+    outputWritten = 0;
+
+    outputBuffer = (uint8_t*)malloc(PATCH_OUTPUT + PATCH_CHUNK);
+
+    if (gzip)
+    {
+        inflator = (tinfl_decompressor*)malloc(sizeof(tinfl_decompressor));
+        dictionary = (uint8_t*)malloc(TINFL_LZ_DICT_SIZE);
+
+        if (inflator != NULL)
+            tinfl_init(inflator);
+    }
+
+    bool ok = (outputBuffer != NULL && (!gzip || (inflator != NULL && dictionary != NULL)));
+
+    mbedtls_sha256_init(&shaContext);
+    mbedtls_sha256_starts_ret(&shaContext, 0);
+
+    // Stream Download into Decoder.
+    WiFiClient* stream = http.getStreamPtr();
+    int total = http.getSize();
+    size_t received = 0;
+    unsigned long dataMillis = millis();
+    uint8_t* chunk = (outputBuffer != NULL ? outputBuffer + PATCH_OUTPUT : NULL);
+
+    while (ok && (total < 0 || received < (size_t)total))
+    {
+        size_t available = stream->available();
+
+        if (available == 0)
+        {
+            // Server closed Connection (chunked Transfer finished).
+            if (!stream->connected() || millis() - dataMillis > PATCH_TIMEOUT)
+                break;
+
+            delay(1);
+            continue;
+        }
+
+        size_t length = stream->readBytes(chunk, min(available, (size_t)PATCH_CHUNK));
+
+        received += length;
+        dataMillis = millis();
+
+        ok = (gzip ? feedGzip(chunk, length) : feed(chunk, length));
+
+        if (progress != NULL)
+            progress(received, (total > 0 ? total : 0));
+    }
+
+    http.end();
+
+    // Check if the Stream was complete.
+    ok = ok && flushOutput();
+    ok = ok && (total < 0 || received == (size_t)total);
+    ok = ok && (!gzip || gzipState == GZIP_DONE);
+    ok = ok && (!delta || PatchParser::isDone());
+    ok = ok && verifyHash(sha256);
+
+    // Only boot verified Images.
+    if (ok)
+        ok = esp_ota_end(otaHandle) == ESP_OK && esp_ota_set_boot_partition(targetPartition) == ESP_OK;
+    else
+        esp_ota_abort(otaHandle);
+
+    release();
+
+#if DEBUG == true
+    Serial.printf("Patch %s: %u bytes\n", (ok ? "OK" : "failed"), outputWritten);
+#endif
+
+    return ok;
+}
+
+/**
+ * Passes decoded Bytes either to the Patch Parser or directly to the Output.
+ *
+ * @param data The decoded Bytes.
+ * @param length The Number of Bytes.
+ * @return True on Success.
+ */
+bool PatchHandler::feed(const uint8_t* data, size_t length)
+{
+    return (patchDelta ? PatchParser::feed(data, length) : writeOutput(data, length));
+}
+
+/**
+ * Skips the gzip Header (RFC 1952) and inflates the Body.
+ *
+ * @param data The compressed Bytes.
+ * @param length The Number of Bytes.
+ * @return True on Success, false on a malformed Stream.
+ */
+bool PatchHandler::feedGzip(const uint8_t* data, size_t length)
+{
+    size_t i = 0;
+
+    while (i < length)
+    {
+        switch (gzipState)
+        {
+        case GZIP_HEADER:
+            gzipHeader[gzipFill++] = data[i++];
+
+            if (gzipFill == sizeof(gzipHeader))
+            {
+                // Check Magic and Deflate Method.
+                if (gzipHeader[0] != 0x1f || gzipHeader[1] != 0x8b || gzipHeader[2] != 8)
+                    return false;
+
+                gzipFlags = gzipHeader[3];
+                gzipFill = 0;
+                gzipState = GZIP_EXTRA_LENGTH;
+            }
+            break;
+        case GZIP_EXTRA_LENGTH:
+            if (!(gzipFlags & GZIP_FEXTRA))
+            {
+                gzipState = GZIP_NAME;
+                break;
+            }
+
+            gzipHeader[gzipFill++] = data[i++];
+
+            if (gzipFill == 2)
+            {
+                gzipSkip = gzipHeader[0] | (gzipHeader[1] << 8);
+                gzipState = GZIP_EXTRA;
+            }
+            break;
+        case GZIP_EXTRA:
+            if (gzipSkip == 0)
+            {
+                gzipState = GZIP_NAME;
+                break;
+            }
+
+            gzipSkip--;
+            i++;
+            break;
+        case GZIP_NAME:
+            if (!(gzipFlags & GZIP_FNAME) || data[i++] == 0)
+                gzipState = GZIP_COMMENT;
+            break;
+        case GZIP_COMMENT:
+            if (!(gzipFlags & GZIP_FCOMMENT) || data[i++] == 0)
+            {
+                gzipSkip = (gzipFlags & GZIP_FHCRC ? 2 : 0);
+                gzipState = GZIP_CRC;
+            }
+            break;
+        case GZIP_CRC:
+            if (gzipSkip == 0)
+            {
+                gzipState = GZIP_BODY;
+                break;
+            }
+
+            gzipSkip--;
+            i++;
+            break;
+        case GZIP_BODY:
+            {
+                if (!inflate(data + i, length - i))
+                    return false;
+
+                i = length;
+            }
+            break;
+        default:
+            // Ignore CRC32 and Size Trailer, the Image is verified via SHA-256.
+            i = length;
+            break;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Inflates raw Deflate Data into the circular Dictionary and feeds the
+ * decompressed Bytes to the Decoder.
+ *
+ * @param data The compressed Bytes.
+ * @param length The Number of Bytes.
+ * @return True on Success.
+ */
+bool PatchHandler::inflate(const uint8_t* data, size_t length)
+{
+    for (;;)
+    {
+        size_t inBytes = length;
+        size_t outBytes = TINFL_LZ_DICT_SIZE - dictionaryOffset;
+
+        tinfl_status status = tinfl_decompress(inflator, data, &inBytes, dictionary,
+                                               dictionary + dictionaryOffset, &outBytes,
+                                               TINFL_FLAG_HAS_MORE_INPUT);
+
+        data += inBytes;
+        length -= inBytes;
+
+        if (outBytes > 0 && !feed(dictionary + dictionaryOffset, outBytes))
+            return false;
+
+        dictionaryOffset = (dictionaryOffset + outBytes) & (TINFL_LZ_DICT_SIZE - 1);
+
+        if (status == TINFL_STATUS_DONE)
+        {
+            gzipState = GZIP_DONE;
+            return true;
+        }
+
+        if (status < TINFL_STATUS_DONE)
+            return false;
+
+        if (status == TINFL_STATUS_NEEDS_MORE_INPUT && length == 0)
+            return true;
+    }
+}
+
+/**
+ * Copies a Range of the running Partition into the Output.
+ *
+ * Reads straight into the free Part of the Output Buffer, so no Copy Buffer
+ * is needed on the Stack of the Update Task.
+ *
+ * @param offset The Offset inside the running Partition.
+ * @param length The Number of Bytes.
+ * @return True on Success, false if the Range is out of Bounds.
+ */
+bool PatchHandler::copySource(uint32_t offset, uint32_t length)
+{
+    if (sourcePartition == NULL || offset + length > sourcePartition->size || offset + length < offset)
+        return false;
+
+    while (length > 0)
+    {
+        uint8_t* space = outputBuffer + outputLength;
+        size_t count = min((size_t)length, (size_t)(PATCH_OUTPUT - outputLength));
+
+        if (esp_partition_read(sourcePartition, offset, space, count) != ESP_OK)
+            return false;
+
+        mbedtls_sha256_update_ret(&shaContext, space, count);
+
+        outputLength += count;
+        offset += count;
+        length -= count;
+
+        if (outputLength == PATCH_OUTPUT && !flushOutput())
+            return false;
+    }
+
+    return true;
+}
+
+/**
+ * Hashes and buffers Bytes of the resulting Image.
+ *
+ * @param data The Image Bytes.
+ * @param length The Number of Bytes.
+ * @return True on Success.
+ */
+bool PatchHandler::writeOutput(const uint8_t* data, size_t length)
+{
+    mbedtls_sha256_update_ret(&shaContext, data, length);
+
+    while (length > 0)
+    {
+        size_t count = min(length, (size_t)(PATCH_OUTPUT - outputLength));
+
+        memcpy(outputBuffer + outputLength, data, count);
+
+        outputLength += count;
+        data += count;
+        length -= count;
+
+        if (outputLength == PATCH_OUTPUT && !flushOutput())
+            return false;
+    }
+
+    return true;
+}
+
+/**
+ * Writes the buffered Output into the OTA Slot.
+ *
+ * @return True on Success.
+ */
+bool PatchHandler::flushOutput()
+{
+    if (outputLength == 0)
+        return true;
+
+    if (esp_ota_write(otaHandle, outputBuffer, outputLength) != ESP_OK)
+        return false;
+
+    outputWritten += outputLength;
+    outputLength = 0;
+
+    return true;
+}
+
+/**
+ * Compares the SHA-256 of the written Image with the expected Hash.
+ *
+ * @param sha256 Hex encoded Hash (case insensitive) or empty to skip.
+ * @return True if the Hash matches or no Hash was given.
+ */
+bool PatchHandler::verifyHash(const char* sha256)
+{
+    uint8_t digest[32];
+    char hex[65];
+
+    mbedtls_sha256_finish_ret(&shaContext, digest);
+
+    if (sha256 == NULL || sha256[0] == '\0')
+        return true;
+
+    for (int i = 0; i < 32; i++)
+    {
+        sprintf(hex + (i * 2), "%02x", digest[i]);
+    }
+
+    return strcasecmp(hex, sha256) == 0;
+}
+
+/**
+ * Frees all Buffers of the Decoder.
+ */
+void PatchHandler::release()
+{
+    mbedtls_sha256_free(&shaContext);
+
+    free(outputBuffer);
+    free(inflator);
+    free(dictionary);
+
+    outputBuffer = NULL;
+    inflator = NULL;
+    dictionary = NULL;
+}
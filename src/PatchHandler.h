@@ -0,0 +1,28 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#ifndef PATCHHANDLER_H
+#define PATCHHANDLER_H
+#include <Arduino.h>
+
+
+class PatchHandler
+{
+private:
+    static bool feed(const uint8_t* data, size_t length);
+    static bool feedGzip(const uint8_t* data, size_t length);
+    static bool inflate(const uint8_t* data, size_t length);
+    static bool copySource(uint32_t offset, uint32_t length);
+    static bool writeOutput(const uint8_t* data, size_t length);
+    static bool flushOutput();
+    static bool verifyHash(const char* sha256);
+    static void release();
+
+public:
+    static bool update(const char* url, bool gzip, bool delta, const char* sha256,
+                       void (*progress)(size_t, size_t));
+};
+
+
+#endif //PATCHHANDLER_H
@@ -0,0 +1,179 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#include "PatchParser.h"
+#include <string.h>
+
+// Define Patch Opcodes (see tools/mkpatch.py).
+#define PATCH_END 0x00
+#define PATCH_COPY 0x01
+#define PATCH_INSERT 0x02
+
+// Define Patch Parser States.
+#define PATCH_HEADER 0
+#define PATCH_OPCODE 1
+#define PATCH_ARGS 2
+#define PATCH_DATA 3
+#define PATCH_DONE 4
+
+// Store Operation Callbacks.
+bool (*patchCopy)(uint32_t, uint32_t) = nullptr;
+bool (*patchInsert)(const uint8_t*, size_t) = nullptr;
+
+// Store Patch Parser State.
+uint8_t patchState = PATCH_HEADER;
+uint8_t patchHeader[8];
+uint8_t patchArgs[8];
+uint8_t patchOpcode = PATCH_END;
+size_t patchFill = 0;
+uint32_t patchRemaining = 0;
+uint32_t patchTarget = 0;
+uint32_t patchProduced = 0;
+
+/**
+ * Reads a little-endian 32 Bit Value.
+ *
+ * @param data Pointer to the first Byte.
+ * @return The decoded Value.
+ */
+static uint32_t readU32(const uint8_t* data)
+{
+    return data[0] | (data[1] << 8) | (data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+/**
+ * Resets the Parser for a new Patch Stream.
+ *
+ * Patch Format (all Values little-endian):
+ * - Header: "BLD1" + uint32 Size of the resulting Image.
+ * - 0x01 COPY: uint32 Offset, uint32 Length => copy from running Partition.
+ * - 0x02 INSERT: uint32 Length + Data => copy from Patch Stream.
+ * - 0x00 END.
+ *
+ * @param copy Callback copying a Range of the running Image (Offset, Length).
+ * @param insert Callback writing Bytes of the Patch Stream.
+ */
+void PatchParser::begin(bool (*copy)(uint32_t, uint32_t), bool (*insert)(const uint8_t*, size_t))
+{
+    patchCopy = copy;
+    patchInsert = insert;
+
+    patchState = PATCH_HEADER;
+    patchFill = 0;
+    patchRemaining = 0;
+    patchTarget = 0;
+    patchProduced = 0;
+}
+
+/**
+ * Parses the Delta Patch Stream and applies its Operations.
+ *
+ * The Parser keeps its State between Calls, so Operations may be split across
+ * arbitrary Chunk Boundaries. Operations beyond the announced Image Size are
+ * rejected before their Callback runs.
+ *
+ * @param data The Patch Bytes.
+ * @param length The Number of Bytes.
+ * @return True on Success, false on a malformed Patch or a failed Callback.
+ */
+bool PatchParser::feed(const uint8_t* data, size_t length)
+{
+    size_t i = 0;
+
+    while (i < length)
+    {
+        switch (patchState)
+        {
+        case PATCH_HEADER:
+            patchHeader[patchFill++] = data[i++];
+
+            if (patchFill == sizeof(patchHeader))
+            {
+                if (memcmp(patchHeader, "BLD1", 4) != 0)
+                    return false;
+
+                patchTarget = readU32(patchHeader + 4);
+                patchState = PATCH_OPCODE;
+            }
+            break;
+        case PATCH_OPCODE:
+            patchOpcode = data[i++];
+            patchFill = 0;
+
+            if (patchOpcode == PATCH_END)
+                patchState = PATCH_DONE;
+            else if (patchOpcode == PATCH_COPY || patchOpcode == PATCH_INSERT)
+                patchState = PATCH_ARGS;
+            else
+                return false;
+            break;
+        case PATCH_ARGS:
+            patchArgs[patchFill++] = data[i++];
+
+            if (patchOpcode == PATCH_COPY && patchFill == 8)
+            {
+                uint32_t count = readU32(patchArgs + 4);
+
+                if (count > patchTarget - patchProduced || !patchCopy(readU32(patchArgs), count))
+                    return false;
+
+                patchProduced += count;
+                patchState = PATCH_OPCODE;
+            }
+            else if (patchOpcode == PATCH_INSERT && patchFill == 4)
+            {
+                patchRemaining = readU32(patchArgs);
+
+                if (patchRemaining > patchTarget - patchProduced)
+                    return false;
+
+                patchState = (patchRemaining > 0 ? PATCH_DATA : PATCH_OPCODE);
+            }
+            break;
+        case PATCH_DATA:
+            {
+                size_t count = length - i;
+
+                if (count > patchRemaining)
+                    count = patchRemaining;
+
+                if (!patchInsert(data + i, count))
+                    return false;
+
+                i += count;
+                patchRemaining -= count;
+                patchProduced += count;
+
+                if (patchRemaining == 0)
+                    patchState = PATCH_OPCODE;
+            }
+            break;
+        default:
+            // Trailing Data after END.
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Checks whether the Patch has been parsed completely.
+ *
+ * @return True if END was reached and exactly the announced Image Size was produced.
+ */
+bool PatchParser::isDone()
+{
+    return patchState == PATCH_DONE && patchProduced == patchTarget;
+}
+
+/**
+ * Retrieves the Size of the resulting Image announced by the Header.
+ *
+ * @return The Size in Bytes (0 before the Header was parsed).
+ */
+uint32_t PatchParser::getTarget()
+{
+    return patchTarget;
+}
@@ -0,0 +1,27 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#ifndef PATCHPARSER_H
+#define PATCHPARSER_H
+#include <stddef.h>
+#include <stdint.h>
+
+
+/**
+ * Streaming Parser for Delta Patches (BLD1, see tools/mkpatch.py).
+ *
+ * Free of Arduino Dependencies, the Operations are passed to Callbacks so the
+ * PatchHandler writes into the OTA Slot and the native Tests into RAM.
+ */
+class PatchParser
+{
+public:
+    static void begin(bool (*copy)(uint32_t, uint32_t), bool (*insert)(const uint8_t*, size_t));
+    static bool feed(const uint8_t* data, size_t length);
+    static bool isDone();
+    static uint32_t getTarget();
+};
+
+
+#endif //PATCHPARSER_H
@@ -0,0 +1,296 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#include "RelaisArbiter.h"
+
+// Store Relais States (Bit 0 = Channel 1).
+volatile uint32_t relaisStates = 0;
+
+// Store Channels waiting for their staggered Start.
+volatile uint32_t relaisPending = 0;
+
+// Store Channels switched on by the Automation.
+volatile uint32_t relaisAuto = 0;
+
+// Store running Channels preempted by an Interlock, until `release()` switched them off.
+volatile uint32_t relaisPreempted = 0;
+
+// Store Interlock Matrix (Channels which must not be on together) and Priorities.
+uint32_t relaisInterlock[RELAIS_COUNT];
+uint8_t relaisPriority[RELAIS_COUNT];
+
+// Store minimum Gap between two Starts (µs) and the last Start.
+int64_t relaisGap = RELAIS_START_GAP * 1000LL;
+int64_t relaisStarted = INT64_MIN / 2;
+
+// Store Timeout Deadlines (esp_timer µs, 0 = inactive).
+int64_t relaisDeadlines[RELAIS_COUNT];
+
+/**
+ * Clears Interlocks and Priorities and sets the Start Gap.
+ *
+ * Running Channels and their Deadlines are kept, so the Config can be
+ * reloaded without losing Track of the Pins.
+ *
+ * @param gap The minimum Gap between two Starts (µs).
+ */
+void RelaisArbiter::reset(int64_t gap)
+{
+    relaisGap = gap;
+
+    for (uint8_t i = 0; i < RELAIS_COUNT; i++)
+    {
+        relaisInterlock[i] = 0;
+        relaisPriority[i] = 0;
+    }
+}
+
+/**
+ * Sets the Priority of a Channel, the higher Priority wins an Interlock.
+ *
+ * @param index The Channel Index (0-based).
+ * @param priority The Priority.
+ */
+void RelaisArbiter::setPriority(uint8_t index, uint8_t priority)
+{
+    if (index < RELAIS_COUNT)
+        relaisPriority[index] = priority;
+}
+
+/**
+ * Adds a Group of mutually exclusive Channels to the symmetric Matrix.
+ *
+ * @param mask The Channels of the Group (Bit 0 = Channel 1).
+ */
+void RelaisArbiter::addInterlock(uint32_t mask)
+{
+    for (uint8_t i = 0; i < RELAIS_COUNT; i++)
+    {
+        if (mask & (1UL << i))
+            relaisInterlock[i] |= mask & ~(1UL << i);
+    }
+}
+
+/**
+ * Arbitrates a Request to switch a Channel on.
+ *
+ * - A Channel which is already on (or pending) stays untouched.
+ * - If an interlocked Channel is on, the Request wins only with a higher
+ *   Priority; the other Channel is released. Manual Commands never preempt
+ *   Channels held by the Automation.
+ * - Starts are spaced by the Gap; a Start inside the Gap is queued and has
+ *   to be started via `startNext()` after `wait`.
+ *
+ * @param index The Channel Index (0-based).
+ * @param source RELAIS_MANUAL or RELAIS_AUTO.
+ * @param now The current Time (µs).
+ * @param conflicts Receives the preempted Channels, which have to be switched off via `release()`.
+ * @param wait Receives the Time (µs) until the next Start is allowed.
+ * @return RELAIS_DENIED, RELAIS_ALREADY, RELAIS_STARTED or RELAIS_QUEUED.
+ */
+uint8_t RelaisArbiter::request(uint8_t index, uint8_t source, int64_t now, uint32_t* conflicts, int64_t* wait)
+{
+    uint32_t bit = 1UL << index;
+    uint32_t active = relaisStates | relaisPending;
+    uint8_t result;
+
+    *conflicts = 0;
+
+    if (active & bit)
+        result = RELAIS_ALREADY;
+    else
+    {
+        *conflicts = active & relaisInterlock[index];
+        result = RELAIS_STARTED;
+
+        for (uint8_t i = 0; i < RELAIS_COUNT; i++)
+        {
+            if (!(*conflicts & (1UL << i)))
+                continue;
+
+            if (relaisPriority[i] >= relaisPriority[index] || (source == RELAIS_MANUAL && (relaisAuto & (1UL << i))))
+                result = RELAIS_DENIED;
+        }
+
+        if (result == RELAIS_DENIED)
+            *conflicts = 0;
+    }
+
+    if (result == RELAIS_STARTED)
+    {
+        // Preempt interlocked Channels with lower Priority.
+        relaisPreempted |= relaisStates & *conflicts;
+        relaisStates &= ~*conflicts;
+        relaisPending &= ~*conflicts;
+        relaisAuto &= ~*conflicts;
+
+        if (relaisPending == 0 && now - relaisStarted >= relaisGap)
+        {
+            relaisStates |= bit;
+            relaisStarted = now;
+        }
+        else
+        {
+            relaisPending |= bit;
+            result = RELAIS_QUEUED;
+        }
+    }
+
+    if (result != RELAIS_DENIED && source == RELAIS_AUTO)
+        relaisAuto |= bit;
+
+    *wait = relaisStarted + relaisGap - now;
+
+    if (*wait < 0)
+        *wait = 0;
+
+    return result;
+}
+
+/**
+ * Releases a Channel, cancels its pending Start and Timeout.
+ *
+ * @param index The Channel Index (0-based).
+ * @return True if the Channel was running (not only pending), also if an
+ *         Interlock preempted it since.
+ */
+bool RelaisArbiter::release(uint8_t index)
+{
+    uint32_t bit = 1UL << index;
+    bool running = (relaisStates | relaisPreempted) & bit;
+
+    relaisStates &= ~bit;
+    relaisPreempted &= ~bit;
+    relaisPending &= ~bit;
+    relaisAuto &= ~bit;
+    relaisDeadlines[index] = 0;
+
+    return running;
+}
+
+/**
+ * Starts the pending Channel with the highest Priority.
+ *
+ * @param now The current Time (µs).
+ * @return The Channel Index (0-based) which has to be switched on, or -1.
+ */
+int8_t RelaisArbiter::startNext(int64_t now)
+{
+    int8_t next = -1;
+
+    for (uint8_t i = 0; i < RELAIS_COUNT; i++)
+    {
+        if ((relaisPending & (1UL << i)) && (next < 0 || relaisPriority[i] > relaisPriority[next]))
+            next = i;
+    }
+
+    if (next >= 0)
+    {
+        relaisPending &= ~(1UL << next);
+        relaisStates |= (1UL << next);
+        relaisStarted = now;
+    }
+
+    return next;
+}
+
+/**
+ * Checks whether Channels are waiting for their staggered Start.
+ *
+ * @return True if a Channel is pending.
+ */
+bool RelaisArbiter::hasPending()
+{
+    return relaisPending != 0;
+}
+
+/**
+ * Retrieves the minimum Gap between two Starts.
+ *
+ * @return The Gap (µs).
+ */
+int64_t RelaisArbiter::getGap()
+{
+    return relaisGap;
+}
+
+/**
+ * Retrieves the Channels which are on or waiting for their Start.
+ *
+ * @return The Channel Mask (Bit 0 = Channel 1).
+ */
+uint32_t RelaisArbiter::getActive()
+{
+    return relaisStates | relaisPending;
+}
+
+/**
+ * Converts a Duration into a Timeout limited to the `maxOn` Time of the Channel.
+ *
+ * @param index The Channel Index (0-based).
+ * @param duration The Duration in Seconds, 0 for the maximum On-Time.
+ * @return The Timeout in µs, 0 if the Channel has no Limit and no Duration was given.
+ */
+uint64_t RelaisArbiter::getTimeout(uint8_t index, uint32_t duration)
+{
+    uint32_t maxOn = relaisChannels[index].maxOn;
+
+    if (maxOn > 0 && (duration == 0 || duration > maxOn))
+        duration = maxOn;
+
+    return (uint64_t)duration * 1000000ULL;
+}
+
+/**
+ * Retrieves the Timeout which has to be started when a Channel switches on.
+ *
+ * A Deadline stored by `setDuration()` while the Channel was queued for its
+ * staggered Start is kept, otherwise the `maxOn` Time of the Channel applies.
+ *
+ * @param index The Channel Index (0-based).
+ * @return The Timeout in µs, 0 if a Deadline is pending or the Channel has no Limit.
+ */
+uint64_t RelaisArbiter::getStartTimeout(uint8_t index)
+{
+    if (relaisDeadlines[index] != 0)
+        return 0;
+
+    return getTimeout(index, 0);
+}
+
+/**
+ * Stores the Timeout Deadline of a Channel.
+ *
+ * @param index The Channel Index (0-based).
+ * @param deadline The Deadline (µs), 0 for none.
+ */
+void RelaisArbiter::setDeadline(uint8_t index, int64_t deadline)
+{
+    relaisDeadlines[index] = deadline;
+}
+
+/**
+ * Retrieves the Time until the Timeout of a Channel.
+ *
+ * The Deadline is a 64 Bit µs Timestamp, so it is exact and free of millis()
+ * Wraparound Issues. An expired Deadline (the Timer Task is late) reads 0.
+ *
+ * @param index The Channel Index (0-based).
+ * @param now The current Time (µs).
+ * @return The Time remaining in ms, or `0` if the Channel has no Timeout.
+ */
+int RelaisArbiter::getRemaining(uint8_t index, int64_t now)
+{
+    int64_t deadline = relaisDeadlines[index];
+    int64_t remaining = deadline - now;
+
+    if (deadline == 0 || remaining <= 0)
+        return 0;
+
+    // Durations beyond 24 Days do not fit into the Result.
+    if (remaining / 1000 > INT32_MAX)
+        return INT32_MAX;
+
+    return (int)(remaining / 1000);
+}
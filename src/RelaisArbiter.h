@@ -0,0 +1,75 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#ifndef RELAISARBITER_H
+#define RELAISARBITER_H
+#include <stdint.h>
+
+#include "InternalConfig.h"
+
+/**
+ * Describes a single Output Channel of the Board.
+ *
+ * pin => GPIO of the Channel.
+ * activeHigh => True if the Relais switches on with HIGH.
+ * maxOn => Maximum On-Time in Seconds (0 = unlimited), enforced via Timeout.
+ */
+struct RelaisChannel
+{
+    uint8_t pin;
+    bool activeHigh;
+    uint32_t maxOn;
+};
+
+// Define Channel Table (Index = Channel - 1), see RELAIS_TABLE.
+constexpr RelaisChannel relaisChannels[] = RELAIS_TABLE;
+
+constexpr uint8_t RELAIS_COUNT = sizeof(relaisChannels) / sizeof(relaisChannels[0]);
+
+static_assert(RELAIS_COUNT > 0 && RELAIS_COUNT <= 32, "RELAIS_TABLE must define 1 to 32 Channels");
+
+/**
+ * Define Command Sources for the Arbitration.
+ * Manual Commands never preempt Channels held by the Automation.
+ */
+#define RELAIS_MANUAL 0
+#define RELAIS_AUTO 1
+
+/**
+ * Define Results of `RelaisArbiter::request()`.
+ */
+#define RELAIS_DENIED 0
+#define RELAIS_ALREADY 1
+#define RELAIS_STARTED 2
+#define RELAIS_QUEUED 3
+
+
+/**
+ * Holds the Relais State Bits and decides Interlocks, Priorities, staggered
+ * Starts and Timeout Deadlines.
+ *
+ * Free of Arduino Dependencies, all Times are passed in (esp_timer µs) so
+ * the Arbitration runs unchanged in the native Tests. The RelaisHandler calls
+ * it inside its Critical Section and switches the Pins afterwards.
+ */
+class RelaisArbiter
+{
+public:
+    static void reset(int64_t gap);
+    static void setPriority(uint8_t index, uint8_t priority);
+    static void addInterlock(uint32_t mask);
+    static uint8_t request(uint8_t index, uint8_t source, int64_t now, uint32_t* conflicts, int64_t* wait);
+    static bool release(uint8_t index);
+    static int8_t startNext(int64_t now);
+    static bool hasPending();
+    static int64_t getGap();
+    static uint32_t getActive();
+    static uint64_t getTimeout(uint8_t index, uint32_t duration);
+    static uint64_t getStartTimeout(uint8_t index);
+    static void setDeadline(uint8_t index, int64_t deadline);
+    static int getRemaining(uint8_t index, int64_t now);
+};
+
+
+#endif //RELAISARBITER_H
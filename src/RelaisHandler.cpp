@@ -0,0 +1,378 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#include "RelaisHandler.h"
+#include <ArduinoJson.h>
+#include <esp_timer.h>
+
+#include "FileHandler.h"
+#include "InternalConfig.h"
+#include "StatsHandler.h"
+
+// Store Relais Timeout Timers (Deadlines are kept by the RelaisArbiter).
+esp_timer_handle_t relaisTimers[RELAIS_COUNT];
+
+// Store Stagger Timer (starts the next pending Channel).
+esp_timer_handle_t relaisStagger = nullptr;
+
+// Guard Relais State (RelaisArbiter) shared with the Timer and Web Tasks.
+portMUX_TYPE relaisMux = portMUX_INITIALIZER_UNLOCKED;
+
+/**
+ * Configures every Channel of the Table as Output (switched off) and creates
+ * its one-shot Timeout Timer.
+ *
+ * Runs before the Config is loaded, so the Outputs are driven to a defined
+ * Level as early as possible. The Interlocks are loaded by `configure()`.
+ */
+void RelaisHandler::setup()
+{
+    for (uint8_t i = 0; i < RELAIS_COUNT; i++)
+    {
+        const RelaisChannel& channel = relaisChannels[i];
+
+        // Write off Level before enabling the Output (active-low Boards).
+        digitalWrite(channel.pin, (channel.activeHigh ? LOW : HIGH));
+        pinMode(channel.pin, OUTPUT);
+
+        esp_timer_create_args_t args = {};
+        args.callback = handleTimeout;
+        args.arg = (void*)(intptr_t)(i + 1);
+        args.dispatch_method = ESP_TIMER_TASK;
+        args.name = "relais";
+
+        esp_timer_create(&args, &relaisTimers[i]);
+    }
+
+    esp_timer_create_args_t args = {};
+    args.callback = handleStagger;
+    args.dispatch_method = ESP_TIMER_TASK;
+    args.name = "stagger";
+
+    esp_timer_create(&args, &relaisStagger);
+}
+
+/**
+ * Loads the Interlock Matrix, the Priorities and the Start Gap from the Config.
+ *
+ * Config Format:
+ * "relais": {
+ *   "gap": 500,              => minimum Gap between two Starts in ms.
+ *   "priority": [0, 1],      => Priority per Channel, higher wins.
+ *   "interlock": [[1, 2]]    => Groups of mutually exclusive Channels.
+ * }
+ */
+void RelaisHandler::configure()
+{
+    JsonDocument config = FileHandler::getConfig();
+    JsonObjectConst relais = config["relais"].as<JsonObjectConst>();
+
+    int64_t gap = (relais["gap"] | RELAIS_START_GAP) * 1000LL;
+    uint8_t priority[RELAIS_COUNT];
+    uint32_t groups[RELAIS_COUNT];
+    uint8_t count = 0;
+
+    for (uint8_t i = 0; i < RELAIS_COUNT; i++)
+    {
+        priority[i] = relais["priority"][i] | 0;
+    }
+
+    // Collect Groups as Channel Masks.
+    for (JsonVariantConst group : relais["interlock"].as<JsonArrayConst>())
+    {
+        uint32_t mask = 0;
+
+        for (JsonVariantConst channel : group.as<JsonArrayConst>())
+        {
+            if (isValid(channel.as<int>()))
+                mask |= (1UL << (channel.as<int>() - 1));
+        }
+
+        if (count < RELAIS_COUNT)
+            groups[count++] = mask;
+    }
+
+    portENTER_CRITICAL(&relaisMux);
+    RelaisArbiter::reset(gap);
+
+    for (uint8_t i = 0; i < RELAIS_COUNT; i++)
+    {
+        RelaisArbiter::setPriority(i, priority[i]);
+    }
+
+    // Build symmetric Matrix from the Groups.
+    for (uint8_t i = 0; i < count; i++)
+    {
+        RelaisArbiter::addInterlock(groups[i]);
+    }
+    portEXIT_CRITICAL(&relaisMux);
+}
+
+/**
+ * Switches a Relais off once its Timeout has expired.
+ *
+ * This Callback runs in the esp_timer Task at the exact Deadline scheduled by
+ * `setDuration()` (or the `maxOn` Time of the Channel), independent of how
+ * long the current `loop()` Iteration takes.
+ *
+ * @param arg The Relais Channel (1-based) casted to a Pointer.
+ */
+void RelaisHandler::handleTimeout(void* arg)
+{
+    switchOff((int)(intptr_t)arg - 1);
+}
+
+/**
+ * Starts the pending Channel with the highest Priority.
+ *
+ * Runs in the esp_timer Task one Start Gap after the previous Start and
+ * reschedules itself while Channels are pending, so two Motors never draw
+ * their Inrush Current at the same Time.
+ *
+ * @param arg Unused.
+ */
+void RelaisHandler::handleStagger(void* arg)
+{
+    int64_t gap;
+    int8_t next;
+    bool more;
+
+    portENTER_CRITICAL(&relaisMux);
+    next = RelaisArbiter::startNext(esp_timer_get_time());
+    more = RelaisArbiter::hasPending();
+    gap = RelaisArbiter::getGap();
+    portEXIT_CRITICAL(&relaisMux);
+
+    if (next >= 0)
+        switchOn(next);
+
+    if (more)
+        esp_timer_start_once(relaisStagger, gap);
+}
+
+/**
+ * (Re)starts the Timeout of a Channel.
+ *
+ * @param index The Channel Index (0-based).
+ * @param timeout The Timeout in µs.
+ */
+void RelaisHandler::startTimeout(uint8_t index, uint64_t timeout)
+{
+    esp_timer_stop(relaisTimers[index]);
+
+    portENTER_CRITICAL(&relaisMux);
+    RelaisArbiter::setDeadline(index, esp_timer_get_time() + timeout);
+    portEXIT_CRITICAL(&relaisMux);
+
+    esp_timer_start_once(relaisTimers[index], timeout);
+}
+
+/**
+ * Writes the active Level of a Channel and enforces its maximum On-Time,
+ * unless a Duration is already pending. The State Bit must already be set.
+ *
+ * @param index The Channel Index (0-based).
+ */
+void RelaisHandler::switchOn(uint8_t index)
+{
+    writePin(index, true);
+
+    StatsHandler::onStart(index);
+
+    // Keep a Duration set while the Channel was queued.
+    portENTER_CRITICAL(&relaisMux);
+    uint64_t timeout = RelaisArbiter::getStartTimeout(index);
+    portEXIT_CRITICAL(&relaisMux);
+
+    if (timeout > 0)
+    {
+        startTimeout(index, timeout);
+    }
+}
+
+/**
+ * Switches a Channel off, cancels its pending Start and Timeout.
+ *
+ * @param index The Channel Index (0-based).
+ */
+void RelaisHandler::switchOff(uint8_t index)
+{
+    bool running;
+
+    portENTER_CRITICAL(&relaisMux);
+    running = RelaisArbiter::release(index);
+    portEXIT_CRITICAL(&relaisMux);
+
+    esp_timer_stop(relaisTimers[index]);
+
+    writePin(index, false);
+
+    if (running)
+        StatsHandler::onStop(index);
+}
+
+/**
+ * Writes the Level of a Channel according to its Polarity.
+ *
+ * @param index The Channel Index (0-based).
+ * @param state True for on, false for off.
+ */
+void RelaisHandler::writePin(uint8_t index, bool state)
+{
+    const RelaisChannel& entry = relaisChannels[index];
+
+    digitalWrite(entry.pin, (state == entry.activeHigh ? HIGH : LOW));
+
+#if DEBUG == true
+    Serial.print("Relais ");
+    Serial.print(index + 1);
+    Serial.print(" set to ");
+    Serial.println(state);
+#endif
+}
+
+/**
+ * Sets the state of the specified relay channel.
+ *
+ * Switching off always succeeds and cancels a pending Start or Timeout.
+ *
+ * Switching on is arbitrated by `RelaisArbiter::request()` (Interlocks,
+ * Priorities, Automation vs. manual Commands and staggered Starts).
+ *
+ * May be called from the Loop, the Web Task and the esp_timer Task.
+ *
+ * @param channel Specifies the relay channel to be controlled (1 to getCount()).
+ * @param state The desired state for the relay: true for on, false for off.
+ * @param source RELAIS_MANUAL (API) or RELAIS_AUTO (AutomationHandler).
+ * @return False if the Channel is invalid or interlocked.
+ */
+bool RelaisHandler::set(int channel, bool state, uint8_t source)
+{
+    if (!isValid(channel))
+        return false;
+
+    uint8_t index = channel - 1;
+
+    if (!state)
+    {
+        switchOff(index);
+        return true;
+    }
+
+    uint32_t conflicts;
+    int64_t wait;
+    uint8_t result;
+
+    portENTER_CRITICAL(&relaisMux);
+    result = RelaisArbiter::request(index, source, esp_timer_get_time(), &conflicts, &wait);
+    portEXIT_CRITICAL(&relaisMux);
+
+    if (result == RELAIS_DENIED)
+    {
+#if DEBUG == true
+        Serial.print("Relais ");
+        Serial.print(channel);
+        Serial.println(" interlocked");
+#endif
+        return false;
+    }
+
+    if (result == RELAIS_ALREADY)
+        return true;
+
+    for (uint8_t i = 0; i < RELAIS_COUNT; i++)
+    {
+        if (conflicts & (1UL << i))
+            switchOff(i);
+    }
+
+    if (result == RELAIS_STARTED)
+        switchOn(index);
+    else
+    {
+        // Fails with ESP_ERR_INVALID_STATE if the Stagger is already running.
+        esp_timer_start_once(relaisStagger, wait);
+    }
+
+    return true;
+}
+
+/**
+ * Sets the duration for which a specific relay channel should remain active.
+ *
+ * Schedules a one-shot esp_timer which switches the Channel off at the
+ * Deadline. Calling it again restarts the Timeout, `set()` cancels it. The
+ * Duration is limited to the `maxOn` Time of the Channel.
+ *
+ * @param channel The relay channel to set the duration for.
+ * @param duration The duration in seconds for which the relay should remain active.
+ * @return False if the Channel or Duration is invalid.
+ */
+bool RelaisHandler::setDuration(int channel, int duration)
+{
+    if (!isValid(channel) || duration <= 0)
+        return false;
+
+    startTimeout(channel - 1, RelaisArbiter::getTimeout(channel - 1, duration));
+
+    return true;
+}
+
+/**
+ * Retrieves the state of a specified relay.
+ *
+ * A Channel waiting for its staggered Start already counts as on.
+ *
+ * @param channel The relay channel (1 to getCount()).
+ * @return True if the relay is on, false if it is off or the Channel is invalid.
+ */
+bool RelaisHandler::getState(int channel)
+{
+    if (!isValid(channel))
+        return false;
+
+    return (RelaisArbiter::getActive() >> (channel - 1)) & 1;
+}
+
+/**
+ * Retrieves the remaining duration (in milliseconds) for a specified relay channel.
+ *
+ * The Remaining Time is calculated from the esp_timer Deadline (64 Bit µs),
+ * so it is exact and free of millis() Wraparound Issues.
+ *
+ * @param channel The relay channel (1 to getCount()).
+ * @return The Time remaining in ms, or `0` if the Channel is invalid or has no Timeout.
+ */
+int RelaisHandler::getDuration(int channel)
+{
+    if (!isValid(channel))
+        return 0;
+
+    portENTER_CRITICAL(&relaisMux);
+    int remaining = RelaisArbiter::getRemaining(channel - 1, esp_timer_get_time());
+    portEXIT_CRITICAL(&relaisMux);
+
+    return remaining;
+}
+
+/**
+ * Retrieves the Number of Relais Channels of the Table.
+ *
+ * @return The Number of Channels (Channels are numbered 1 to Count).
+ */
+uint8_t RelaisHandler::getCount()
+{
+    return RELAIS_COUNT;
+}
+
+/**
+ * Checks if a Channel exists in the Table.
+ *
+ * @param channel The relay channel (1-based).
+ * @return True if the Channel exists.
+ */
+bool RelaisHandler::isValid(int channel)
+{
+    return channel >= 1 && channel <= RELAIS_COUNT;
+}
@@ -0,0 +1,34 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#ifndef RELAISHANDLER_H
+#define RELAISHANDLER_H
+#include <Arduino.h>
+
+#include "InternalConfig.h"
+#include "RelaisArbiter.h"
+
+class RelaisHandler
+{
+private:
+    static void handleTimeout(void* arg);
+    static void handleStagger(void* arg);
+    static void startTimeout(uint8_t index, uint64_t timeout);
+    static void switchOn(uint8_t index);
+    static void switchOff(uint8_t index);
+    static void writePin(uint8_t index, bool state);
+
+public:
+    static void setup();
+    static void configure();
+    static bool set(int channel, bool state, uint8_t source = RELAIS_MANUAL);
+    static bool setDuration(int channel, int duration);
+    static bool getState(int channel);
+    static int getDuration(int channel);
+    static uint8_t getCount();
+    static bool isValid(int channel);
+};
+
+
+#endif //RELAISHANDLER_H
@@ -0,0 +1,458 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#include "SensorHandler.h"
+#include <Wire.h>
+#include <esp_adc_cal.h>
+
+#include "AdcTable.h"
+#include "DeviceHandler.h"
+#include "FileHandler.h"
+#include "InternalConfig.h"
+
+// Store Sensor Task Handle.
+TaskHandle_t sensorTask = NULL;
+
+// Store eFuse Characterization of the ADC.
+esp_adc_cal_characteristics_t adcCharacteristics;
+
+/**
+ * Builds the Sensor Registry and starts the round-robin Sampling Task.
+ *
+ * Sensor 0 is the built-in Tank Input on `SENSE`, calibrated by the
+ * "calibration" Section. Further Sensors are read from the Config:
+ *
+ * "sensors": [
+ *   {"type": "ads1115", "name": "tank2", "address": 72, "channel": 0, "min": 0.4, "max": 2.0, "volume": 500},
+ *   {"type": "ds18b20", "name": "water", "pin": 4},
+ *   {"type": "adc", "name": "tank3", "pin": 4, "scale": 1.0, "offset": 0.0, "alpha": 0.3,
+ *    "trim": [[500, 512], [2000, 1985]], "tc": 150}
+ * ]
+ */
+void SensorHandler::setup()
+{
+    JsonDocument config = FileHandler::getConfig();
+
+    SensorRegistry::begin({readADC, readADS1115, readDS18B20});
+
+    // Build ADC Table from the eFuse Characterization and the Calibration Points.
+    setupADC(config["calibration"]["points"].as<JsonArrayConst>());
+
+    // Built-in Tank Input.
+    JsonDocument tank;
+    tank["name"] = "tank";
+    tank["pin"] = SENSE;
+    tank["min"] = config["calibration"]["min"].as<float>();
+    tank["max"] = config["calibration"]["max"].as<float>();
+    tank["volume"] = config["calibration"]["volume"].as<float>();
+    tank["trim"] = config["calibration"]["trim"];
+    tank["tc"] = config["calibration"]["tc"];
+
+    add(SENSOR_ADC, tank.as<JsonObjectConst>());
+
+    // Configured Sensors.
+    bool i2c = false;
+
+    for (JsonVariantConst entry : config["sensors"].as<JsonArrayConst>())
+    {
+        int8_t type = SensorRegistry::findType(entry["type"] | "");
+
+        if (type >= 0)
+        {
+            add(type, entry.as<JsonObjectConst>());
+            i2c |= (type == SENSOR_ADS1115);
+        }
+    }
+
+    // Display might be disabled, start the Bus for the ADS1115 (the Display Task may be starting it as well).
+    if (i2c && DeviceHandler::lockWire())
+    {
+        Wire.begin();
+        DeviceHandler::unlockWire();
+    }
+
+    xTaskCreate(
+        handleSensors,
+        "Sensor Task",
+        SENSOR_STACK,
+        NULL,
+        1,
+        &sensorTask
+    );
+}
+
+/**
+ * Adds a Sensor to the Registry, Sensors beyond SENSOR_MAX are ignored.
+ *
+ * @param type The Driver (SENSOR_*).
+ * @param config The Sensor Config (pin, address, channel, calibration).
+ */
+void SensorHandler::add(uint8_t type, JsonObjectConst config)
+{
+    Sensor* sensor = SensorRegistry::add(type, config["name"]);
+
+    if (sensor == nullptr)
+        return;
+
+    sensor->pin = config["pin"] | SENSE;
+    sensor->address = config["address"] | 0x48;
+    sensor->channel = config["channel"] | 0;
+    sensor->scale = config["scale"] | 1.0f;
+    sensor->offset = config["offset"] | 0.0f;
+    sensor->alpha = config["alpha"] | (float)EMA_ALPHA;
+    sensor->min = config["min"] | 0.0f;
+    sensor->max = config["max"] | 0.0f;
+    sensor->volume = config["volume"] | 0.0f;
+
+    if (type == SENSOR_ADC)
+    {
+        analogSetPinAttenuation(sensor->pin, ADC_11db);
+        pinMode(sensor->pin, INPUT);
+
+        setupTrim(*sensor, config["trim"].as<JsonArrayConst>());
+
+        sensor->tc = config["tc"] | 0;
+    }
+    else if (type == SENSOR_DS18B20)
+    {
+        sensor->bus = new OneWire(sensor->pin);
+    }
+}
+
+/**
+ * Samples one Sensor per Time Slice (see `SensorRegistry::getSlice()`).
+ *
+ * ADS1115 and DS18B20 Conversions are started on one Visit and read on the
+ * next, so the Task never waits for a Conversion.
+ *
+ * @param parameter Unused Task Parameter.
+ */
+void SensorHandler::handleSensors(void* parameter)
+{
+    TickType_t wakeTime = xTaskGetTickCount();
+    TickType_t slice = SensorRegistry::getSlice(pdMS_TO_TICKS(SCAN_INTERVAL));
+
+    for (;;)
+    {
+        SensorRegistry::step();
+
+        vTaskDelayUntil(&wakeTime, slice);
+    }
+}
+
+/**
+ * Builds the ADC Linearization Table from the eFuse Characterization.
+ *
+ * The Characterization of the Chip (Two-Point Values burned into the eFuse)
+ * is linear, the 11 dB Range bends off at both Ends. The optional
+ * Calibration Points correct it piecewise linear:
+ *
+ * "points": [[measured mV, true mV], ...] (ascending, up to ADC_POINTS)
+ *
+ * Both are evaluated once per Table Entry, so converting a Sample only costs
+ * an integer Interpolation (see `AdcTable::linearize()`).
+ *
+ * @param points The Calibration Points, invalid Points are ignored.
+ */
+void SensorHandler::setupADC(JsonArrayConst points)
+{
+    esp_adc_cal_value_t source = esp_adc_cal_characterize(ADC_UNIT_1, ADC_ATTEN_DB_11, ADC_WIDTH_BIT_12, 1100, &adcCharacteristics);
+
+    int32_t table[ADC_POINTS][2];
+    uint8_t count = 0;
+
+    for (JsonArrayConst point : points)
+    {
+        if (count == ADC_POINTS)
+            break;
+
+        table[count][0] = point[0] | 0;
+        table[count][1] = point[1] | 0;
+        count++;
+    }
+
+    bool valid = AdcTable::build(characterize, table, count);
+
+#if DEBUG == true
+    Serial.printf("ADC calibrated (%s, %u Points%s)\n", source == ESP_ADC_CAL_VAL_EFUSE_TP ? "eFuse TP" : source == ESP_ADC_CAL_VAL_EFUSE_VREF ? "eFuse Vref" : "default", count, valid ? "" : " ignored");
+#else
+    (void)source;
+    (void)valid;
+#endif
+}
+
+/**
+ * Converts ADC Counts to mV with the eFuse Characterization.
+ *
+ * @param counts The raw ADC Counts.
+ * @return The Voltage in mV.
+ */
+uint32_t SensorHandler::characterize(uint32_t counts)
+{
+    return esp_adc_cal_raw_to_voltage(counts, &adcCharacteristics);
+}
+
+/**
+ * Calculates the Q16 Gain and Offset of the optional User Two-Point Trim.
+ *
+ * "trim": [[measured mV, true mV], [measured mV, true mV]]
+ *
+ * @param sensor The Sensor.
+ * @param trim The Trim Points, invalid or missing Points disable the Trim.
+ */
+void SensorHandler::setupTrim(Sensor& sensor, JsonArrayConst trim)
+{
+    sensor.trimGain = 65536;
+    sensor.trimOffset = 0;
+
+    if (trim.size() != 2)
+        return;
+
+    int32_t measured1 = trim[0][0] | 0;
+    int32_t true1 = trim[0][1] | 0;
+    int32_t measured2 = trim[1][0] | 0;
+    int32_t true2 = trim[1][1] | 0;
+
+    if (measured2 == measured1)
+        return;
+
+    sensor.trimGain = ((int64_t)(true2 - true1) << 16) / (measured2 - measured1);
+    sensor.trimOffset = true1 - (int32_t)(((int64_t)measured1 * sensor.trimGain) >> 16);
+}
+
+/**
+ * Applies the User Trim and the Temperature Drift Compensation.
+ *
+ * The Q16 Drift Gain is only recalculated when the (integer) CPU Temperature
+ * changes, every Sample just multiplies and shifts.
+ *
+ * @param sensor The Sensor.
+ * @param millivolts The linearized Voltage in mV.
+ * @return The compensated Voltage in mV.
+ */
+int32_t SensorHandler::compensate(Sensor& sensor, int32_t millivolts)
+{
+    millivolts = (int32_t)(((int64_t)millivolts * sensor.trimGain) >> 16) + sensor.trimOffset;
+
+    if (sensor.tc == 0)
+        return millivolts;
+
+    int16_t temperature = (int16_t)lroundf(DeviceHandler::getCPUTemperatureCached());
+
+    if (temperature != sensor.tcTemp)
+    {
+        // gain = 1 - tc * (T - Tref) / 10^6
+        int64_t drift = (int64_t)sensor.tc * (temperature - ADC_TC_REFERENCE) * 65536;
+
+        sensor.tcGain = 65536 - (int32_t)(drift / 1000000);
+        sensor.tcTemp = temperature;
+    }
+
+    return (int32_t)(((int64_t)millivolts * sensor.tcGain) >> 16);
+}
+
+/**
+ * Reads the averaged, linearized and compensated Voltage of an ADC Pin.
+ *
+ * The raw Counts are summed up and converted with integer Math only, the
+ * Float Conversion happens once per Sample at the End.
+ *
+ * @param sensor The Sensor.
+ * @param raw The Voltage in V.
+ * @return Always true.
+ */
+bool SensorHandler::readADC(Sensor& sensor, float& raw)
+{
+    uint32_t sum = 0;
+
+    for (int i = 0; i < SENSOR_SAMPLES; i++)
+    {
+        sum += analogRead(sensor.pin);
+    }
+
+    // Average with 4 fractional Bits.
+    uint32_t position = (sum << 4) / SENSOR_SAMPLES;
+
+    int32_t millivolts = compensate(sensor, AdcTable::linearize(position));
+
+    raw = millivolts / 1000.0f;
+
+    return true;
+}
+
+/**
+ * Reads the last single-shot Conversion of an ADS1115 and starts the next one.
+ *
+ * Single-ended Input `channel` against GND, ±4.096 V, 128 SPS (8 ms).
+ *
+ * @param sensor The Sensor.
+ * @param raw The Voltage in V.
+ * @return True if a Conversion has been read.
+ */
+bool SensorHandler::readADS1115(Sensor& sensor, float& raw)
+{
+    bool read = false;
+
+    if (!DeviceHandler::lockWire())
+        return false;
+
+    if (sensor.started)
+    {
+        // Select Conversion Register.
+        Wire.beginTransmission(sensor.address);
+        Wire.write((uint8_t)0x00);
+
+        if (Wire.endTransmission() == 0 && Wire.requestFrom(sensor.address, (uint8_t)2) == 2)
+        {
+            uint8_t high = Wire.read();
+            uint8_t low = Wire.read();
+            int16_t value = (int16_t)((high << 8) | low);
+
+            raw = value * 4.096f / 32768.0f;
+            read = true;
+        }
+    }
+
+    // Start next Conversion (OS, MUX, PGA ±4.096 V, single-shot, 128 SPS, no Comparator).
+    uint16_t config = 0x8000 | ((4 + (sensor.channel & 0x03)) << 12) | (1 << 9) | (1 << 8) | (4 << 5) | 0x03;
+
+    Wire.beginTransmission(sensor.address);
+    Wire.write((uint8_t)0x01);
+    Wire.write((uint8_t)(config >> 8));
+    Wire.write((uint8_t)(config & 0xFF));
+    sensor.started = Wire.endTransmission() == 0;
+
+    DeviceHandler::unlockWire();
+
+    return read;
+}
+
+/**
+ * Reads the last Conversion of a DS18B20 and starts the next one.
+ *
+ * One Sensor per Pin (Skip ROM). The 12 Bit Conversion takes 750 ms, which is
+ * covered by the SCAN_INTERVAL between two Visits.
+ *
+ * @param sensor The Sensor.
+ * @param raw The Temperature in °C.
+ * @return True if a valid Scratchpad has been read.
+ */
+bool SensorHandler::readDS18B20(Sensor& sensor, float& raw)
+{
+    OneWire& bus = *sensor.bus;
+    bool read = false;
+
+    if (sensor.started && bus.reset())
+    {
+        uint8_t data[9];
+
+        // Read Scratchpad.
+        bus.skip();
+        bus.write(0xBE);
+        bus.read_bytes(data, sizeof(data));
+
+        if (OneWire::crc8(data, 8) == data[8])
+        {
+            raw = (int16_t)((data[1] << 8) | data[0]) / 16.0f;
+            read = true;
+        }
+    }
+
+    // Start next Conversion.
+    sensor.started = bus.reset();
+
+    if (sensor.started)
+    {
+        bus.skip();
+        bus.write(0x44);
+    }
+
+    return read;
+}
+
+/**
+ * Retrieves the Number of registered Sensors.
+ *
+ * @return The Number of Sensors (at least the Tank Sensor).
+ */
+uint8_t SensorHandler::getCount()
+{
+    return SensorRegistry::getCount();
+}
+
+/**
+ * Retrieves the configured Name of a Sensor.
+ *
+ * @param index The Sensor Index.
+ * @return The Name, or an empty String if the Index is invalid.
+ */
+const char* SensorHandler::getName(uint8_t index)
+{
+    return SensorRegistry::getName(index);
+}
+
+/**
+ * Retrieves the Driver Name of a Sensor (adc, ads1115, ds18b20).
+ *
+ * @param index The Sensor Index.
+ * @return The Driver Name, or an empty String if the Index is invalid.
+ */
+const char* SensorHandler::getType(uint8_t index)
+{
+    return SensorRegistry::getType(index);
+}
+
+/**
+ * Checks if a Sensor has delivered at least one Value.
+ *
+ * @param index The Sensor Index.
+ * @return True if the cached Value is valid.
+ */
+bool SensorHandler::isValid(uint8_t index)
+{
+    return SensorRegistry::isValid(index);
+}
+
+/**
+ * Retrieves the cached, calibrated and filtered Value of a Sensor.
+ *
+ * @param index The Sensor Index.
+ * @return The Value (V for ADC/ADS1115, °C for DS18B20), or `0` if invalid.
+ */
+float SensorHandler::getValue(uint8_t index)
+{
+    return SensorRegistry::getValue(index);
+}
+
+/**
+ * Maps the Value of a Sensor between its `min` and `max` to a Level.
+ *
+ * @param index The Sensor Index.
+ * @return The Level in % (0 to 100), or `0` if the Sensor has no Level Mapping.
+ */
+float SensorHandler::getLevel(uint8_t index)
+{
+    return SensorRegistry::getLevel(index);
+}
+
+/**
+ * Calculates the Volume of the Tank monitored by a Sensor.
+ *
+ * @param index The Sensor Index.
+ * @return The Volume in L, or `0` if the Sensor has no Tank Volume.
+ */
+float SensorHandler::getVolume(uint8_t index)
+{
+    return SensorRegistry::getVolume(index);
+}
+
+/**
+ * Retrieves the Sensor Task (eq. for the Stack High-Water Mark).
+ *
+ * @return The Task Handle, or NULL if not started.
+ */
+TaskHandle_t SensorHandler::getTask()
+{
+    return sensorTask;
+}
@@ -0,0 +1,40 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#ifndef SENSORHANDLER_H
+#define SENSORHANDLER_H
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <OneWire.h>
+
+#include "SensorRegistry.h"
+
+
+class SensorHandler
+{
+private:
+    static void handleSensors(void* parameter);
+    static bool readADC(Sensor& sensor, float& raw);
+    static bool readADS1115(Sensor& sensor, float& raw);
+    static bool readDS18B20(Sensor& sensor, float& raw);
+    static void add(uint8_t type, JsonObjectConst config);
+    static void setupADC(JsonArrayConst points);
+    static uint32_t characterize(uint32_t counts);
+    static void setupTrim(Sensor& sensor, JsonArrayConst trim);
+    static int32_t compensate(Sensor& sensor, int32_t millivolts);
+
+public:
+    static void setup();
+    static uint8_t getCount();
+    static const char* getName(uint8_t index);
+    static const char* getType(uint8_t index);
+    static bool isValid(uint8_t index);
+    static float getValue(uint8_t index);
+    static float getLevel(uint8_t index);
+    static float getVolume(uint8_t index);
+    static TaskHandle_t getTask();
+};
+
+
+#endif //SENSORHANDLER_H
@@ -0,0 +1,245 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#include "SensorRegistry.h"
+#include <stdio.h>
+#include <string.h>
+
+#include "InternalConfig.h"
+
+// Store registered Sensors (Index 0 = built-in Tank Input).
+Sensor sensors[SENSOR_MAX];
+uint8_t sensorCount = 0;
+
+// Store next Sensor of the round-robin Sampling.
+uint8_t sensorNext = 0;
+
+// Store Drivers.
+SensorDrivers sensorDrivers = {};
+
+// Define Type Names (Index = SENSOR_*).
+const char* const sensorTypes[SENSOR_TYPES] = {"adc", "ads1115", "ds18b20"};
+
+/**
+ * Clears the Registry and sets the Drivers.
+ *
+ * @param drivers The Drivers.
+ */
+void SensorRegistry::begin(const SensorDrivers& drivers)
+{
+    sensorDrivers = drivers;
+    sensorCount = 0;
+    sensorNext = 0;
+}
+
+/**
+ * Looks up a Sensor Type by its Driver Name.
+ *
+ * @param name The Driver Name (adc, ads1115, ds18b20).
+ * @return The Type (SENSOR_*), or -1 if unknown.
+ */
+int8_t SensorRegistry::findType(const char* name)
+{
+    for (uint8_t i = 0; i < SENSOR_TYPES; i++)
+    {
+        if (strcmp(name, sensorTypes[i]) == 0)
+            return i;
+    }
+
+    return -1;
+}
+
+/**
+ * Adds a Sensor with neutral Calibration (no Scale, Offset, Trim or Level).
+ *
+ * @param type The Driver (SENSOR_*).
+ * @param name The Name, nullptr for the Driver Name.
+ * @return The new Sensor to configure, or nullptr if the Registry is full.
+ */
+Sensor* SensorRegistry::add(uint8_t type, const char* name)
+{
+    if (sensorCount >= SENSOR_MAX || type >= SENSOR_TYPES)
+        return nullptr;
+
+    Sensor& sensor = sensors[sensorCount++];
+
+    sensor = {};
+    sensor.type = type;
+    sensor.scale = 1.0f;
+    sensor.alpha = EMA_ALPHA;
+    sensor.trimGain = 65536;
+    sensor.tcGain = 65536;
+    sensor.tcTemp = INT16_MIN;
+
+    snprintf(sensor.name, sizeof(sensor.name), "%s", name != nullptr ? name : sensorTypes[type]);
+
+    return &sensor;
+}
+
+/**
+ * Samples the next Sensor of the round-robin.
+ *
+ * @return The Index of the sampled Sensor.
+ */
+uint8_t SensorRegistry::step()
+{
+    uint8_t index = sensorNext;
+
+    if (sensorCount == 0)
+        return 0;
+
+    sample(index);
+
+    sensorNext = (index + 1) % sensorCount;
+
+    return index;
+}
+
+/**
+ * Reads a Sensor via its Driver, applies the Calibration and the EMA Filter.
+ *
+ * @param index The Sensor Index.
+ * @return True if the Driver delivered a Value.
+ */
+bool SensorRegistry::sample(uint8_t index)
+{
+    if (index >= sensorCount)
+        return false;
+
+    Sensor& sensor = sensors[index];
+    bool (*read)(Sensor&, float&) = nullptr;
+    float raw;
+
+    switch (sensor.type)
+    {
+    case SENSOR_ADC:
+        read = sensorDrivers.readADC;
+        break;
+    case SENSOR_ADS1115:
+        read = sensorDrivers.readADS1115;
+        break;
+    case SENSOR_DS18B20:
+        read = sensorDrivers.readDS18B20;
+        break;
+    default:
+        break;
+    }
+
+    if (read == nullptr || !read(sensor, raw))
+        return false;
+
+    float value = raw * sensor.scale + sensor.offset;
+
+    // First Value initializes the Filter.
+    sensor.value = (sensor.valid ? (sensor.value * (1.0f - sensor.alpha)) + (value * sensor.alpha) : value);
+    sensor.valid = true;
+
+    return true;
+}
+
+/**
+ * Calculates the Time Slice per Sensor.
+ *
+ * The Interval is divided by the Number of Sensors, so every Sensor is
+ * sampled once per Interval and adding Sensors never lengthens a single Step.
+ *
+ * @param interval The Interval in which every Sensor is sampled once.
+ * @return The Slice (at least 1).
+ */
+uint32_t SensorRegistry::getSlice(uint32_t interval)
+{
+    uint32_t slice = sensorCount > 0 ? interval / sensorCount : interval;
+
+    return slice > 0 ? slice : 1;
+}
+
+/**
+ * Retrieves the Number of registered Sensors.
+ *
+ * @return The Number of Sensors.
+ */
+uint8_t SensorRegistry::getCount()
+{
+    return sensorCount;
+}
+
+/**
+ * Retrieves the configured Name of a Sensor.
+ *
+ * @param index The Sensor Index.
+ * @return The Name, or an empty String if the Index is invalid.
+ */
+const char* SensorRegistry::getName(uint8_t index)
+{
+    return (index < sensorCount ? sensors[index].name : "");
+}
+
+/**
+ * Retrieves the Driver Name of a Sensor (adc, ads1115, ds18b20).
+ *
+ * @param index The Sensor Index.
+ * @return The Driver Name, or an empty String if the Index is invalid.
+ */
+const char* SensorRegistry::getType(uint8_t index)
+{
+    return (index < sensorCount ? sensorTypes[sensors[index].type] : "");
+}
+
+/**
+ * Checks if a Sensor has delivered at least one Value.
+ *
+ * @param index The Sensor Index.
+ * @return True if the cached Value is valid.
+ */
+bool SensorRegistry::isValid(uint8_t index)
+{
+    return index < sensorCount && sensors[index].valid;
+}
+
+/**
+ * Retrieves the cached, calibrated and filtered Value of a Sensor.
+ *
+ * @param index The Sensor Index.
+ * @return The Value (V for ADC/ADS1115, °C for DS18B20), or `0` if invalid.
+ */
+float SensorRegistry::getValue(uint8_t index)
+{
+    return (isValid(index) ? sensors[index].value : 0.0f);
+}
+
+/**
+ * Maps the Value of a Sensor between its `min` and `max` to a Level.
+ *
+ * @param index The Sensor Index.
+ * @return The Level in % (0 to 100), or `0` if the Sensor has no Level Mapping.
+ */
+float SensorRegistry::getLevel(uint8_t index)
+{
+    if (index >= sensorCount || sensors[index].max <= sensors[index].min)
+        return 0.0f;
+
+    const Sensor& sensor = sensors[index];
+
+    float percent = (getValue(index) - sensor.min) / (sensor.max - sensor.min) * 100.0f;
+
+    // Limit to 0–100 %
+    if (percent < 0.0f) percent = 0.0f;
+    if (percent > 100.0f) percent = 100.0f;
+
+    return percent;
+}
+
+/**
+ * Calculates the Volume of the Tank monitored by a Sensor.
+ *
+ * @param index The Sensor Index.
+ * @return The Volume in L, or `0` if the Sensor has no Tank Volume.
+ */
+float SensorRegistry::getVolume(uint8_t index)
+{
+    if (index >= sensorCount)
+        return 0.0f;
+
+    return sensors[index].volume * (getLevel(index) / 100.0f);
+}
@@ -0,0 +1,94 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#ifndef SENSORREGISTRY_H
+#define SENSORREGISTRY_H
+#include <stdint.h>
+
+class OneWire;
+
+/**
+ * Define Sensor Types (Drivers).
+ */
+#define SENSOR_ADC 0
+#define SENSOR_ADS1115 1
+#define SENSOR_DS18B20 2
+#define SENSOR_TYPES 3
+
+/**
+ * Define Index of the built-in Tank Sensor.
+ */
+#define SENSOR_TANK 0
+
+/**
+ * Describes a registered Sensor with its Calibration and Filter State.
+ *
+ * value = raw * scale + offset, filtered by an EMA with `alpha`.
+ * ADC Inputs are linearized by the corrected eFuse Table, trimmed by two Points and
+ * compensated by `tc` (ppm/°C of the CPU Temperature) in Fixed Point (Q16).
+ * If `max` > `min`, the Value is mapped to a Level (%) and a Volume (L).
+ */
+struct Sensor
+{
+    uint8_t type;
+    uint8_t pin;
+    uint8_t address;
+    uint8_t channel;
+    float scale;
+    float offset;
+    float alpha;
+    float min;
+    float max;
+    float volume;
+    float value;
+    int32_t trimGain;
+    int32_t trimOffset;
+    int32_t tcGain;
+    int16_t tc;
+    int16_t tcTemp;
+    bool valid;
+    bool started;
+    OneWire* bus;
+    char name[12];
+};
+
+/**
+ * Define Drivers, one per Sensor Type (Hardware on the Device, Fakes in the
+ * native Tests). A Driver returns false if no new Value is available.
+ */
+struct SensorDrivers
+{
+    bool (*readADC)(Sensor& sensor, float& raw);
+    bool (*readADS1115)(Sensor& sensor, float& raw);
+    bool (*readDS18B20)(Sensor& sensor, float& raw);
+};
+
+
+/**
+ * Holds the registered Sensors, samples them round-robin via their Driver
+ * and applies Calibration, Filter and Level Mapping.
+ *
+ * Free of Arduino Dependencies, so the Registry runs with fake Drivers in the
+ * native Tests.
+ */
+class SensorRegistry
+{
+public:
+    static void begin(const SensorDrivers& drivers);
+    static int8_t findType(const char* name);
+    static Sensor* add(uint8_t type, const char* name);
+    static uint8_t step();
+    static bool sample(uint8_t index);
+    static uint32_t getSlice(uint32_t interval);
+    static uint8_t getCount();
+    static const char* getName(uint8_t index);
+    static const char* getType(uint8_t index);
+    static bool isValid(uint8_t index);
+    static float getValue(uint8_t index);
+    static float getLevel(uint8_t index);
+    static float getVolume(uint8_t index);
+};
+
+
+#endif //SENSORREGISTRY_H
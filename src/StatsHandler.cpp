@@ -0,0 +1,288 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#include "StatsHandler.h"
+#include <ArduinoJson.h>
+#include <LittleFS.h>
+#include <esp_timer.h>
+
+#include "FileHandler.h"
+#include "InternalConfig.h"
+#include "RelaisHandler.h"
+#include "StatsStore.h"
+
+// Store Counters (accumulated in RAM, flushed every STATS_INTERVAL).
+StatsRecord stats = {};
+
+// Store Start of the current Run and the last accounted Time (esp_timer µs, 0 = off).
+int64_t statsRunStart[RELAIS_COUNT];
+int64_t statsAccounted[RELAIS_COUNT];
+
+// Store configured Power per Channel (W).
+uint16_t statsPower[RELAIS_COUNT];
+
+// Store Flush State.
+bool statsDirty = false;
+unsigned long statsMillis = 0;
+
+// Guard Counters shared with the Timer and Web Tasks.
+portMUX_TYPE statsMux = portMUX_INITIALIZER_UNLOCKED;
+
+/**
+ * Loads the Pump Power from the Config and restores the newest valid Slot.
+ *
+ * Config Format:
+ * "relais": {
+ *   "power": [550, 0]  => Power per Channel in W (0 = no Energy Accounting).
+ * }
+ */
+void StatsHandler::setup()
+{
+    JsonDocument config = FileHandler::getConfig();
+
+    for (uint8_t i = 0; i < RELAIS_COUNT; i++)
+    {
+        statsPower[i] = config["relais"]["power"][i] | 0;
+    }
+
+    if (!load())
+    {
+        stats = {};
+        stats.magic = STATS_MAGIC;
+        stats.count = RELAIS_COUNT;
+    }
+
+    statsMillis = millis();
+}
+
+/**
+ * Flushes the Counters every STATS_INTERVAL, but only if they have changed.
+ * Toggles never write to the Flash directly.
+ */
+void StatsHandler::loop()
+{
+    if (millis() - statsMillis < STATS_INTERVAL)
+        return;
+
+    statsMillis = millis();
+
+    bool running = false;
+
+    for (uint8_t i = 0; i < RELAIS_COUNT; i++)
+        running |= statsRunStart[i] != 0;
+
+    if (statsDirty || running)
+        flush();
+}
+
+/**
+ * Restores the newest intact Slot (see `StatsStore::load()`).
+ *
+ * @return True if a valid Slot has been found.
+ */
+bool StatsHandler::load()
+{
+    bool found = StatsStore::load(getFiles(), &stats);
+
+#if DEBUG == true
+    Serial.printf("Stats %s (seq %u)\n", found ? "loaded" : "empty", stats.sequence);
+#endif
+
+    return found;
+}
+
+/**
+ * Retrieves the LittleFS File Operations for the StatsStore.
+ *
+ * @return The File Operations.
+ */
+StatsFiles StatsHandler::getFiles()
+{
+    StatsFiles files;
+
+    files.read = [](const char* path, uint8_t* buffer, size_t size) -> size_t
+    {
+        File file = LittleFS.open(path, "r");
+
+        if (!file)
+            return 0;
+
+        size_t length = file.read(buffer, size);
+        file.close();
+
+        return length;
+    };
+
+    files.write = [](const char* path, const uint8_t* data, size_t length)
+    {
+        return FileHandler::saveFile(path, data, length);
+    };
+
+    return files;
+}
+
+/**
+ * Writes the Counters into the next Slot.
+ *
+ * Running Channels are accounted up to now, so a Power Loss loses at most
+ * STATS_INTERVAL of Run Time. The Slot is picked by `StatsStore::store()`.
+ *
+ * @return True if the Slot has been written.
+ */
+bool StatsHandler::flush()
+{
+    int64_t now = esp_timer_get_time();
+    StatsRecord record;
+
+    portENTER_CRITICAL(&statsMux);
+    for (uint8_t i = 0; i < RELAIS_COUNT; i++)
+        accumulate(i, now);
+
+    stats.sequence++;
+    record = stats;
+    statsDirty = false;
+    portEXIT_CRITICAL(&statsMux);
+
+    bool saved = StatsStore::store(getFiles(), &record);
+
+#if DEBUG == true
+    Serial.printf("Stats flushed (seq %u): %s\n", record.sequence, saved ? "ok" : "failed");
+#endif
+
+    return saved;
+}
+
+/**
+ * Adds the Run Time since the last Accounting to the Counters.
+ * Must be called inside `statsMux`.
+ *
+ * @param index The Channel Index (0-based).
+ * @param now The current Time (esp_timer µs).
+ */
+void StatsHandler::accumulate(uint8_t index, int64_t now)
+{
+    if (statsRunStart[index] == 0)
+        return;
+
+    StatsChannel& channel = stats.channels[index];
+
+    uint64_t elapsed = (now - statsAccounted[index]) / 1000;
+    uint64_t run = (now - statsRunStart[index]) / 1000;
+
+    channel.onTime += elapsed;
+    channel.energy += (uint64_t)statsPower[index] * elapsed;
+
+    if (run > channel.longest)
+        channel.longest = (run > UINT32_MAX ? UINT32_MAX : run);
+
+    // Keep the Remainder, so no Run Time gets lost by the Division.
+    statsAccounted[index] += elapsed * 1000;
+}
+
+/**
+ * Counts a Start of a Channel, called by the RelaisHandler.
+ *
+ * @param index The Channel Index (0-based).
+ */
+void StatsHandler::onStart(uint8_t index)
+{
+    int64_t now = esp_timer_get_time();
+
+    portENTER_CRITICAL(&statsMux);
+    if (statsRunStart[index] == 0)
+    {
+        statsRunStart[index] = now;
+        statsAccounted[index] = now;
+        stats.channels[index].starts++;
+        statsDirty = true;
+    }
+    portEXIT_CRITICAL(&statsMux);
+}
+
+/**
+ * Accounts the finished Run of a Channel, called by the RelaisHandler.
+ *
+ * @param index The Channel Index (0-based).
+ */
+void StatsHandler::onStop(uint8_t index)
+{
+    int64_t now = esp_timer_get_time();
+
+    portENTER_CRITICAL(&statsMux);
+    accumulate(index, now);
+    statsRunStart[index] = 0;
+    statsDirty = true;
+    portEXIT_CRITICAL(&statsMux);
+}
+
+/**
+ * Retrieves the total On-Time of a Channel including the current Run.
+ *
+ * @param channel The relay channel (1 to RelaisHandler::getCount()).
+ * @return The On-Time in ms, or `0` if the Channel is invalid.
+ */
+uint64_t StatsHandler::getOnTime(int channel)
+{
+    if (!RelaisHandler::isValid(channel))
+        return 0;
+
+    portENTER_CRITICAL(&statsMux);
+    accumulate(channel - 1, esp_timer_get_time());
+    uint64_t onTime = stats.channels[channel - 1].onTime;
+    portEXIT_CRITICAL(&statsMux);
+
+    return onTime;
+}
+
+/**
+ * Retrieves the Number of Starts of a Channel.
+ *
+ * @param channel The relay channel (1 to RelaisHandler::getCount()).
+ * @return The Number of Starts, or `0` if the Channel is invalid.
+ */
+uint32_t StatsHandler::getStarts(int channel)
+{
+    if (!RelaisHandler::isValid(channel))
+        return 0;
+
+    return stats.channels[channel - 1].starts;
+}
+
+/**
+ * Retrieves the longest Run of a Channel including the current Run.
+ *
+ * @param channel The relay channel (1 to RelaisHandler::getCount()).
+ * @return The longest Run in ms, or `0` if the Channel is invalid.
+ */
+uint32_t StatsHandler::getLongest(int channel)
+{
+    if (!RelaisHandler::isValid(channel))
+        return 0;
+
+    portENTER_CRITICAL(&statsMux);
+    accumulate(channel - 1, esp_timer_get_time());
+    uint32_t longest = stats.channels[channel - 1].longest;
+    portEXIT_CRITICAL(&statsMux);
+
+    return longest;
+}
+
+/**
+ * Retrieves the estimated Energy of a Channel from its configured Power.
+ *
+ * @param channel The relay channel (1 to RelaisHandler::getCount()).
+ * @return The Energy in Wh, or `0` if the Channel is invalid.
+ */
+float StatsHandler::getEnergy(int channel)
+{
+    if (!RelaisHandler::isValid(channel))
+        return 0;
+
+    portENTER_CRITICAL(&statsMux);
+    accumulate(channel - 1, esp_timer_get_time());
+    uint64_t energy = stats.channels[channel - 1].energy;
+    portEXIT_CRITICAL(&statsMux);
+
+    return energy / 3600000.0f;
+}
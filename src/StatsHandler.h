@@ -0,0 +1,32 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#ifndef STATSHANDLER_H
+#define STATSHANDLER_H
+#include <Arduino.h>
+
+#include "StatsStore.h"
+
+
+class StatsHandler
+{
+private:
+    static bool load();
+    static StatsFiles getFiles();
+    static void accumulate(uint8_t index, int64_t now);
+
+public:
+    static void setup();
+    static void loop();
+    static bool flush();
+    static void onStart(uint8_t index);
+    static void onStop(uint8_t index);
+    static uint64_t getOnTime(int channel);
+    static uint32_t getStarts(int channel);
+    static uint32_t getLongest(int channel);
+    static float getEnergy(int channel);
+};
+
+
+#endif //STATSHANDLER_H
@@ -0,0 +1,90 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#include "StatsStore.h"
+#include <stdio.h>
+
+#include "ConfigStore.h"
+
+/**
+ * Restores the Record with the highest Sequence of all Slots.
+ *
+ * A Slot torn by a Power Loss fails the CRC and is skipped, so the previous
+ * Slot is used instead.
+ *
+ * @param files The File Operations.
+ * @param stats Receives the newest valid Record, untouched if none is found.
+ * @return True if a valid Slot has been found.
+ */
+bool StatsStore::load(const StatsFiles& files, StatsRecord* stats)
+{
+    bool found = false;
+
+    for (uint8_t slot = 0; slot < STATS_SLOTS; slot++)
+    {
+        char path[16];
+        snprintf(path, sizeof(path), "/stats%u.bin", slot);
+
+        StatsRecord record = {};
+        size_t length = files.read(path, (uint8_t*)&record, sizeof(record));
+
+        if (!checkRecord(record, length))
+            continue;
+
+        if (!found || record.sequence > stats->sequence)
+        {
+            *stats = record;
+            found = true;
+        }
+    }
+
+    // Channels added to the Table since the Slot was written start at zero.
+    if (found)
+        stats->count = RELAIS_COUNT;
+
+    return found;
+}
+
+/**
+ * Writes a Record into the Slot of its Sequence.
+ *
+ * The Slots are written round-robin, spreading the Writes and always keeping
+ * the previous Record intact.
+ *
+ * @param files The File Operations.
+ * @param record The Record, its CRC is filled in.
+ * @return True if the Slot has been written.
+ */
+bool StatsStore::store(const StatsFiles& files, StatsRecord* record)
+{
+    record->crc = 0;
+    record->crc = ConfigStore::crc32((const uint8_t*)record, sizeof(StatsRecord));
+
+    char path[16];
+    snprintf(path, sizeof(path), "/stats%u.bin", (unsigned)(record->sequence % STATS_SLOTS));
+
+    return files.write(path, (const uint8_t*)record, sizeof(StatsRecord));
+}
+
+/**
+ * Checks Magic, Channel Count, Length and CRC32 of a Slot.
+ *
+ * @param record The Slot Content, Bytes behind `length` must be zero.
+ * @param length The Number of Bytes read from the Slot.
+ * @return True if the Record is intact.
+ */
+bool StatsStore::checkRecord(const StatsRecord& record, size_t length)
+{
+    // Header and at least one Channel (Table may have changed).
+    size_t header = offsetof(StatsRecord, channels);
+
+    if (length < header || record.magic != STATS_MAGIC || record.count == 0 || record.count > RELAIS_COUNT ||
+        length != header + record.count * sizeof(StatsChannel))
+        return false;
+
+    StatsRecord copy = record;
+    copy.crc = 0;
+
+    return record.crc == ConfigStore::crc32((const uint8_t*)&copy, length);
+}
@@ -0,0 +1,64 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#ifndef STATSSTORE_H
+#define STATSSTORE_H
+#include <stddef.h>
+#include <stdint.h>
+
+#include "InternalConfig.h"
+#include "RelaisArbiter.h"
+
+/**
+ * Define persisted Counters of a Channel.
+ */
+struct StatsChannel
+{
+    uint64_t onTime; // ms
+    uint64_t energy; // mJ (W * ms)
+    uint32_t starts;
+    uint32_t longest; // ms
+};
+
+/**
+ * Define Slot File (/statsN.bin), CRC32 covers the Record with crc = 0.
+ */
+struct StatsRecord
+{
+    uint32_t magic;
+    uint32_t sequence;
+    uint16_t count;
+    uint16_t reserved;
+    uint32_t crc;
+    StatsChannel channels[RELAIS_COUNT];
+};
+
+/**
+ * Define File Operations used by the StatsStore (LittleFS on the Device, RAM
+ * in the native Tests). `read` returns the Number of Bytes read, 0 if the
+ * File is missing.
+ */
+struct StatsFiles
+{
+    size_t (*read)(const char* path, uint8_t* buffer, size_t size);
+    bool (*write)(const char* path, const uint8_t* data, size_t length);
+};
+
+
+/**
+ * Rotates the Relais Statistics over STATS_SLOTS Slot Files and restores the
+ * newest intact one, so a Power Loss costs at most one Flush Interval.
+ *
+ * Free of Arduino Dependencies, the File Operations are passed in.
+ */
+class StatsStore
+{
+public:
+    static bool load(const StatsFiles& files, StatsRecord* stats);
+    static bool store(const StatsFiles& files, StatsRecord* record);
+    static bool checkRecord(const StatsRecord& record, size_t length);
+};
+
+
+#endif //STATSSTORE_H
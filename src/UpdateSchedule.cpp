@@ -0,0 +1,214 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#include "UpdateSchedule.h"
+#include <stdio.h>
+#include <string.h>
+
+#include "InternalConfig.h"
+
+// Store Check Interval (ms) and the Time of the last Manifest Check.
+unsigned long scheduleInterval = UPDATE_TTL;
+unsigned long scheduleChecked = 0;
+bool scheduleValid = false;
+
+// Store forced Check (Refresh ahead of the Interval).
+volatile bool scheduleRequested = false;
+
+// Store Manifest Validators for conditional Requests.
+char scheduleETag[72] = "";
+char scheduleModified[32] = "";
+
+// Store last failed Version, its Failure Time and the Number of Failures in a Row.
+char failedVersion[16] = "";
+unsigned long failedMillis = 0;
+uint8_t failedCount = 0;
+
+/**
+ * Resets the Schedule, the next Call of `isCheckDue()` starts a Check.
+ *
+ * @param interval The Check Interval (ms).
+ */
+void UpdateSchedule::reset(unsigned long interval)
+{
+    scheduleInterval = interval;
+    scheduleChecked = 0;
+    scheduleValid = false;
+    scheduleRequested = false;
+
+    scheduleETag[0] = '\0';
+    scheduleModified[0] = '\0';
+
+    failedVersion[0] = '\0';
+    failedMillis = 0;
+    failedCount = 0;
+}
+
+/**
+ * Requests a Manifest Check ahead of the Interval.
+ */
+void UpdateSchedule::requestCheck()
+{
+    scheduleRequested = true;
+}
+
+/**
+ * Checks whether the cached Manifest Result has to be refreshed.
+ *
+ * @param now The current Time (ms).
+ * @return True if a Check was requested, none was made yet or the Interval has expired.
+ */
+bool UpdateSchedule::isCheckDue(unsigned long now)
+{
+    return scheduleRequested || !scheduleValid || now - scheduleChecked >= scheduleInterval;
+}
+
+/**
+ * Marks the Manifest as checked, independent of the Server Response.
+ *
+ * A failed Request is not retried before the Interval has expired.
+ *
+ * @param now The current Time (ms).
+ */
+void UpdateSchedule::checked(unsigned long now)
+{
+    scheduleRequested = false;
+    scheduleValid = true;
+    scheduleChecked = now;
+}
+
+/**
+ * Stores the Validators of a 200 Response, sent as `If-None-Match` and
+ * `If-Modified-Since` with the next Request.
+ *
+ * @param etag The `ETag` Header (empty if missing).
+ * @param modified The `Last-Modified` Header (empty if missing).
+ */
+void UpdateSchedule::storeValidators(const char* etag, const char* modified)
+{
+    // Drop Validators which do not fit, an unconditional Request is always correct.
+    if (snprintf(scheduleETag, sizeof(scheduleETag), "%s", etag) >= (int) sizeof(scheduleETag))
+        scheduleETag[0] = '\0';
+
+    if (snprintf(scheduleModified, sizeof(scheduleModified), "%s", modified) >= (int) sizeof(scheduleModified))
+        scheduleModified[0] = '\0';
+}
+
+/**
+ * Retrieves the `ETag` of the cached Manifest.
+ *
+ * @return The `ETag` or an empty String.
+ */
+const char* UpdateSchedule::getETag()
+{
+    return scheduleETag;
+}
+
+/**
+ * Retrieves the `Last-Modified` Date of the cached Manifest.
+ *
+ * @return The Date or an empty String.
+ */
+const char* UpdateSchedule::getModified()
+{
+    return scheduleModified;
+}
+
+/**
+ * Checks whether an automatic Update to the given Version may run.
+ *
+ * A Version which failed before is retried with exponential Backoff
+ * (`getRetryDelay()`), a new Version is installed immediately.
+ *
+ * @param version The available Version (empty if none).
+ * @param now The current Time (ms).
+ * @return True if the Update should be installed now.
+ */
+bool UpdateSchedule::isInstallDue(const char* version, unsigned long now)
+{
+    if (version == nullptr || version[0] == '\0')
+        return false;
+
+    if (!hasFailed(version))
+        return true;
+
+    return now - failedMillis >= getRetryDelay();
+}
+
+/**
+ * Records a failed Update, repeated Failures of the same Version double the
+ * Retry Delay.
+ *
+ * @param version The Version which failed.
+ * @param now The current Time (ms).
+ */
+void UpdateSchedule::failed(const char* version, unsigned long now)
+{
+    if (hasFailed(version))
+    {
+        if (failedCount < 255)
+            failedCount++;
+    }
+    else
+    {
+        snprintf(failedVersion, sizeof(failedVersion), "%s", version);
+        failedCount = 1;
+    }
+
+    failedMillis = now;
+}
+
+/**
+ * Checks whether the given Version failed before.
+ *
+ * @param version The Version to check.
+ * @return True if the last failed Update was this Version.
+ */
+bool UpdateSchedule::hasFailed(const char* version)
+{
+    return failedCount > 0 && strcmp(failedVersion, version) == 0;
+}
+
+/**
+ * Retrieves the Delay before the failed Version is retried.
+ *
+ * @return UPDATE_RETRY_MIN doubled for every further Failure, at most UPDATE_RETRY_MAX (ms).
+ */
+unsigned long UpdateSchedule::getRetryDelay()
+{
+    unsigned long delay = UPDATE_RETRY_MIN;
+
+    for (uint8_t i = 1; i < failedCount && delay < UPDATE_RETRY_MAX; i++)
+    {
+        delay *= 2;
+    }
+
+    return delay < UPDATE_RETRY_MAX ? delay : UPDATE_RETRY_MAX;
+}
+
+/**
+ * Compares two semantic Versions (major.minor.patch).
+ *
+ * @param version The Version to check.
+ * @param current The Version to compare against.
+ * @return True if `version` is newer than `current`; otherwise, false.
+ */
+bool UpdateSchedule::isNewer(const char* version, const char* current)
+{
+    int a[3] = {0, 0, 0};
+    int b[3] = {0, 0, 0};
+
+    if (sscanf(version, "%d.%d.%d", &a[0], &a[1], &a[2]) < 1)
+        return false;
+
+    sscanf(current, "%d.%d.%d", &b[0], &b[1], &b[2]);
+
+    for (int i = 0; i < 3; i++)
+    {
+        if (a[i] != b[i])
+            return a[i] > b[i];
+    }
+
+    return false;
+}
@@ -0,0 +1,35 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#ifndef UPDATESCHEDULE_H
+#define UPDATESCHEDULE_H
+#include <stddef.h>
+#include <stdint.h>
+
+
+/**
+ * Decides when the Update Task checks the Manifest and installs an Update.
+ *
+ * Free of Arduino Dependencies, all Times are passed in (ms since Boot) so
+ * the Schedule runs unchanged in the native Tests.
+ */
+class UpdateSchedule
+{
+public:
+    static void reset(unsigned long interval);
+    static void requestCheck();
+    static bool isCheckDue(unsigned long now);
+    static void checked(unsigned long now);
+    static void storeValidators(const char* etag, const char* modified);
+    static const char* getETag();
+    static const char* getModified();
+    static bool isInstallDue(const char* version, unsigned long now);
+    static void failed(const char* version, unsigned long now);
+    static bool hasFailed(const char* version);
+    static unsigned long getRetryDelay();
+    static bool isNewer(const char* version, const char* current);
+};
+
+
+#endif //UPDATESCHEDULE_H
@@ -11,16 +11,39 @@
 #include <WiFi.h>
 #include <lwip/sockets.h>
 
+#include "BootHandler.h"
+#include "CrashHandler.h"
 #include "DeviceHandler.h"
 #include "ESPAsyncWebServer.h"
 #include "FileHandler.h"
 #include "MQTTHandler.h"
+#include "MemoryHandler.h"
+#include "MetricsHandler.h"
 #include "OTAHandler.h"
+#include "RelaisHandler.h"
+#include "SensorHandler.h"
+#include "StatsHandler.h"
 #include "WiFiHandler.h"
 
 // Create AsyncWebServer object on port 80
 AsyncWebServer server(80);
 
+// Define Captive Portal Probe URLs (Android, Apple, Windows, Firefox).
+const char* const portalProbes[] = {
+    "/generate_204", "/gen_204", "/hotspot-detect.html", "/library/test/success.html",
+    "/connecttest.txt", "/ncsi.txt", "/redirect", "/canonical.html", "/success.txt"
+};
+
+// Define Provisioning Page (served from Flash instead of the full UI).
+const char setupPage[] PROGMEM = R"(<!DOCTYPE html><html><head><meta charset="utf-8">
+<meta name="viewport" content="width=device-width,initial-scale=1"><title>BYTELEVEL Setup</title>
+<style>body{font-family:sans-serif;max-width:320px;margin:40px auto;padding:0 16px}
+input,button{width:100%;box-sizing:border-box;padding:10px;margin:6px 0;font-size:16px}</style></head>
+<body><h2>BYTELEVEL</h2><p>Connect to your Wi-Fi:</p>
+<form method="post" action="/setup"><input name="ssid" placeholder="SSID" required maxlength="32">
+<input name="password" type="password" placeholder="Password" maxlength="64">
+<button>Save &amp; Restart</button></form><p><a href="/">Full Interface</a></p></body></html>)";
+
 void WebHandler::setup()
 {
     // Route for root / web page
@@ -43,9 +66,29 @@ void WebHandler::setup()
     });
 
 
-    // Add 404 Handler.
+    // Add Captive Portal and Provisioning Page.
+    setupPortal();
+
+    // Add Core Dump Download.
+    server.on("/coredump", HTTP_GET, [](AsyncWebServerRequest* request)
+    {
+        if (needAuth(request))
+            CrashHandler::streamDump(request);
+    });
+
+    // Add Prometheus / OpenMetrics Endpoint.
+    server.on("/metrics", HTTP_GET, [](AsyncWebServerRequest* request)
+    {
+        if (needAuth(request))
+            MetricsHandler::handle(request);
+    });
+
+    // Add 404 Handler, foreign Hosts are redirected while the AP is running.
     server.onNotFound([](AsyncWebServerRequest* request)
     {
+        if (redirectPortal(request))
+            return;
+
         request->send(404, "text/plain", "Page not found");
     });
 
@@ -76,6 +119,105 @@ void WebHandler::loop()
 {
 }
 
+/**
+ * Registers the Captive Portal Routes.
+ *
+ * Connectivity Probes of Phones and Laptops are answered instantly with a
+ * Redirect to `/setup` while the AP is running, so the OS opens the Portal
+ * instead of retrying. `/setup` is a tiny Page from Flash to enter the
+ * Wi-Fi Credentials without loading the full Interface.
+ */
+void WebHandler::setupPortal()
+{
+    for (const char* probe : portalProbes)
+    {
+        server.on(probe, HTTP_GET, [](AsyncWebServerRequest* request)
+        {
+            if (redirectPortal(request))
+                return;
+
+            // Connected Station, answer like the Internet would.
+            request->send(204);
+        });
+    }
+
+    server.on("/setup", HTTP_GET, [](AsyncWebServerRequest* request)
+    {
+        if (needAuth(request))
+            request->send(200, "text/html", (const uint8_t*)setupPage, strlen(setupPage));
+    });
+
+    server.on("/setup", HTTP_POST, [](AsyncWebServerRequest* request)
+    {
+        if (needAuth(request))
+            handleProvisioning(request);
+    });
+}
+
+/**
+ * Redirects a Request of an AP Client to the Provisioning Page, unless it was
+ * addressed to the Device IP itself.
+ *
+ * @param request Pointer to the asynchronous web server request.
+ * @return True if the Request has been redirected.
+ */
+bool WebHandler::redirectPortal(AsyncWebServerRequest* request)
+{
+    if (!WiFiHandler::isAPActive() || request->client()->localIP() != WiFi.softAPIP())
+        return false;
+
+    String ip = WiFi.softAPIP().toString();
+
+    if (request->host() == ip)
+        return false;
+
+    request->redirect("http://" + ip + "/setup");
+
+    return true;
+}
+
+/**
+ * Stores the Wi-Fi Credentials from the Provisioning Form and restarts.
+ *
+ * @param request Pointer to the asynchronous web server request.
+ */
+void WebHandler::handleProvisioning(AsyncWebServerRequest* request)
+{
+    const AsyncWebParameter* ssid = request->getParam("ssid", true);
+    const AsyncWebParameter* password = request->getParam("password", true);
+
+    if (ssid == nullptr || ssid->value().isEmpty() || ssid->value().length() > 32)
+    {
+        request->send(400, "text/plain", "Invalid SSID");
+        return;
+    }
+
+    JsonDocument config = FileHandler::getConfig();
+
+    config["wifi"]["client"]["ssid"] = ssid->value();
+    config["wifi"]["client"]["password"] = password != nullptr ? password->value() : "";
+
+    FileHandler::saveConfig(config.as<JsonObject>());
+
+    if (!FileHandler::storeConfig())
+    {
+        request->send(500, "text/plain", "Save failed");
+        return;
+    }
+
+    request->send(200, "text/html", "<p>Saved. Restarting&hellip;</p>");
+
+    // Keep Run Hours since the last Flush.
+    StatsHandler::flush();
+
+    // Wait for 500ms.
+    delay(500);
+
+    // Restart ESP.
+    CrashHandler::markRestart(RESTART_CONFIG);
+    ESP.restart();
+}
+
 /**
  * Determines whether authentication is needed for the incoming request and enforces it if required.
  *
@@ -152,21 +294,29 @@ void WebHandler::handleAPICall(AsyncWebServerRequest* request, JsonVariant json)
     if (type == "relais")
     {
         // Check if Relais Query Contains a channel (int) and state (bool).
-        if (json["channel"].is<int>() && json["state"].is<bool>())
+        if (json["channel"].is<int>() && json["state"].is<bool>() && RelaisHandler::isValid(json["channel"].as<int>()))
         {
-            // Set Relais State.
-            DeviceHandler::setRelais(json["channel"].as<int>(), json["state"].as<bool>());
+            // Set Relais State, rejected if an interlocked Channel is on.
+            if (!RelaisHandler::set(json["channel"].as<int>(), json["state"].as<bool>(), RELAIS_MANUAL))
+            {
+                sendResponse(request, 409, R"({"type":"error","message":"Interlocked"})");
+                return;
+            }
 
             // Auto Disable Relais if set.
             if (json["duration"].is<int>())
             {
                 // Switch off Relais after the given Duration.
-                DeviceHandler::setRelaisDuration(json["channel"].as<int>(), json["duration"].as<int>());
+                RelaisHandler::setDuration(json["channel"].as<int>(), json["duration"].as<int>());
             }
 
             // Send 200 Response.
             sendOK(request);
         }
+        else
+        {
+            sendInvalid(request);
+        }
     }
     else if (type == "status")
     {
@@ -176,13 +326,28 @@ void WebHandler::handleAPICall(AsyncWebServerRequest* request, JsonVariant json)
         doc["type"] = "success";
 
         // Add Channel States to Array.
-        doc["channels"][0] = DeviceHandler::getState(1);
-        doc["channels"][1] = DeviceHandler::getState(2);
+        for (uint8_t i = 0; i < RelaisHandler::getCount(); i++)
+        {
+            doc["channels"][i] = RelaisHandler::getState(i + 1);
+        }
 
 
         // Set ADC Voltage.
         doc["adc"] = DeviceHandler::getADCValueCached();
 
+        // Add registered Sensors (Index 0 = Tank Input).
+        for (uint8_t i = 0; i < SensorHandler::getCount(); i++)
+        {
+            JsonObject sensor = doc["sensors"].add<JsonObject>();
+
+            sensor["name"] = SensorHandler::getName(i);
+            sensor["type"] = SensorHandler::getType(i);
+            sensor["valid"] = SensorHandler::isValid(i);
+            sensor["value"] = DeviceHandler::roundToTwoDecimals(SensorHandler::getValue(i));
+            sensor["level"] = DeviceHandler::roundToTwoDecimals(SensorHandler::getLevel(i));
+            sensor["volume"] = DeviceHandler::roundToTwoDecimals(SensorHandler::getVolume(i));
+        }
+
         // Set Current (eq. 4-20mA).
         doc["current"] = DeviceHandler::getCurrentCached();
 
@@ -204,9 +369,121 @@ void WebHandler::handleAPICall(AsyncWebServerRequest* request, JsonVariant json)
         // Set MQTT State.
         doc["mqtt"] = MQTTHandler::isConnected();
 
+        // Set Boot Timing (ms since Boot, reached Phases only) and Wi-Fi State.
+        for (uint8_t i = 0; i < BOOT_PHASES; i++)
+        {
+            if (BootHandler::getTime(i) != 0)
+                doc["boot"][BootHandler::getName(i)] = roundf(BootHandler::getTime(i) / 100.0f) / 10.0f;
+        }
+
+        doc["wifi"] = WiFiHandler::getState();
+
+        // Set Reset Reason and Crash Counter.
+        doc["reset"] = CrashHandler::getResetReason();
+        doc["crashes"] = CrashHandler::getCrashCount();
+
+        // Set Memory (Bytes) and Stack High-Water Marks.
+        MemorySample memory = MemoryHandler::getSample(0);
+
+        doc["memory"]["free"] = memory.free;
+        doc["memory"]["min"] = memory.minimum;
+        doc["memory"]["largest"] = memory.largest;
+        doc["memory"]["fragmentation"] = MemoryHandler::getFragmentation();
+        doc["memory"]["stack"]["loop"] = memory.loopStack;
+        doc["memory"]["stack"]["tcp"] = memory.tcpStack;
+        doc["memory"]["stack"]["sensor"] = memory.sensorStack;
+
+        // Set History (newest first: Uptime in s, free Heap, largest Block).
+        JsonArray history = doc["memory"]["history"].to<JsonArray>();
+
+        for (uint8_t i = 0; i < MemoryHandler::getCount(); i++)
+        {
+            MemorySample sample = MemoryHandler::getSample(i);
+            JsonArray entry = history.add<JsonArray>();
+
+            entry.add(sample.time);
+            entry.add(sample.free);
+            entry.add(sample.largest);
+        }
+
+        // Set Wi-Fi Connect Statistics (ms).
+        doc["connect"]["count"] = WiFiHandler::getConnects();
+        doc["connect"]["fast"] = WiFiHandler::getFastConnects();
+        doc["connect"]["retries"] = WiFiHandler::getRetries();
+        doc["connect"]["last"] = WiFiHandler::getLastConnectDuration();
+        doc["connect"]["average"] = WiFiHandler::getAverageConnectDuration();
+        doc["connect"]["roams"] = WiFiHandler::getRoams();
+
         // Set Runtime.
         doc["up"] = millis() / 1000;
 
+        // Set Display Transfer of last Frame.
+        doc["display"]["bytes"] = DeviceHandler::getDisplayBytes();
+        doc["display"]["us"] = DeviceHandler::getDisplayMicros();
+
+        // Set Update State and Progress.
+        doc["ota"]["state"] = OTAHandler::getState();
+        doc["ota"]["progress"] = OTAHandler::getProgress();
+
+        String response;
+        serializeJson(doc, response);
+        sendResponse(request, 200, response.c_str());
+    }
+    else if (type == "stats")
+    {
+        JsonDocument doc;
+
+        // Set Response Type.
+        doc["type"] = "success";
+
+        // Add Counters per Channel.
+        for (uint8_t i = 0; i < RelaisHandler::getCount(); i++)
+        {
+            JsonObject channel = doc["channels"].add<JsonObject>();
+
+            channel["hours"] = StatsHandler::getOnTime(i + 1) / 3600000.0;
+            channel["starts"] = StatsHandler::getStarts(i + 1);
+            channel["longest"] = StatsHandler::getLongest(i + 1) / 1000;
+            channel["energy"] = StatsHandler::getEnergy(i + 1) / 1000.0f;
+        }
+
+        String response;
+        serializeJson(doc, response);
+        sendResponse(request, 200, response.c_str());
+    }
+    else if (type == "crash")
+    {
+        // Erase the Core Dump if requested.
+        if (json["erase"].as<bool>() && !CrashHandler::eraseDump())
+        {
+            sendResponse(request, 500, R"({"type":"error","message":"Erase failed"})");
+            return;
+        }
+
+        JsonDocument doc;
+
+        // Set Response Type.
+        doc["type"] = "success";
+
+        // Set Reset Reason and Counters.
+        doc["reset"] = CrashHandler::getResetReason();
+        doc["boots"] = CrashHandler::getBootCount();
+        doc["crashes"] = CrashHandler::getCrashCount();
+
+        // Set Core Dump Summary (Download via GET /coredump).
+        doc["dump"]["present"] = CrashHandler::hasDump();
+
+        if (CrashHandler::hasDump())
+        {
+            char pc[11];
+            snprintf(pc, sizeof(pc), "0x%08x", CrashHandler::getDumpPC());
+
+            doc["dump"]["size"] = CrashHandler::getDumpSize();
+            doc["dump"]["task"] = CrashHandler::getDumpTask();
+            doc["dump"]["pc"] = pc;
+            doc["dump"]["sha"] = CrashHandler::getDumpSHA();
+        }
+
         String response;
         serializeJson(doc, response);
         sendResponse(request, 200, response.c_str());
@@ -224,8 +501,13 @@ void WebHandler::handleAPICall(AsyncWebServerRequest* request, JsonVariant json)
         // Add Matter manuel Pairing Code.
         //doc["matter"] = MatterHandler::getPairingCode();
 
+        // Check Manifest in Background, the cached Result is returned.
+        if (json["refresh"] | false)
+            OTAHandler::refresh();
+
         // Add Update Info.
         doc["update"] = OTAHandler::hasUpdate();
+        doc["latest"] = OTAHandler::getLatestVersion();
 
         // Set Response Type.
         doc["type"] = "success";
@@ -238,15 +520,16 @@ void WebHandler::handleAPICall(AsyncWebServerRequest* request, JsonVariant json)
     {
         if (json["config"].is<JsonObject>())
         {
-            String response;
-            serializeJson(json["config"], response);
-
-            // Save File to Flash.
-            FileHandler::saveFile("/config.json", response);
-
             // Save Config.
             FileHandler::saveConfig(json["config"]);
 
+            // Save File to Flash (binary + JSON).
+            if (!FileHandler::storeConfig())
+            {
+                sendResponse(request, 500, R"({"type":"error","message":"Save failed"})");
+                return;
+            }
+
             // Send 200 as Response.
             sendOK(request);
         }
@@ -258,21 +541,23 @@ void WebHandler::handleAPICall(AsyncWebServerRequest* request, JsonVariant json)
         // Send 200 as Response.
         sendOK(request);
 
+        // Keep Run Hours since the last Flush.
+        StatsHandler::flush();
+
         // Wait for 500ms.
         delay(500);
 
         // Restart ESP.
+        CrashHandler::markRestart(RESTART_API);
         ESP.restart();
     }
     else if (type == "update")
     {
-        if (OTAHandler::hasUpdate())
+        // Schedule Update in Background Task.
+        if (OTAHandler::update())
         {
             // Send 200 as Response.
             sendOK(request);
-
-            // Update to Latest Version.
-            OTAHandler::update();
         }
         else
         {
@@ -288,10 +573,14 @@ void WebHandler::handleAPICall(AsyncWebServerRequest* request, JsonVariant json)
         // Copy Backup Config to config.json.
         FileHandler::reset();
 
+        // Keep Run Hours since the last Flush (Stats survive the Config Reset).
+        StatsHandler::flush();
+
         // Wait for 1 Second.
         delay(1000);
 
         // Restart ESP.
+        CrashHandler::markRestart(RESTART_CONFIG);
         ESP.restart();
     }
     else
@@ -20,6 +20,9 @@ private:
     static void handleAPICall(AsyncWebServerRequest* request, JsonVariant json);
     static void sendResponse(AsyncWebServerRequest* request, int i, const char* text);
     static bool checkRequest(AsyncWebServerRequest* request, JsonVariant json);
+    static void setupPortal();
+    static bool redirectPortal(AsyncWebServerRequest* request);
+    static void handleProvisioning(AsyncWebServerRequest* request);
 };
 
 
@@ -0,0 +1,42 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#include "WiFiBackoff.h"
+
+#include "InternalConfig.h"
+
+/**
+ * Checks if an Interval has passed, safe across the millis() Wraparound.
+ *
+ * millis() counts in 32 Bit, the Difference is truncated so the native Tests
+ * (64 Bit `unsigned long`) wrap like the Device.
+ *
+ * @param now The current Time (ms).
+ * @param last The Start of the Interval (ms).
+ * @param interval The Interval (ms).
+ * @return True if the Interval has passed.
+ */
+bool WiFiBackoff::isDue(unsigned long now, unsigned long last, unsigned long interval)
+{
+    return (uint32_t)(now - last) >= interval;
+}
+
+/**
+ * Calculates the Reconnect Delay after a failed Attempt.
+ *
+ * The Delay doubles from WIFI_RETRY_MIN up to WIFI_RETRY_MAX.
+ *
+ * @param delay The current Delay (ms).
+ * @return The next Delay (ms).
+ */
+unsigned long WiFiBackoff::getNextRetry(unsigned long delay)
+{
+    if (delay < WIFI_RETRY_MIN)
+        return WIFI_RETRY_MIN;
+
+    if (delay >= WIFI_RETRY_MAX / 2)
+        return WIFI_RETRY_MAX;
+
+    return delay * 2;
+}
@@ -0,0 +1,23 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#ifndef WIFIBACKOFF_H
+#define WIFIBACKOFF_H
+#include <stdint.h>
+
+
+/**
+ * Decides when the Station retries a failed Connection.
+ *
+ * Free of Arduino Dependencies, so the Backoff runs in the native Tests.
+ */
+class WiFiBackoff
+{
+public:
+    static bool isDue(unsigned long now, unsigned long last, unsigned long interval);
+    static unsigned long getNextRetry(unsigned long delay);
+};
+
+
+#endif //WIFIBACKOFF_H
@@ -4,8 +4,12 @@
 
 #include "WiFiHandler.h"
 #include <WiFi.h>
+#include <Preferences.h>
+#include "BootHandler.h"
 #include "FileHandler.h"
 #include "InternalConfig.h"
+#include "WiFiBackoff.h"
+#include "WiFiRoaming.h"
 
 // Konstanten
 const unsigned long WiFiHandler::CONNECTION_TIMEOUT_MS = 30000; // 30 Sekunden
@@ -16,6 +20,79 @@ unsigned long WiFiHandler::connectionStartTime = 0;
 // Store last Reconnect Attempt Timestamp.
 long lastReconnectAttempt;
 
+// Store current Reconnect Delay (doubles up to WIFI_RETRY_MAX).
+volatile unsigned long retryDelay = WIFI_RETRY_MIN;
+
+/**
+ * Describes the last successful Access Point, stored in NVS so Boots and
+ * Reconnects can skip the Scan.
+ */
+struct WiFiCache
+{
+    uint8_t bssid[6];
+    uint8_t channel;
+    char ssid[33];
+};
+
+// Store cached Access Point (channel 0 = no Cache).
+WiFiCache wifiCache = {};
+
+// Store if the current Attempt uses the Cache.
+volatile bool wifiFast = false;
+
+// Store if the Cache has been compared since the last IP.
+volatile bool wifiCacheChecked = false;
+
+/**
+ * Describes a known Network, a higher Priority is preferred.
+ */
+struct WiFiNetwork
+{
+    String ssid;
+    String password;
+    int priority;
+};
+
+// Store known Networks (`wifi.client` first, then `wifi.networks`).
+WiFiNetwork wifiNetworks[WIFI_NETWORKS_MAX];
+uint8_t wifiNetworkCount = 0;
+
+// Define Scan Purposes.
+#define SCAN_NONE 0
+#define SCAN_CONNECT 1
+#define SCAN_ROAM 2
+
+// Store running Background Scan.
+uint8_t wifiScan = SCAN_NONE;
+
+// Store Roaming State.
+WiFiRoam wifiRoam = {};
+uint32_t wifiRoams = 0;
+
+// Store Connect Statistics.
+volatile uint32_t wifiConnects = 0;
+volatile uint32_t wifiFastConnects = 0;
+uint32_t wifiRetries = 0;
+volatile unsigned long wifiLastDuration = 0;
+volatile unsigned long wifiTotalDuration = 0;
+
+// Define Connection States.
+#define WIFI_IDLE 0
+#define WIFI_CONNECTING 1
+#define WIFI_CONNECTED 2
+
+// Store Connection State (written by the Wi-Fi Event Task).
+volatile uint8_t wifiState = WIFI_IDLE;
+
+// Store pending GOT_IP Event (consumed by the Loop).
+volatile bool wifiGotIP = false;
+
+// Store active Timeout before the AP is started.
+unsigned long connectionTimeout = WIFI_BOOT_TIMEOUT;
+
+// Define State Names (Index = WIFI_*).
+const char* const wifiStates[] = {"idle", "connecting", "connected"};
+
 bool WiFiHandler::apStarted = false;
 
 
@@ -24,11 +101,26 @@ IPAddress apIP(10, 10, 10, 1);
 IPAddress gateway(10, 10, 10, 1);
 IPAddress subnet(255, 255, 255, 0);
 
+// Answer every DNS Query with the AP IP while the AP is running (Captive Portal).
+DNSServer dnsServer;
+
+/**
+ * Starts the Wi-Fi Connection in the Background.
+ *
+ * The Connection is driven by Wi-Fi Events (see `handleEvent()`), so this
+ * method returns immediately and the Relais, Automation, Display and Web
+ * Server are ready while the Station is still connecting. If no IP is
+ * assigned within WIFI_BOOT_TIMEOUT, `checkConnection()` starts the AP next
+ * to the Station.
+ */
 void WiFiHandler::setup()
 {
     // Enable Auto Reconnect.
     WiFi.setAutoReconnect(true);
 
+    // Track Connection State via Events.
+    WiFi.onEvent(handleEvent);
+
     JsonDocument config = FileHandler::getConfig();
 
     // Check if Wi-Fi Credentials are set.
@@ -40,22 +132,21 @@ void WiFiHandler::setup()
         // Set AP mode explicitly
         WiFi.mode(WIFI_MODE_STA);
 
-        // Begin Wi-Fi Connection.
-        WiFi.begin(config["wifi"]["client"]["ssid"].as<String>(),
-                   config["wifi"]["client"]["password"].as<String>());
+        // Load known Networks and last Access Point.
+        loadNetworks(config);
+        loadCache();
+        WiFiRoaming::begin(wifiRoam, millis());
 
         // Start Timer for Connection Timeout.
         connectionStartTime = millis();
+        connectionTimeout = WIFI_BOOT_TIMEOUT;
+        lastReconnectAttempt = connectionStartTime;
+        retryDelay = WIFI_RETRY_MIN;
         apStarted = false;
+        wifiState = WIFI_CONNECTING;
 
-
-        // Wait for Connection.
-        int result = WiFi.waitForConnectResult(15000);
-
-        if (result != WL_CONNECTED)
-        {
-            startAP(config, false);
-        }
+        // Begin Wi-Fi Connection, skip the Scan if the Access Point is known.
+        connectStation(true);
 
 #if DEBUG == true
         Serial.println("WiFi Client started. Try to connect...");
@@ -70,9 +161,139 @@ void WiFiHandler::setup()
 #if DEBUG == true
     Serial.println("WiFi started");
 #endif
+}
 
-    Serial.print("Ready on ");
-    Serial.println(WiFi.softAPIP());
+/**
+ * Tracks the Station State, runs in the Wi-Fi Event Task.
+ *
+ * Only Flags are set here, everything else (eq. MQTT Setup, stopping the AP)
+ * is handled by the Loop.
+ *
+ * @param event The Wi-Fi Event.
+ * @param info The Event Info (unused).
+ */
+void WiFiHandler::handleEvent(WiFiEvent_t event, WiFiEventInfo_t info)
+{
+    switch (event)
+    {
+    case ARDUINO_EVENT_WIFI_STA_GOT_IP:
+        wifiState = WIFI_CONNECTED;
+        wifiGotIP = true;
+        wifiCacheChecked = false;
+        retryDelay = WIFI_RETRY_MIN;
+
+        // Update Connect Statistics.
+        wifiLastDuration = millis() - connectionStartTime;
+        wifiTotalDuration += wifiLastDuration;
+        wifiConnects++;
+
+        if (wifiFast)
+            wifiFastConnects++;
+
+        BootHandler::mark(BOOT_IP);
+        break;
+    case ARDUINO_EVENT_WIFI_STA_DISCONNECTED:
+    case ARDUINO_EVENT_WIFI_STA_LOST_IP:
+        if (wifiState == WIFI_CONNECTED)
+        {
+            // Restart Timeout for the AP Fallback, the Driver reconnects first.
+            wifiState = WIFI_CONNECTING;
+            connectionStartTime = millis();
+            connectionTimeout = CONNECTION_TIMEOUT_MS;
+            lastReconnectAttempt = connectionStartTime;
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * Reports a new IP Assignment once.
+ *
+ * @return True if the Station got an IP since the last Call.
+ */
+bool WiFiHandler::takeGotIP()
+{
+    if (!wifiGotIP)
+        return false;
+
+    wifiGotIP = false;
+
+    return true;
+}
+
+/**
+ * Retrieves the Name of the Connection State.
+ *
+ * @return idle (no Credentials), connecting or connected.
+ */
+const char* WiFiHandler::getState()
+{
+    return wifiStates[wifiState];
+}
+
+/**
+ * Retrieves the Number of successful Connects since Boot.
+ *
+ * @return The Number of IP Assignments.
+ */
+uint32_t WiFiHandler::getConnects()
+{
+    return wifiConnects;
+}
+
+/**
+ * Retrieves the Number of Connects that skipped the Scan.
+ *
+ * @return The Number of Connects on the cached Access Point.
+ */
+uint32_t WiFiHandler::getFastConnects()
+{
+    return wifiFastConnects;
+}
+
+/**
+ * Retrieves the Number of Reconnect Attempts since Boot.
+ *
+ * @return The Number of Attempts.
+ */
+uint32_t WiFiHandler::getRetries()
+{
+    return wifiRetries;
+}
+
+/**
+ * Retrieves the Duration of the last Connect (Begin/Disconnect until IP).
+ *
+ * @return The Duration in ms.
+ */
+unsigned long WiFiHandler::getLastConnectDuration()
+{
+    return wifiLastDuration;
+}
+
+/**
+ * Retrieves the average Connect Duration.
+ *
+ * @return The Duration in ms, or `0` if never connected.
+ */
+unsigned long WiFiHandler::getAverageConnectDuration()
+{
+    if (wifiConnects == 0)
+        return 0;
+
+    return wifiTotalDuration / wifiConnects;
+}
+
+/**
+ * Retrieves the Number of Roaming Switches since Boot.
+ *
+ * @return The Number of Switches to a stronger Access Point.
+ */
+uint32_t WiFiHandler::getRoams()
+{
+    return wifiRoams;
 }
 
 /**
@@ -89,6 +310,10 @@ void WiFiHandler::setup()
 void WiFiHandler::loop()
 {
     checkConnection();
+
+    // Answer pending DNS Queries of AP Clients.
+    if (apStarted)
+        dnsServer.processNextRequest();
 }
 
 /**
@@ -103,6 +328,16 @@ bool WiFiHandler::isConnected()
     return WiFi.status() == WL_CONNECTED;
 }
 
+/**
+ * Checks if the Access Point (and the Captive Portal) is running.
+ *
+ * @return True if the AP is active.
+ */
+bool WiFiHandler::isAPActive()
+{
+    return apStarted;
+}
+
 /**
  * Retrieves the current Received Signal Strength Indicator (RSSI) value
  * of the connected Wi-Fi network. RSSI represents the signal strength,
@@ -151,27 +386,49 @@ void WiFiHandler::checkConnection()
         return;
     }
 
-    // If STA is connected → nothing to do
+    // Poll a running Background Scan
+    if (wifiScan != SCAN_NONE)
+        handleScan();
+
+    // If STA is connected → remember the Access Point and check the Signal
     if (isConnected())
+    {
+        if (!wifiCacheChecked)
+        {
+            wifiCacheChecked = true;
+            saveCache();
+        }
+
+        checkRoaming();
+
+        return;
+    }
+
+    // No Credentials → AP only
+    if (wifiState == WIFI_IDLE)
         return;
 
     // STA is NOT connected → handle reconnect logic
     unsigned long now = millis();
 
-    // Try to reconnect every 5 seconds
-    if (now - lastReconnectAttempt >= 5000)
+    // Try to reconnect with exponential Backoff (not while scanning)
+    if (wifiScan == SCAN_NONE && WiFiBackoff::isDue(now, lastReconnectAttempt, retryDelay))
     {
         lastReconnectAttempt = now;
+        retryDelay = WiFiBackoff::getNextRetry(retryDelay);
+        wifiRetries++;
 
 #if DEBUG == true
-        Serial.println("WiFi lost. Trying reconnect...");
+        Serial.printf("WiFi lost. Trying reconnect (next in %lu ms)...\n", retryDelay);
 #endif
 
-        WiFi.reconnect();
+        // A failed Attempt on the cached Access Point falls back to a Scan.
+        WiFi.disconnect();
+        connectStation(!wifiFast);
     }
 
-    // If reconnect takes too long → start AP
-    if (!apStarted && now - connectionStartTime > CONNECTION_TIMEOUT_MS)
+    // If connecting takes too long → start AP
+    if (!apStarted && now - connectionStartTime > connectionTimeout)
     {
 #if DEBUG == true
         Serial.println("Reconnect timeout. Starting AP...");
@@ -185,6 +442,265 @@ void WiFiHandler::checkConnection()
 }
 
 
+/**
+ * Begins a Station Connection.
+ *
+ * If a static IP is configured (`wifi.client.ip`, `gateway`, `subnet`, `dns`),
+ * DHCP is skipped. With `fast` and a cached Access Point of a known Network,
+ * the BSSID and Channel are passed to the Driver so no Scan is needed.
+ * Otherwise a Background Scan selects the best known Network (see
+ * `handleScan()`).
+ *
+ * @param fast True to use the cached Access Point.
+ */
+void WiFiHandler::connectStation(bool fast)
+{
+    JsonDocument config = FileHandler::getConfig();
+    JsonVariantConst client = config["wifi"]["client"];
+
+    IPAddress ip;
+    IPAddress gw;
+    IPAddress mask;
+    IPAddress dns;
+
+    // Apply static IP Config if set.
+    if (ip.fromString(client["ip"] | "") && gw.fromString(client["gateway"] | "") &&
+        mask.fromString(client["subnet"] | "255.255.255.0"))
+    {
+        if (!dns.fromString(client["dns"] | ""))
+            dns = gw;
+
+        WiFi.config(ip, gw, mask, dns);
+    }
+
+    int network = findNetwork(wifiCache.ssid);
+
+    if (fast && wifiCache.channel != 0 && network >= 0)
+    {
+        connectNetwork(network, wifiCache.channel, wifiCache.bssid);
+        wifiFast = true;
+        return;
+    }
+
+    // Scan in the Background, connect once the Results are available.
+    if (WiFi.scanNetworks(true) == WIFI_SCAN_FAILED)
+    {
+        // Connect blindly to the preferred Network (eq. hidden SSID).
+        connectNetwork(0, 0, NULL);
+        return;
+    }
+
+    wifiScan = SCAN_CONNECT;
+
+#if DEBUG == true
+    Serial.println("WiFi scanning");
+#endif
+}
+
+/**
+ * Begins the Connection to a known Network.
+ *
+ * @param network The Index of the Network.
+ * @param channel The Channel, `0` to let the Driver scan.
+ * @param bssid The BSSID or NULL.
+ */
+void WiFiHandler::connectNetwork(int network, int32_t channel, const uint8_t* bssid)
+{
+    wifiFast = false;
+
+    WiFi.begin(wifiNetworks[network].ssid.c_str(), wifiNetworks[network].password.c_str(), channel, bssid);
+
+#if DEBUG == true
+    Serial.printf("WiFi connecting to %s (Channel %d)\n", wifiNetworks[network].ssid.c_str(), channel);
+#endif
+}
+
+/**
+ * Loads the known Networks.
+ *
+ * `wifi.client` is always the first Network, `wifi.networks` adds further
+ * Networks (`ssid`, `password`, `priority`) up to WIFI_NETWORKS_MAX.
+ *
+ * @param config The Config.
+ */
+void WiFiHandler::loadNetworks(JsonDocument& config)
+{
+    wifiNetworkCount = 0;
+
+    wifiNetworks[wifiNetworkCount++] = {
+        config["wifi"]["client"]["ssid"].as<String>(),
+        config["wifi"]["client"]["password"].as<String>(),
+        config["wifi"]["client"]["priority"] | 0
+    };
+
+    for (JsonObjectConst network : config["wifi"]["networks"].as<JsonArrayConst>())
+    {
+        if (wifiNetworkCount >= WIFI_NETWORKS_MAX)
+            break;
+
+        String ssid = network["ssid"] | "";
+
+        if (ssid.isEmpty() || findNetwork(ssid) >= 0)
+            continue;
+
+        wifiNetworks[wifiNetworkCount++] = {ssid, network["password"] | "", network["priority"] | 0};
+    }
+}
+
+/**
+ * Finds a known Network by its SSID.
+ *
+ * @param ssid The SSID.
+ * @return The Index of the Network, or `-1` if unknown.
+ */
+int WiFiHandler::findNetwork(const String& ssid)
+{
+    for (uint8_t i = 0; i < wifiNetworkCount; i++)
+    {
+        if (wifiNetworks[i].ssid == ssid)
+            return i;
+    }
+
+    return -1;
+}
+
+/**
+ * Selects the best Scan Result of a known Network (see
+ * `WiFiRoaming::selectResult()`).
+ *
+ * @param found The Number of Scan Results.
+ * @param minRSSI The minimum RSSI (dBm) of a Candidate.
+ * @return The Index of the Scan Result, or `-1` if there is no Candidate.
+ */
+int WiFiHandler::selectResult(int16_t found, int32_t minRSSI)
+{
+    WiFiResults results = {
+        found,
+        [](int16_t index) { return findNetwork(WiFi.SSID(index)); },
+        [](int network) { return wifiNetworks[network].priority; },
+        [](int16_t index) { return WiFi.RSSI(index); },
+        [](int16_t index) { return (const uint8_t*)WiFi.BSSID(index); }
+    };
+
+    return WiFiRoaming::selectResult(results, minRSSI, isConnected() ? WiFi.BSSID() : NULL);
+}
+
+/**
+ * Starts a Background Scan if the Signal stays weak (see
+ * `WiFiRoaming::checkSignal()`).
+ */
+void WiFiHandler::checkRoaming()
+{
+    if (wifiScan != SCAN_NONE || apStarted || !WiFiRoaming::checkSignal(wifiRoam, millis(), WiFi.RSSI()))
+        return;
+
+    if (WiFi.scanNetworks(true) != WIFI_SCAN_FAILED)
+    {
+        wifiScan = SCAN_ROAM;
+
+#if DEBUG == true
+        Serial.printf("WiFi weak (%d dBm), scanning\n", WiFi.RSSI());
+#endif
+    }
+}
+
+/**
+ * Evaluates a finished Background Scan without blocking.
+ *
+ * For a Connect Scan the best known Network is joined (or the preferred
+ * Network blindly if none was found). For a Roaming Scan the Station only
+ * switches if a known BSSID is at least WIFI_ROAM_HYSTERESIS dB stronger.
+ */
+void WiFiHandler::handleScan()
+{
+    int16_t found = WiFi.scanComplete();
+
+    if (found == WIFI_SCAN_RUNNING)
+        return;
+
+    uint8_t purpose = wifiScan;
+    wifiScan = SCAN_NONE;
+
+    if (purpose == SCAN_ROAM)
+    {
+        int best = selectResult(found, WiFi.RSSI() + WIFI_ROAM_HYSTERESIS);
+
+        if (best >= 0 && isConnected())
+        {
+#if DEBUG == true
+            Serial.printf("WiFi roaming %d -> %d dBm\n", WiFi.RSSI(), WiFi.RSSI(best));
+#endif
+
+            wifiRoams++;
+
+            WiFi.disconnect();
+            connectNetwork(findNetwork(WiFi.SSID(best)), WiFi.channel(best), WiFi.BSSID(best));
+        }
+    }
+    else if (!isConnected())
+    {
+        int best = selectResult(found, INT32_MIN);
+
+        // Give the Connect the full Retry Delay.
+        lastReconnectAttempt = millis();
+
+        if (best >= 0)
+            connectNetwork(findNetwork(WiFi.SSID(best)), WiFi.channel(best), WiFi.BSSID(best));
+        else
+            connectNetwork(0, 0, NULL);
+    }
+
+    WiFi.scanDelete();
+}
+
+/**
+ * Loads the last Access Point from NVS.
+ */
+void WiFiHandler::loadCache()
+{
+    Preferences preferences;
+
+    if (!preferences.begin("wifi", true))
+        return;
+
+    if (preferences.getBytesLength("cache") == sizeof(WiFiCache))
+        preferences.getBytes("cache", &wifiCache, sizeof(WiFiCache));
+
+    preferences.end();
+
+    // Terminate SSID in case of corrupt Data.
+    wifiCache.ssid[sizeof(wifiCache.ssid) - 1] = '\0';
+}
+
+/**
+ * Stores the connected Access Point in NVS, only if it changed to save Flash.
+ */
+void WiFiHandler::saveCache()
+{
+    WiFiCache current = {};
+
+    memcpy(current.bssid, WiFi.BSSID(), sizeof(current.bssid));
+    current.channel = WiFi.channel();
+    strlcpy(current.ssid, WiFi.SSID().c_str(), sizeof(current.ssid));
+
+    if (memcmp(&current, &wifiCache, sizeof(WiFiCache)) == 0)
+        return;
+
+    wifiCache = current;
+
+    Preferences preferences;
+
+    if (preferences.begin("wifi", false))
+    {
+        preferences.putBytes("cache", &wifiCache, sizeof(WiFiCache));
+        preferences.end();
+    }
+
+#if DEBUG == true
+    Serial.printf("WiFi cached Channel %u\n", wifiCache.channel);
+#endif
+}
+
 /**
  * Initializes and starts a Wi-Fi Access Point (AP) using the provided configuration.
  * The method sets the Wi-Fi mode to AP, configures the subnet, and starts the AP
@@ -206,6 +722,10 @@ void WiFiHandler::startAP(JsonDocument& config, bool combine)
     WiFi.softAP(config["wifi"]["ap"]["ssid"].as<String>(),
                 config["wifi"]["ap"]["password"].as<String>());
 
+    // Resolve all Hostnames to the AP, so Clients open the Setup Page.
+    dnsServer.setErrorReplyCode(DNSReplyCode::NoError);
+    dnsServer.start(53, "*", apIP);
+
     apStarted = true;
 
 #if DEBUG == true
@@ -246,6 +766,7 @@ void WiFiHandler::stopAP()
 {
     if (apStarted)
     {
+        dnsServer.stop();
         WiFi.softAPdisconnect(true);
         apStarted = false;
 
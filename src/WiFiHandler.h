@@ -6,13 +6,25 @@
 #define WIFIHANDLER_H
 
 #include <ArduinoJson.h>
+#include <DNSServer.h>
+#include <WiFi.h>
 
 
 class WiFiHandler
 {
 private:
     static void checkConnection();
+    static void handleEvent(WiFiEvent_t event, WiFiEventInfo_t info);
     static void startAP(JsonDocument& config, bool combine);
+    static void connectStation(bool fast);
+    static void connectNetwork(int network, int32_t channel, const uint8_t* bssid);
+    static void loadNetworks(JsonDocument& config);
+    static int findNetwork(const String& ssid);
+    static int selectResult(int16_t found, int32_t minRSSI);
+    static void checkRoaming();
+    static void handleScan();
+    static void loadCache();
+    static void saveCache();
     static unsigned long connectionStartTime;
     static bool apStarted;
     static const unsigned long CONNECTION_TIMEOUT_MS;
@@ -23,7 +35,16 @@ public:
     static void setup();
     static void loop();
     static bool isConnected();
+    static bool isAPActive();
     static float getRSSI();
+    static bool takeGotIP();
+    static const char* getState();
+    static uint32_t getConnects();
+    static uint32_t getFastConnects();
+    static uint32_t getRetries();
+    static unsigned long getLastConnectDuration();
+    static unsigned long getAverageConnectDuration();
+    static uint32_t getRoams();
 };
 
 
@@ -0,0 +1,100 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#include "WiFiRoaming.h"
+#include <string.h>
+
+#include "InternalConfig.h"
+#include "WiFiBackoff.h"
+
+/**
+ * Resets the Roaming State, the first Scan is allowed right away.
+ *
+ * @param roam The Roaming State.
+ * @param now The current Time (ms).
+ */
+void WiFiRoaming::begin(WiFiRoam& roam, unsigned long now)
+{
+    roam.lastCheck = now;
+    roam.lastScan = now - WIFI_ROAM_COOLDOWN;
+    roam.weakSamples = 0;
+}
+
+/**
+ * Samples the Signal of the connected Access Point.
+ *
+ * The RSSI is sampled every WIFI_ROAM_INTERVAL, a Scan needs
+ * WIFI_ROAM_SAMPLES weak Samples in a Row and WIFI_ROAM_COOLDOWN since the
+ * last Scan, so short Drops or a Client between two equal APs don't flap.
+ *
+ * @param roam The Roaming State.
+ * @param now The current Time (ms).
+ * @param rssi The RSSI (dBm) of the connected Access Point.
+ * @return True if a Roaming Scan should be started.
+ */
+bool WiFiRoaming::checkSignal(WiFiRoam& roam, unsigned long now, int32_t rssi)
+{
+    if (!WiFiBackoff::isDue(now, roam.lastCheck, WIFI_ROAM_INTERVAL))
+        return false;
+
+    roam.lastCheck = now;
+
+    if (rssi >= WIFI_ROAM_THRESHOLD)
+    {
+        roam.weakSamples = 0;
+        return false;
+    }
+
+    if (roam.weakSamples < WIFI_ROAM_SAMPLES)
+        roam.weakSamples++;
+
+    if (roam.weakSamples < WIFI_ROAM_SAMPLES || !WiFiBackoff::isDue(now, roam.lastScan, WIFI_ROAM_COOLDOWN))
+        return false;
+
+    roam.weakSamples = 0;
+    roam.lastScan = now;
+
+    return true;
+}
+
+/**
+ * Selects the best Scan Result of a known Network.
+ *
+ * The Network Priority wins, within the same Priority the stronger Signal.
+ * The currently connected BSSID is skipped.
+ *
+ * @param results The Scan Results.
+ * @param minRSSI The minimum RSSI (dBm) of a Candidate.
+ * @param current The connected BSSID, or NULL if not connected.
+ * @return The Index of the Scan Result, or `-1` if there is no Candidate.
+ */
+int WiFiRoaming::selectResult(const WiFiResults& results, int32_t minRSSI, const uint8_t* current)
+{
+    int best = -1;
+    int bestPriority = 0;
+    int32_t bestRSSI = 0;
+
+    for (int16_t i = 0; i < results.count; i++)
+    {
+        int network = results.getNetwork(i);
+        int32_t rssi = results.getRSSI(i);
+
+        if (network < 0 || rssi < minRSSI)
+            continue;
+
+        if (current != NULL && memcmp(results.getBSSID(i), current, 6) == 0)
+            continue;
+
+        int priority = results.getPriority(network);
+
+        if (best < 0 || priority > bestPriority || (priority == bestPriority && rssi > bestRSSI))
+        {
+            best = i;
+            bestPriority = priority;
+            bestRSSI = rssi;
+        }
+    }
+
+    return best;
+}
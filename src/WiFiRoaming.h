@@ -0,0 +1,52 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#ifndef WIFIROAMING_H
+#define WIFIROAMING_H
+#include <stdint.h>
+
+/**
+ * Describes the Results of a Wi-Fi Scan (the Driver on the Device, Fakes in
+ * the native Tests).
+ *
+ * `getNetwork` returns the Index of the known Network of a Result or `-1`,
+ * `getPriority` the Priority of a known Network (higher is preferred).
+ */
+struct WiFiResults
+{
+    int16_t count;
+    int (*getNetwork)(int16_t index);
+    int (*getPriority)(int network);
+    int32_t (*getRSSI)(int16_t index);
+    const uint8_t* (*getBSSID)(int16_t index);
+};
+
+/**
+ * Describes the Roaming State of the Station.
+ */
+struct WiFiRoam
+{
+    unsigned long lastCheck;
+    unsigned long lastScan;
+    uint8_t weakSamples;
+};
+
+
+/**
+ * Decides when the Station scans for a stronger Access Point and which Scan
+ * Result it joins.
+ *
+ * Free of Arduino Dependencies, so the Selection runs with fake Scan Results
+ * in the native Tests.
+ */
+class WiFiRoaming
+{
+public:
+    static void begin(WiFiRoam& roam, unsigned long now);
+    static bool checkSignal(WiFiRoam& roam, unsigned long now, int32_t rssi);
+    static int selectResult(const WiFiResults& results, int32_t minRSSI, const uint8_t* current);
+};
+
+
+#endif //WIFIROAMING_H
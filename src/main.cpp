@@ -1,25 +1,37 @@
 #include "Arduino.h"
 #include "AutomationHandler.h"
+#include "BootHandler.h"
+#include "CrashHandler.h"
 #include "DeviceHandler.h"
 #include "FileHandler.h"
+#include "MDNSHandler.h"
+#include "MemoryHandler.h"
+#include "ModbusHandler.h"
 #include "MQTTHandler.h"
 #include "OTAHandler.h"
+#include "RelaisHandler.h"
+#include "SensorHandler.h"
+#include "StatsHandler.h"
 #include "WebHandler.h"
 #include "WiFiHandler.h"
 //#include <MatterHandler.h>
 
+// Store if MQTT has been set up (on the first IP).
+bool mqttStarted = false;
+
 /**
  * @brief Initializes the system components necessary for operation.
  *
  * The setup function is responsible for:
  * 1. Initializing the serial communication at a baud rate of 115200.
  * 2. Preparing the file system for use by calling FileHandler::begin.
- * 3. Configuring the Wi-Fi connection by calling WiFiHandler::setup,
- *    using the stored configuration from the file system.
- * 4. Setting up the web components by invoking WebHandler::setup.
+ * 3. Starting the Display and Sensor Tasks, so the first Level is sampled
+ *    while the Rest boots.
+ * 4. Configuring the Wi-Fi connection by calling WiFiHandler::setup,
+ *    which connects in the Background.
+ * 5. Setting up the web components by invoking WebHandler::setup.
  *
- * It ensures that all the core subsystems are initialized before
- * entering the main loop.
+ * Every Phase is marked in the BootHandler (see the `boot` Status).
  */
 void setup()
 {
@@ -27,17 +39,38 @@ void setup()
     Serial.begin(115200);
     Serial.setDebugOutput(true);
 
+    // Switch off Relais Outputs as early as possible.
+    RelaisHandler::setup();
+    BootHandler::mark(BOOT_RELAIS);
+
+    // Count Boots and Crashes, read the Core Dump Summary.
+    CrashHandler::setup();
+
     // Setup File System.
     FileHandler::begin();
 
     // Load Config File.
     FileHandler::loadConfig();
 
-    // Setup Device Pins.
+    // Load Relais Interlocks.
+    RelaisHandler::configure();
+    BootHandler::mark(BOOT_CONFIG);
+
+    // Setup Device Pins, the Display initializes in its own Task.
     DeviceHandler::setup();
+    BootHandler::mark(BOOT_DEVICE);
+
+    // Start round-robin Sensor Sampling, the first Level is sampled right away.
+    SensorHandler::setup();
+    BootHandler::mark(BOOT_SENSOR);
 
-    // Setup Wi-Fi Connection from LittleFS.
+    // Setup Wi-Fi Connection from LittleFS, connects in the Background.
     WiFiHandler::setup();
+    BootHandler::mark(BOOT_WIFI);
+
+    // Restore Run Hours and Starts.
+    StatsHandler::setup();
+    BootHandler::mark(BOOT_STATS);
 
     // Setup Web.
     WebHandler::setup();
@@ -45,30 +78,44 @@ void setup()
     // Setup OTA.
     OTAHandler::setup();
 
-    // Setup Automation Handler.
+    // Advertise Services and Status via mDNS.
+    MDNSHandler::setup();
+
+    // Start Modbus TCP Server (if enabled).
+    ModbusHandler::setup();
+    BootHandler::mark(BOOT_SERVICES);
+
+    // Setup Automation Handler (waits for the first valid Level).
     AutomationHandler::setup();
 
+    // Start Memory Telemetry.
+    MemoryHandler::setup();
+
     // Setup Matter.
     //MatterHandler::setup();
 
-    // Check for Connection.
-    if (WiFiHandler::isConnected())
-    {
-        // Setup MQTT.
-        MQTTHandler::setup();
-    }
-
-    Serial.println("Ready");
+    // Control is ready, Wi-Fi and MQTT connect in the Background.
+    BootHandler::mark(BOOT_READY);
+    BootHandler::print();
 }
 
 void loop()
 {
+    unsigned long loopStart = micros();
+
     // Handle Device Loop.
     DeviceHandler::loop();
 
     // Check for WiFi Connection.
     WiFiHandler::loop();
 
+    // Setup MQTT on the first IP, Reconnects are handled by MQTTHandler::loop().
+    if (WiFiHandler::takeGotIP() && !mqttStarted)
+    {
+        mqttStarted = true;
+        MQTTHandler::setup();
+    }
+
     // Handle Web.
     WebHandler::loop();
 
@@ -78,9 +125,24 @@ void loop()
     // Loop OTA.
     OTAHandler::loop();
 
+    // Update mDNS Status Records.
+    MDNSHandler::loop();
+
     // Loop Automation Handler.
     AutomationHandler::loop();
 
+    // Refresh Modbus Register Image.
+    ModbusHandler::loop();
+
+    // Flush Relais Statistics.
+    StatsHandler::loop();
+
+    // Sample Heap and Stacks.
+    MemoryHandler::loop();
+
     // Loop Matter.
     //MatterHandler::loop();
+
+    // Measure Loop Duration.
+    DeviceHandler::recordLoop(micros() - loopStart);
 }
@@ -0,0 +1,191 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#include <unity.h>
+
+#include "AdcTable.h"
+
+// Define maximum Error (mV) of the corrected Table at the Reference Pairs.
+#define TOLERANCE 15
+
+/**
+ * Reference Pairs (raw Counts, true mV) of an 11 dB Input.
+ *
+ * The Shape of the typical ESP32-C3 Curve: a linear Middle, a Foot of ~40 mV
+ * below 0.4 V and a Knee above 2.3 V where the Counts compress. Dense at
+ * both Ends, where the linear Characterization fails.
+ */
+const int32_t reference[][2] = {
+    {0, 40},
+    {64, 75},
+    {128, 110},
+    {192, 145},
+    {256, 181},
+    {320, 216},
+    {384, 251},
+    {448, 286},
+    {512, 321},
+    {576, 356},
+    {640, 392},
+    {1024, 625},
+    {1536, 938},
+    {2048, 1250},
+    {2560, 1563},
+    {3072, 1875},
+    {3584, 2188},
+    {3648, 2227},
+    {3712, 2266},
+    {3776, 2305},
+    {3840, 2352},
+    {3904, 2409},
+    {3968, 2479},
+    {4032, 2559},
+    {4095, 2650},
+};
+
+const uint8_t referenceCount = sizeof(reference) / sizeof(reference[0]);
+
+/**
+ * Linear eFuse Characterization of the Reference Input.
+ */
+uint32_t characterize(uint32_t counts)
+{
+    return counts * 2500 / 4095;
+}
+
+/**
+ * Builds Calibration Points ([measured mV, true mV]) from Reference Pairs.
+ */
+uint8_t calibrate(const uint8_t* indices, uint8_t count, int32_t (*points)[2])
+{
+    for (uint8_t i = 0; i < count; i++)
+    {
+        points[i][0] = characterize(reference[indices[i]][0]);
+        points[i][1] = reference[indices[i]][1];
+    }
+
+    return count;
+}
+
+int32_t getError(uint8_t index)
+{
+    int32_t millivolts = AdcTable::linearize((uint32_t)reference[index][0] << 4);
+
+    return millivolts - reference[index][1];
+}
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+void test_without_points_is_characterization()
+{
+    TEST_ASSERT_TRUE(AdcTable::build(characterize, nullptr, 0));
+
+    for (uint32_t counts = 0; counts < 4096; counts += 64)
+    {
+        TEST_ASSERT_EQUAL(characterize(counts), AdcTable::linearize(counts << 4));
+    }
+
+    // Last Entry (4096 Counts) is characterized at 4095.
+    TEST_ASSERT_EQUAL(characterize(4095), AdcTable::linearize(4096 << 4));
+}
+
+void test_linear_characterization_misses_the_ends()
+{
+    AdcTable::build(characterize, nullptr, 0);
+
+    TEST_ASSERT_EQUAL(-40, getError(0));
+    TEST_ASSERT_LESS_THAN(-100, getError(referenceCount - 1));
+}
+
+void test_points_correct_the_curve()
+{
+    // 0, 192, 640, 2048, 3584, 3840, 3968, 4095 Counts.
+    const uint8_t indices[] = {0, 3, 10, 13, 16, 20, 22, 24};
+    int32_t points[8][2];
+
+    uint8_t count = calibrate(indices, sizeof(indices), points);
+
+    TEST_ASSERT_TRUE(AdcTable::build(characterize, points, count));
+
+    for (uint8_t i = 0; i < referenceCount; i++)
+    {
+        int32_t error = getError(i);
+
+        TEST_ASSERT_TRUE_MESSAGE(error >= -TOLERANCE && error <= TOLERANCE, "Reference Pair out of Tolerance");
+    }
+}
+
+void test_interpolates_between_table_entries()
+{
+    AdcTable::build(characterize, nullptr, 0);
+
+    // Half Way between the Entries at 64 and 128 Counts.
+    uint32_t low = characterize(64);
+    uint32_t high = characterize(128);
+
+    TEST_ASSERT_EQUAL((low + high) / 2, AdcTable::linearize(96 << 4));
+}
+
+void test_position_beyond_table_is_clamped()
+{
+    AdcTable::build(characterize, nullptr, 0);
+
+    TEST_ASSERT_EQUAL(characterize(4095), AdcTable::linearize(8191 << 4));
+}
+
+void test_correct_single_point_is_offset()
+{
+    const int32_t points[][2] = {{1000, 1020}};
+
+    TEST_ASSERT_EQUAL(20, AdcTable::correct(0, points, 1));
+    TEST_ASSERT_EQUAL(2520, AdcTable::correct(2500, points, 1));
+}
+
+void test_correct_extrapolates_outer_segments()
+{
+    const int32_t points[][2] = {{100, 200}, {1000, 1000}, {2000, 2200}};
+
+    TEST_ASSERT_EQUAL(1000, AdcTable::correct(1000, points, 3));
+    TEST_ASSERT_EQUAL(1600, AdcTable::correct(1500, points, 3));
+    TEST_ASSERT_EQUAL(112, AdcTable::correct(0, points, 3));
+    TEST_ASSERT_EQUAL(2800, AdcTable::correct(2500, points, 3));
+}
+
+void test_unordered_points_are_ignored()
+{
+    const int32_t points[][2] = {{1000, 1100}, {1000, 1200}};
+
+    TEST_ASSERT_FALSE(AdcTable::isValid(points, 2));
+    TEST_ASSERT_FALSE(AdcTable::build(characterize, points, 2));
+    TEST_ASSERT_EQUAL(characterize(2048), AdcTable::linearize(2048 << 4));
+}
+
+void test_negative_voltage_is_clamped()
+{
+    const int32_t points[][2] = {{500, 0}, {1000, 1000}};
+
+    TEST_ASSERT_TRUE(AdcTable::build(characterize, points, 2));
+    TEST_ASSERT_EQUAL(0, AdcTable::linearize(0));
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_without_points_is_characterization);
+    RUN_TEST(test_linear_characterization_misses_the_ends);
+    RUN_TEST(test_points_correct_the_curve);
+    RUN_TEST(test_interpolates_between_table_entries);
+    RUN_TEST(test_position_beyond_table_is_clamped);
+    RUN_TEST(test_correct_single_point_is_offset);
+    RUN_TEST(test_correct_extrapolates_outer_segments);
+    RUN_TEST(test_unordered_points_are_ignored);
+    RUN_TEST(test_negative_voltage_is_clamped);
+    return UNITY_END();
+}
@@ -0,0 +1,86 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#include <unity.h>
+
+#include "InternalConfig.h"
+#include "WiFiBackoff.h"
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+void test_retry_doubles_up_to_max()
+{
+    const unsigned long expected[] = {8000, 16000, 32000, 60000, 60000};
+    unsigned long delay = WIFI_RETRY_MIN;
+
+    for (unsigned long next : expected)
+    {
+        delay = WiFiBackoff::getNextRetry(delay);
+        TEST_ASSERT_EQUAL(next, delay);
+    }
+}
+
+void test_retry_starts_at_min()
+{
+    TEST_ASSERT_EQUAL(WIFI_RETRY_MIN, WiFiBackoff::getNextRetry(0));
+}
+
+void test_retry_due_after_delay()
+{
+    TEST_ASSERT_FALSE(WiFiBackoff::isDue(5000 + WIFI_RETRY_MIN - 1, 5000, WIFI_RETRY_MIN));
+    TEST_ASSERT_TRUE(WiFiBackoff::isDue(5000 + WIFI_RETRY_MIN, 5000, WIFI_RETRY_MIN));
+}
+
+void test_retry_due_across_millis_wrap()
+{
+    unsigned long last = 0xFFFFFFFFUL - 1000;
+
+    TEST_ASSERT_FALSE(WiFiBackoff::isDue((uint32_t)(last + 3999), last, 4000));
+    TEST_ASSERT_TRUE(WiFiBackoff::isDue((uint32_t)(last + 4000), last, 4000));
+}
+
+void test_attempts_follow_backoff()
+{
+    // Simulate the Loop every 100 ms for 5 Minutes while the AP is down.
+    unsigned long last = 0;
+    unsigned long delay = WIFI_RETRY_MIN;
+    unsigned long attempts[16];
+    uint8_t count = 0;
+
+    for (unsigned long now = 0; now <= 300000; now += 100)
+    {
+        if (WiFiBackoff::isDue(now, last, delay))
+        {
+            last = now;
+            delay = WiFiBackoff::getNextRetry(delay);
+            attempts[count++] = now;
+        }
+    }
+
+    const unsigned long expected[] = {4000, 12000, 28000, 60000, 120000, 180000, 240000, 300000};
+
+    TEST_ASSERT_EQUAL(sizeof(expected) / sizeof(expected[0]), count);
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        TEST_ASSERT_EQUAL(expected[i], attempts[i]);
+    }
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_retry_doubles_up_to_max);
+    RUN_TEST(test_retry_starts_at_min);
+    RUN_TEST(test_retry_due_after_delay);
+    RUN_TEST(test_retry_due_across_millis_wrap);
+    RUN_TEST(test_attempts_follow_backoff);
+    return UNITY_END();
+}
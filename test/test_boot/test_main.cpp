@@ -0,0 +1,334 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#include <ArduinoJson.h>
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <unity.h>
+
+#include "ConfigStore.h"
+#include "InternalConfig.h"
+
+// Define Boots per Measurement.
+#define BOOTS 200
+
+/**
+ * Counts the Heap of the Config like `ESP.getFreeHeap()` before and after the
+ * Load. Every Block carries its Size, so `reallocate` is tracked as well.
+ */
+class CountingAllocator : public ArduinoJson::Allocator
+{
+public:
+    size_t current = 0;
+    size_t peak = 0;
+
+    void* allocate(size_t size) override
+    {
+        size_t* block = (size_t*)malloc(sizeof(max_align_t) + size);
+
+        if (block == nullptr)
+            return nullptr;
+
+        *block = size;
+        track(size);
+
+        return (uint8_t*)block + sizeof(max_align_t);
+    }
+
+    void deallocate(void* pointer) override
+    {
+        if (pointer == nullptr)
+            return;
+
+        size_t* block = (size_t*)((uint8_t*)pointer - sizeof(max_align_t));
+
+        current -= *block;
+        free(block);
+    }
+
+    void* reallocate(void* pointer, size_t size) override
+    {
+        if (pointer == nullptr)
+            return allocate(size);
+
+        size_t* block = (size_t*)((uint8_t*)pointer - sizeof(max_align_t));
+        size_t previous = *block;
+
+        block = (size_t*)realloc(block, sizeof(max_align_t) + size);
+
+        if (block == nullptr)
+            return nullptr;
+
+        *block = size;
+        current -= previous;
+        track(size);
+
+        return (uint8_t*)block + sizeof(max_align_t);
+    }
+
+    void track(size_t size)
+    {
+        current += size;
+
+        if (current > peak)
+            peak = current;
+    }
+
+    void reset()
+    {
+        peak = current;
+    }
+};
+
+// Store mocked File System (Path => Content).
+std::map<std::string, std::string> files;
+
+// Store Heap Counter and Config (FileHandler::config).
+CountingAllocator heap;
+JsonDocument config(&heap);
+
+// Store File Accesses of the last Boot.
+uint8_t reads;
+size_t parsedJson;
+
+std::string sample;
+
+/**
+ * Loads the binary Config like `FileHandler::loadBinary()`: one Read into a
+ * Heap Buffer, Header Check, MessagePack Decode.
+ */
+bool loadBinary(const char* path)
+{
+    if (files.count(path) == 0)
+        return false;
+
+    const std::string& file = files[path];
+
+    reads++;
+
+    uint8_t* buffer = (uint8_t*)heap.allocate(file.size());
+    memcpy(buffer, file.data(), file.size());
+
+    bool valid = ConfigStore::checkHeader(buffer, file.size()) &&
+        !deserializeMsgPack(config, buffer + sizeof(ConfigHeader), file.size() - sizeof(ConfigHeader)) &&
+        config.is<JsonObject>();
+
+    heap.deallocate(buffer);
+
+    if (!valid)
+        config.clear();
+
+    return valid;
+}
+
+/**
+ * Loads a JSON Config like `FileHandler::parseConfig()`, streamed from the File.
+ */
+bool loadJson(const char* path)
+{
+    if (files.count(path) == 0)
+        return false;
+
+    const std::string& file = files[path];
+
+    reads++;
+    parsedJson += file.size();
+
+    if (deserializeJson(config, file.data(), file.size()) || !config.is<JsonObject>())
+    {
+        config.clear();
+        return false;
+    }
+
+    return true;
+}
+
+bool writeBinary(const char* path)
+{
+    size_t length = measureMsgPack(config);
+    std::string buffer(sizeof(ConfigHeader) + length, '\0');
+
+    serializeMsgPack(config, (uint8_t*)&buffer[sizeof(ConfigHeader)], length);
+    ConfigStore::writeHeader((uint8_t*)&buffer[0], length);
+
+    files[path] = buffer;
+    return true;
+}
+
+bool writeJson(const char* path)
+{
+    std::string buffer;
+
+    serializeJson(config, buffer);
+    files[path] = buffer;
+    return true;
+}
+
+bool renameFile(const char* from, const char* to)
+{
+    if (files.count(from) == 0)
+        return false;
+
+    files[to] = files[from];
+    files.erase(from);
+    return true;
+}
+
+bool copyFile(const char* from, const char* to)
+{
+    if (files.count(from) == 0)
+        return false;
+
+    files[to] = files[from];
+    return true;
+}
+
+const ConfigFiles fs = {loadBinary, loadJson, writeBinary, writeJson, renameFile, copyFile};
+
+/**
+ * Describes the Cost of a Boot (Config Load until the Handlers can read it).
+ */
+struct BootCost
+{
+    uint8_t source;
+    double micros;
+    size_t peakHeap;
+    size_t heap;
+};
+
+/**
+ * Boots BOOTS Times from the current File System and keeps the Average Time.
+ */
+BootCost boot()
+{
+    BootCost cost = {};
+    auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < BOOTS; i++)
+    {
+        config.clear();
+        heap.reset();
+
+        reads = 0;
+        parsedJson = 0;
+
+        cost.source = ConfigStore::load(fs);
+    }
+
+    auto duration = std::chrono::steady_clock::now() - start;
+
+    cost.micros = std::chrono::duration<double, std::micro>(duration).count() / BOOTS;
+    cost.peakHeap = heap.peak;
+    cost.heap = heap.current;
+
+    return cost;
+}
+
+void report(const char* name, const BootCost& cost)
+{
+    char message[128];
+
+    snprintf(message, sizeof(message), "%s: %.1f us, Heap %zu B (Peak %zu B), %u Reads, %zu JSON Bytes",
+             name, cost.micros, cost.heap, cost.peakHeap, reads, parsedJson);
+    TEST_MESSAGE(message);
+}
+
+void setUp()
+{
+    files.clear();
+    config.clear();
+
+    // Factory Config, Tests run in the Project Directory.
+    files["/config.json.bak"] = sample;
+}
+
+void tearDown()
+{
+}
+
+void test_factory_boot_migrates_to_binary()
+{
+    TEST_ASSERT_EQUAL(CONFIG_BACKUP, ConfigStore::load(fs));
+    TEST_ASSERT_TRUE(ConfigStore::store(fs));
+
+    TEST_ASSERT_EQUAL(1, files.count("/config.bin"));
+    TEST_ASSERT_EQUAL(CONFIG_BINARY, ConfigStore::load(fs));
+}
+
+void test_binary_boot_reads_once_without_json()
+{
+    ConfigStore::load(fs);
+    ConfigStore::store(fs);
+
+    reads = 0;
+    parsedJson = 0;
+
+    TEST_ASSERT_EQUAL(CONFIG_BINARY, ConfigStore::load(fs));
+    TEST_ASSERT_EQUAL(1, reads);
+    TEST_ASSERT_EQUAL(0, parsedJson);
+}
+
+void test_binary_config_equals_json()
+{
+    std::string json;
+    std::string binary;
+
+    ConfigStore::load(fs);
+    serializeJson(config, json);
+
+    ConfigStore::store(fs);
+    TEST_ASSERT_EQUAL(CONFIG_BINARY, ConfigStore::load(fs));
+    serializeJson(config, binary);
+
+    TEST_ASSERT_EQUAL_STRING(json.c_str(), binary.c_str());
+}
+
+void test_boot_time_and_heap()
+{
+    ConfigStore::load(fs);
+    ConfigStore::store(fs);
+
+    // JSON Boot (Config of a Firmware before the binary Format).
+    files.erase("/config.bin");
+    BootCost json = boot();
+    report("JSON", json);
+
+    ConfigStore::store(fs);
+    BootCost binary = boot();
+    report("Binary", binary);
+
+    TEST_ASSERT_EQUAL(CONFIG_JSON, json.source);
+    TEST_ASSERT_EQUAL(CONFIG_BINARY, binary.source);
+
+    // Time and Heap depend on the Host, they are reported, not asserted.
+    TEST_ASSERT_LESS_THAN(files["/config.json"].size(), files["/config.bin"].size());
+}
+
+int main()
+{
+    std::ifstream file("data/config.json.bak");
+    std::stringstream content;
+
+    content << file.rdbuf();
+    sample = content.str();
+
+    UNITY_BEGIN();
+
+    if (sample.empty())
+    {
+        printf("data/config.json.bak not found, run from the Project Directory\n");
+        return UNITY_END();
+    }
+
+    RUN_TEST(test_factory_boot_migrates_to_binary);
+    RUN_TEST(test_binary_boot_reads_once_without_json);
+    RUN_TEST(test_binary_config_equals_json);
+    RUN_TEST(test_boot_time_and_heap);
+    return UNITY_END();
+}
@@ -0,0 +1,295 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#include <map>
+#include <string>
+#include <string.h>
+#include <unity.h>
+
+#include "ConfigStore.h"
+#include "InternalConfig.h"
+
+// Store RAM File System (Path => Content).
+std::map<std::string, std::string> files;
+
+// Store Power Budget: Bytes (and Renames) until the Power is cut.
+long budget;
+bool powerLost;
+
+// Store Config in RAM (FileHandler::config).
+std::string config;
+
+const std::string factory = "{\"version\":\"" VERSION "\",\"name\":\"factory\"}";
+const std::string before = "{\"version\":\"" VERSION "\",\"name\":\"before\",\"interval\":1000}";
+const std::string after = "{\"version\":\"" VERSION "\",\"name\":\"after\",\"interval\":250,\"ota\":true}";
+
+/**
+ * Spends the Budget of one Operation.
+ *
+ * @param cost The Bytes of the Operation.
+ * @return The Bytes which reach the Flash before the Power is cut.
+ */
+long spend(long cost)
+{
+    if (powerLost)
+        return -1;
+
+    if (budget < cost)
+    {
+        powerLost = true;
+        return budget;
+    }
+
+    budget -= cost;
+    return cost;
+}
+
+/**
+ * Writes a File like LittleFS: truncated on Open, Bytes written in Order.
+ */
+bool writeFile(const char* path, const std::string& content)
+{
+    long written = spend(content.size());
+
+    if (written < 0)
+        return false;
+
+    files[path] = content.substr(0, written);
+
+    return written == (long)content.size();
+}
+
+bool loadBinary(const char* path)
+{
+    if (files.count(path) == 0)
+        return false;
+
+    const std::string& file = files[path];
+
+    if (!ConfigStore::checkHeader((const uint8_t*)file.data(), file.size()))
+        return false;
+
+    config = file.substr(sizeof(ConfigHeader));
+    return true;
+}
+
+/**
+ * Accepts complete Documents only (a truncated one misses its closing Brace).
+ */
+bool loadJson(const char* path)
+{
+    if (files.count(path) == 0)
+        return false;
+
+    const std::string& file = files[path];
+
+    if (file.size() < 2 || file.front() != '{' || file.back() != '}')
+        return false;
+
+    config = file;
+    return true;
+}
+
+bool writeBinary(const char* path)
+{
+    std::string buffer(sizeof(ConfigHeader), '\0');
+    buffer += config;
+
+    ConfigStore::writeHeader((uint8_t*)&buffer[0], config.size());
+
+    return writeFile(path, buffer);
+}
+
+bool writeJson(const char* path)
+{
+    return writeFile(path, config);
+}
+
+bool renameFile(const char* from, const char* to)
+{
+    if (spend(1) != 1 || files.count(from) == 0)
+        return false;
+
+    files[to] = files[from];
+    files.erase(from);
+
+    return true;
+}
+
+bool copyFile(const char* from, const char* to)
+{
+    return files.count(from) > 0 && writeFile(to, files[from]);
+}
+
+const ConfigFiles fake = {loadBinary, loadJson, writeBinary, writeJson, renameFile, copyFile};
+
+/**
+ * Restores the Power with an unlimited Budget.
+ */
+void powerOn()
+{
+    budget = 1L << 30;
+    powerLost = false;
+}
+
+/**
+ * Boots with an empty Config in RAM.
+ */
+uint8_t boot()
+{
+    powerOn();
+    config.clear();
+
+    return ConfigStore::load(fake);
+}
+
+void setUp()
+{
+    files.clear();
+    files["/config.json.bak"] = factory;
+
+    powerOn();
+
+    config = before;
+    ConfigStore::store(fake);
+}
+
+void tearDown()
+{
+}
+
+void test_store_and_load_binary()
+{
+    TEST_ASSERT_EQUAL(CONFIG_BINARY, boot());
+    TEST_ASSERT_EQUAL_STRING(before.c_str(), config.c_str());
+    TEST_ASSERT_EQUAL(0, files.count("/config.bin.tmp"));
+    TEST_ASSERT_EQUAL(0, files.count("/config.json.tmp"));
+}
+
+void test_power_loss_at_every_offset()
+{
+    bool stored = false;
+    bool switched = false;
+    long offset = 0;
+
+    while (!stored)
+    {
+        // Reset to the old Config, then cut the Power after `offset` Bytes.
+        setUp();
+        config = after;
+        budget = offset;
+
+        stored = ConfigStore::store(fake);
+
+        uint8_t source = boot();
+
+        // The binary Config is replaced atomically, it is never lost.
+        TEST_ASSERT_EQUAL(CONFIG_BINARY, source);
+        TEST_ASSERT_TRUE(config == before || config == after);
+
+        // Once the new Config is visible it must never fall back.
+        if (config == after)
+            switched = true;
+        else
+            TEST_ASSERT_FALSE(switched);
+
+        // A second Boot sees the same Config.
+        std::string first = config;
+        boot();
+        TEST_ASSERT_EQUAL_STRING(first.c_str(), config.c_str());
+
+        offset++;
+    }
+
+    TEST_ASSERT_TRUE(switched);
+    TEST_ASSERT_EQUAL_STRING(after.c_str(), config.c_str());
+}
+
+void test_corrupt_binary_falls_back_to_json()
+{
+    files["/config.bin"][sizeof(ConfigHeader) + 3] ^= 0x01;
+
+    TEST_ASSERT_EQUAL(CONFIG_JSON, boot());
+    TEST_ASSERT_EQUAL_STRING(before.c_str(), config.c_str());
+}
+
+void test_interrupted_rename_uses_temp()
+{
+    files.erase("/config.bin");
+    files["/config.json"] = "{\"version\":";
+    files["/config.json.tmp"] = after;
+
+    TEST_ASSERT_EQUAL(CONFIG_TEMP, boot());
+    TEST_ASSERT_EQUAL_STRING(after.c_str(), config.c_str());
+
+    // Save finished, Temp File is gone.
+    TEST_ASSERT_EQUAL(0, files.count("/config.json.tmp"));
+    TEST_ASSERT_EQUAL_STRING(after.c_str(), files["/config.json"].c_str());
+}
+
+void test_everything_broken_restores_backup()
+{
+    files["/config.bin"] = "garbage";
+    files["/config.json"] = "";
+    files["/config.json.tmp"] = "{\"na";
+
+    TEST_ASSERT_EQUAL(CONFIG_BACKUP, boot());
+    TEST_ASSERT_EQUAL_STRING(factory.c_str(), config.c_str());
+    TEST_ASSERT_EQUAL_STRING(factory.c_str(), files["/config.json"].c_str());
+}
+
+void test_nothing_left()
+{
+    files.clear();
+
+    TEST_ASSERT_EQUAL(CONFIG_NONE, boot());
+}
+
+void test_header_checks()
+{
+    std::string buffer(sizeof(ConfigHeader), '\0');
+    buffer += "payload";
+    uint8_t* data = (uint8_t*)&buffer[0];
+
+    ConfigStore::writeHeader(data, 7);
+    TEST_ASSERT_TRUE(ConfigStore::checkHeader(data, buffer.size()));
+
+    // Truncated and extended Files.
+    TEST_ASSERT_FALSE(ConfigStore::checkHeader(data, buffer.size() - 1));
+    TEST_ASSERT_FALSE(ConfigStore::checkHeader(data, sizeof(ConfigHeader)));
+
+    // Wrong Magic and Schema.
+    ConfigHeader header;
+    memcpy(&header, data, sizeof(header));
+
+    header.magic++;
+    memcpy(data, &header, sizeof(header));
+    TEST_ASSERT_FALSE(ConfigStore::checkHeader(data, buffer.size()));
+
+    header.magic--;
+    header.schema++;
+    memcpy(data, &header, sizeof(header));
+    TEST_ASSERT_FALSE(ConfigStore::checkHeader(data, buffer.size()));
+}
+
+void test_crc32()
+{
+    // Check Value of CRC-32/ISO-HDLC (esp_rom_crc32_le).
+    TEST_ASSERT_EQUAL_HEX32(0xCBF43926, ConfigStore::crc32((const uint8_t*)"123456789", 9));
+    TEST_ASSERT_EQUAL_HEX32(0x00000000, ConfigStore::crc32(nullptr, 0));
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_store_and_load_binary);
+    RUN_TEST(test_power_loss_at_every_offset);
+    RUN_TEST(test_corrupt_binary_falls_back_to_json);
+    RUN_TEST(test_interrupted_rename_uses_temp);
+    RUN_TEST(test_everything_broken_restores_backup);
+    RUN_TEST(test_nothing_left);
+    RUN_TEST(test_header_checks);
+    RUN_TEST(test_crc32);
+    return UNITY_END();
+}
@@ -0,0 +1,157 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#include <string.h>
+#include <unity.h>
+
+#include "DumpReader.h"
+
+// Define fake Core Dump Partition (Flash Address and Size).
+#define PARTITION_ADDRESS 0x3F0000
+#define PARTITION_SIZE 0x10000
+
+// Store Partition Content and Read Statistics.
+uint8_t partition[PARTITION_SIZE];
+uint32_t reads = 0;
+uint32_t failAt = UINT32_MAX;
+
+bool readFlash(uint32_t offset, uint8_t* buffer, size_t length)
+{
+    // Reads beyond the Partition fail like esp_partition_read().
+    if (offset > PARTITION_SIZE || length > PARTITION_SIZE - offset)
+        return false;
+
+    if (reads++ == failAt)
+        return false;
+
+    memcpy(buffer, partition + offset, length);
+    return true;
+}
+
+/**
+ * Streams the Dump like the AsyncWebServer chunked Response does.
+ */
+size_t download(uint32_t offset, uint32_t size, size_t chunk, uint8_t* output)
+{
+    uint8_t buffer[4096];
+    size_t index = 0;
+
+    while (true)
+    {
+        size_t length = DumpReader::read(readFlash, offset, size, buffer, chunk, index);
+
+        if (length == 0)
+            break;
+
+        TEST_ASSERT_TRUE(length <= chunk);
+        memcpy(output + index, buffer, length);
+        index += length;
+    }
+
+    return index;
+}
+
+void setUp()
+{
+    for (uint32_t i = 0; i < PARTITION_SIZE; i++)
+    {
+        partition[i] = (uint8_t)(i * 31 + (i >> 8));
+    }
+
+    reads = 0;
+    failAt = UINT32_MAX;
+}
+
+void tearDown()
+{
+}
+
+void test_locate_inside_partition()
+{
+    uint32_t offset = 0;
+
+    TEST_ASSERT_TRUE(DumpReader::locate(PARTITION_ADDRESS, PARTITION_SIZE, PARTITION_ADDRESS + 0x20, 9476, &offset));
+    TEST_ASSERT_EQUAL(0x20, offset);
+
+    // Dump fills the Partition up to the last Byte.
+    TEST_ASSERT_TRUE(DumpReader::locate(PARTITION_ADDRESS, PARTITION_SIZE, PARTITION_ADDRESS, PARTITION_SIZE, &offset));
+    TEST_ASSERT_EQUAL(0, offset);
+}
+
+void test_locate_rejects_foreign_dump()
+{
+    uint32_t offset = 0;
+
+    TEST_ASSERT_FALSE(DumpReader::locate(PARTITION_ADDRESS, PARTITION_SIZE, PARTITION_ADDRESS - 1, 100, &offset));
+    TEST_ASSERT_FALSE(DumpReader::locate(PARTITION_ADDRESS, PARTITION_SIZE, PARTITION_ADDRESS + 1, PARTITION_SIZE, &offset));
+    TEST_ASSERT_FALSE(DumpReader::locate(PARTITION_ADDRESS, PARTITION_SIZE, PARTITION_ADDRESS + PARTITION_SIZE, 1, &offset));
+    TEST_ASSERT_FALSE(DumpReader::locate(PARTITION_ADDRESS, PARTITION_SIZE, PARTITION_ADDRESS, 0, &offset));
+
+    // start + size would overflow 32 Bit.
+    TEST_ASSERT_FALSE(DumpReader::locate(PARTITION_ADDRESS, PARTITION_SIZE, PARTITION_ADDRESS + 0x100, UINT32_MAX, &offset));
+}
+
+void test_stream_every_chunk_size()
+{
+    static uint8_t output[PARTITION_SIZE];
+    const uint32_t offset = 0x1234;
+    const uint32_t size = 9476;
+
+    for (size_t chunk = 1; chunk <= 4096; chunk = chunk * 3 + 1)
+    {
+        memset(output, 0, sizeof(output));
+
+        TEST_ASSERT_EQUAL(size, download(offset, size, chunk, output));
+        TEST_ASSERT_EQUAL_MEMORY(partition + offset, output, size);
+    }
+}
+
+void test_stream_up_to_partition_end()
+{
+    static uint8_t output[PARTITION_SIZE];
+    uint32_t offset;
+
+    TEST_ASSERT_TRUE(DumpReader::locate(PARTITION_ADDRESS, PARTITION_SIZE, PARTITION_ADDRESS + PARTITION_SIZE - 1000, 1000, &offset));
+    TEST_ASSERT_EQUAL(1000, download(offset, 1000, 1460, output));
+    TEST_ASSERT_EQUAL_MEMORY(partition + PARTITION_SIZE - 1000, output, 1000);
+}
+
+void test_chunk_after_end_is_empty()
+{
+    uint8_t buffer[16];
+
+    TEST_ASSERT_EQUAL(0, DumpReader::read(readFlash, 0, 100, buffer, sizeof(buffer), 100));
+    TEST_ASSERT_EQUAL(0, DumpReader::read(readFlash, 0, 100, buffer, sizeof(buffer), 200));
+    TEST_ASSERT_EQUAL(0, reads);
+}
+
+void test_last_chunk_is_shortened()
+{
+    uint8_t buffer[64];
+
+    TEST_ASSERT_EQUAL(36, DumpReader::read(readFlash, 0x100, 100, buffer, sizeof(buffer), 64));
+    TEST_ASSERT_EQUAL_MEMORY(partition + 0x100 + 64, buffer, 36);
+}
+
+void test_read_error_ends_stream()
+{
+    static uint8_t output[PARTITION_SIZE];
+
+    failAt = 2;
+
+    TEST_ASSERT_EQUAL(2 * 512, download(0, 4096, 512, output));
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_locate_inside_partition);
+    RUN_TEST(test_locate_rejects_foreign_dump);
+    RUN_TEST(test_stream_every_chunk_size);
+    RUN_TEST(test_stream_up_to_partition_end);
+    RUN_TEST(test_chunk_after_end_is_empty);
+    RUN_TEST(test_last_chunk_is_shortened);
+    RUN_TEST(test_read_error_ends_stream);
+    return UNITY_END();
+}
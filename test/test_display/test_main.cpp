@@ -0,0 +1,263 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#include <stdio.h>
+#include <string.h>
+#include <unity.h>
+
+#include "FrameDiff.h"
+#include "InternalConfig.h"
+
+// Define Bytes per Page and Frame.
+#define PAGE_SIZE OLED_WIDTH
+#define FRAME_SIZE (OLED_WIDTH * OLED_HEIGHT / 8)
+
+// Define Data Bytes per I2C Transmission (I2C_BUFFER_LENGTH of the ESP32 Core - Control Byte).
+#define CHUNK 127
+
+// Define I2C Bytes of a Command (Address, Control, Command) and the Overhead of a Data Chunk (Address, Control).
+#define COMMAND_BYTES 3
+#define CHUNK_BYTES 2
+
+/**
+ * Mocks the SSD1306 Display RAM (Horizontal Addressing Mode) and counts the
+ * Bytes on the I2C Bus.
+ */
+uint8_t ram[FRAME_SIZE];
+uint8_t pending[3];
+uint8_t pendingCount = 0;
+uint8_t pageStart, pageEnd, columnStart, columnEnd, page, column;
+uint32_t busBytes = 0;
+uint32_t transmissions = 0;
+
+void command(uint8_t value)
+{
+    busBytes += COMMAND_BYTES;
+    transmissions++;
+
+    pending[pendingCount++] = value;
+
+    if (pending[0] == FRAME_PAGEADDR && pendingCount == 3)
+    {
+        pageStart = page = pending[1];
+        pageEnd = pending[2];
+        pendingCount = 0;
+    }
+    else if (pending[0] == FRAME_COLUMNADDR && pendingCount == 3)
+    {
+        columnStart = column = pending[1];
+        columnEnd = pending[2];
+        pendingCount = 0;
+    }
+}
+
+void data(const uint8_t* bytes, size_t length)
+{
+    TEST_ASSERT_TRUE(length <= CHUNK);
+
+    busBytes += CHUNK_BYTES + length;
+    transmissions++;
+
+    for (size_t i = 0; i < length; i++)
+    {
+        ram[page * PAGE_SIZE + column] = bytes[i];
+
+        // Wrap inside the Address Window.
+        if (column++ == columnEnd)
+        {
+            column = columnStart;
+            page = (page == pageEnd) ? pageStart : page + 1;
+        }
+    }
+}
+
+const DisplayBus bus = {command, data, CHUNK};
+
+// Store rendered Framebuffer.
+uint8_t frame[FRAME_SIZE];
+
+/**
+ * Draws a 6 Pixel wide Glyph of a Digit into a Page (5x7 Font plus Spacing).
+ */
+void drawDigit(uint8_t targetPage, uint8_t targetColumn, uint8_t digit, int8_t shift = 0)
+{
+    for (uint8_t i = 0; i < 5; i++)
+    {
+        frame[targetPage * PAGE_SIZE + targetColumn + shift + i] = (uint8_t)(0x3E ^ (digit * 7 + i * 13));
+    }
+}
+
+/**
+ * Renders a typical Status Screen: Level, Volume, Voltage and Relais Lines
+ * of four Digits each and a Tank filled to `level` %.
+ */
+void render(const uint16_t values[4], uint8_t level, int8_t shift = 0)
+{
+    memset(frame, 0, sizeof(frame));
+
+    for (uint8_t line = 0; line < 4; line++)
+    {
+        uint16_t value = values[line];
+
+        for (uint8_t i = 0; i < 4; i++)
+        {
+            drawDigit(line * 2, 40 + (3 - i) * 6, value % 10, shift);
+            value /= 10;
+        }
+    }
+
+    // Tank Outline with Filling (Bottom Pages, Columns 100..119).
+    for (uint8_t page = 0; page < 8; page++)
+    {
+        frame[page * PAGE_SIZE + 100 + shift] = 0xFF;
+        frame[page * PAGE_SIZE + 119 + shift] = 0xFF;
+
+        uint8_t filled = (level * 64 / 100);
+        uint8_t top = 64 - filled;
+
+        for (uint8_t x = 101; x < 119; x++)
+        {
+            uint8_t bits = 0;
+
+            for (uint8_t bit = 0; bit < 8; bit++)
+            {
+                if (page * 8 + bit >= top)
+                    bits |= (1 << bit);
+            }
+
+            frame[page * PAGE_SIZE + x + shift] = bits;
+        }
+    }
+}
+
+/**
+ * Flushes the Frame and checks the Display RAM against it.
+ *
+ * @return The I2C Bytes of the Flush.
+ */
+uint32_t flush(const char* name)
+{
+    busBytes = 0;
+    transmissions = 0;
+
+    uint32_t bytes = FrameDiff::flush(bus, frame);
+
+    TEST_ASSERT_EQUAL_MEMORY(frame, ram, FRAME_SIZE);
+
+    if (name == nullptr)
+        return busBytes;
+
+    // 9 Clocks per Byte at 400 kHz.
+    char message[128];
+    snprintf(message, sizeof(message), "%s: %u Data Bytes, %u I2C Bytes in %u Transmissions, %u us",
+             name, bytes, busBytes, transmissions, busBytes * 9 * 10 / 4);
+    TEST_MESSAGE(message);
+
+    return busBytes;
+}
+
+/**
+ * I2C Bytes of `display.display()` (Adafruit SSD1306): Address Window as one
+ * Command List, then the whole Framebuffer.
+ */
+uint32_t getFullRefresh()
+{
+    return 2 + 6 + FRAME_SIZE + ((FRAME_SIZE + CHUNK - 1) / CHUNK) * CHUNK_BYTES;
+}
+
+const uint16_t values[4] = {423, 4230, 1875, 1};
+
+void setUp()
+{
+    memset(ram, 0xA5, sizeof(ram));
+    FrameDiff::invalidate();
+
+    // First Frame after Boot.
+    render(values, 42);
+    flush(nullptr);
+}
+
+void tearDown()
+{
+}
+
+void test_first_frame_is_complete()
+{
+    memset(ram, 0xA5, sizeof(ram));
+    FrameDiff::invalidate();
+
+    uint32_t bytes = flush("Full");
+
+    TEST_ASSERT_EQUAL(8 * 6 * COMMAND_BYTES + FRAME_SIZE + 8 * 2 * CHUNK_BYTES, bytes);
+}
+
+void test_unchanged_frame_is_skipped()
+{
+    render(values, 42);
+
+    TEST_ASSERT_EQUAL(0, flush("Unchanged"));
+    TEST_ASSERT_EQUAL(0, transmissions);
+}
+
+void test_one_digit_sends_one_window()
+{
+    const uint16_t changed[4] = {424, 4230, 1875, 1};
+
+    render(changed, 42);
+
+    // Address Window (6 Commands) and the 5 Columns of the Glyph.
+    TEST_ASSERT_EQUAL(6 * COMMAND_BYTES + CHUNK_BYTES + 5, flush("Digit"));
+}
+
+void test_typical_update_is_below_fifth()
+{
+    const uint16_t changed[4] = {431, 4310, 1891, 1};
+
+    render(changed, 43);
+
+    // Three Lines and the Tank Level change.
+    TEST_ASSERT_LESS_THAN(getFullRefresh() / 5, flush("Level"));
+}
+
+void test_pixel_shift_stays_below_full_refresh()
+{
+    render(values, 42, 1);
+
+    TEST_ASSERT_LESS_THAN(getFullRefresh(), flush("Shift"));
+}
+
+void test_find_range()
+{
+    uint8_t row[PAGE_SIZE] = {};
+    uint8_t shadow[PAGE_SIZE] = {};
+    uint8_t first;
+    uint8_t last;
+
+    TEST_ASSERT_FALSE(FrameDiff::findRange(row, shadow, &first, &last));
+
+    row[0] = 1;
+    row[OLED_WIDTH - 1] = 1;
+
+    TEST_ASSERT_TRUE(FrameDiff::findRange(row, shadow, &first, &last));
+    TEST_ASSERT_EQUAL(0, first);
+    TEST_ASSERT_EQUAL(OLED_WIDTH - 1, last);
+
+    row[0] = 0;
+
+    TEST_ASSERT_TRUE(FrameDiff::findRange(row, shadow, &first, &last));
+    TEST_ASSERT_EQUAL(OLED_WIDTH - 1, first);
+    TEST_ASSERT_EQUAL(OLED_WIDTH - 1, last);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_first_frame_is_complete);
+    RUN_TEST(test_unchanged_frame_is_skipped);
+    RUN_TEST(test_one_digit_sends_one_window);
+    RUN_TEST(test_typical_update_is_below_fifth);
+    RUN_TEST(test_pixel_shift_stays_below_full_refresh);
+    RUN_TEST(test_find_range);
+    return UNITY_END();
+}
@@ -0,0 +1,293 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#include <unity.h>
+
+#include "RelaisArbiter.h"
+
+#define FILL 0
+#define EMPTY 1
+#define MIXER 2
+
+#define BIT(index) (1UL << (index))
+
+// Define Start Gap of the Tests (µs).
+#define GAP 500000
+
+// Store current Time, every Test starts far behind the previous one.
+int64_t now = 0;
+
+uint32_t conflicts;
+int64_t wait;
+
+void setUp()
+{
+    now += 3600000000LL;
+
+    RelaisArbiter::reset(GAP);
+
+    for (uint8_t i = 0; i < RELAIS_COUNT; i++)
+    {
+        RelaisArbiter::release(i);
+    }
+
+    // Fill and Empty Pump must never run together, Empty wins.
+    RelaisArbiter::setPriority(FILL, 1);
+    RelaisArbiter::setPriority(EMPTY, 2);
+    RelaisArbiter::addInterlock(BIT(FILL) | BIT(EMPTY));
+}
+
+void tearDown()
+{
+}
+
+uint8_t request(uint8_t index, uint8_t source)
+{
+    return RelaisArbiter::request(index, source, now, &conflicts, &wait);
+}
+
+void test_matrix_is_symmetric()
+{
+    TEST_ASSERT_EQUAL(RELAIS_STARTED, request(EMPTY, RELAIS_MANUAL));
+    now += GAP;
+    TEST_ASSERT_EQUAL(RELAIS_DENIED, request(FILL, RELAIS_AUTO));
+    TEST_ASSERT_EQUAL(BIT(EMPTY), RelaisArbiter::getActive());
+}
+
+void test_manual_never_preempts_automation()
+{
+    TEST_ASSERT_EQUAL(RELAIS_STARTED, request(FILL, RELAIS_AUTO));
+    now += GAP;
+
+    // Empty has the higher Priority but is only a manual Command.
+    TEST_ASSERT_EQUAL(RELAIS_DENIED, request(EMPTY, RELAIS_MANUAL));
+    TEST_ASSERT_EQUAL(0, conflicts);
+    TEST_ASSERT_EQUAL(BIT(FILL), RelaisArbiter::getActive());
+}
+
+void test_automation_preempts_lower_priority()
+{
+    TEST_ASSERT_EQUAL(RELAIS_STARTED, request(FILL, RELAIS_MANUAL));
+    now += GAP;
+
+    TEST_ASSERT_EQUAL(RELAIS_STARTED, request(EMPTY, RELAIS_AUTO));
+    TEST_ASSERT_EQUAL(BIT(FILL), conflicts);
+    TEST_ASSERT_EQUAL(BIT(EMPTY), RelaisArbiter::getActive());
+}
+
+void test_manual_preempts_lower_manual()
+{
+    TEST_ASSERT_EQUAL(RELAIS_STARTED, request(FILL, RELAIS_MANUAL));
+    now += GAP;
+
+    TEST_ASSERT_EQUAL(RELAIS_STARTED, request(EMPTY, RELAIS_MANUAL));
+    TEST_ASSERT_EQUAL(BIT(FILL), conflicts);
+}
+
+void test_equal_priority_keeps_running_channel()
+{
+    RelaisArbiter::setPriority(FILL, 2);
+
+    TEST_ASSERT_EQUAL(RELAIS_STARTED, request(FILL, RELAIS_MANUAL));
+    now += GAP;
+    TEST_ASSERT_EQUAL(RELAIS_DENIED, request(EMPTY, RELAIS_AUTO));
+    TEST_ASSERT_EQUAL(BIT(FILL), RelaisArbiter::getActive());
+}
+
+void test_automation_takes_over_manual_channel()
+{
+    TEST_ASSERT_EQUAL(RELAIS_STARTED, request(FILL, RELAIS_MANUAL));
+    TEST_ASSERT_EQUAL(RELAIS_ALREADY, request(FILL, RELAIS_AUTO));
+    now += GAP;
+
+    // Fill is held by the Automation now.
+    TEST_ASSERT_EQUAL(RELAIS_DENIED, request(EMPTY, RELAIS_MANUAL));
+}
+
+void test_release_ends_automation_hold()
+{
+    TEST_ASSERT_EQUAL(RELAIS_STARTED, request(FILL, RELAIS_AUTO));
+    TEST_ASSERT_TRUE(RelaisArbiter::release(FILL));
+    now += GAP;
+    TEST_ASSERT_EQUAL(RELAIS_STARTED, request(FILL, RELAIS_MANUAL));
+    now += GAP;
+
+    TEST_ASSERT_EQUAL(RELAIS_STARTED, request(EMPTY, RELAIS_MANUAL));
+}
+
+void test_start_inside_gap_is_queued()
+{
+    TEST_ASSERT_EQUAL(RELAIS_STARTED, request(MIXER, RELAIS_MANUAL));
+
+    now += 100000;
+    TEST_ASSERT_EQUAL(RELAIS_QUEUED, request(FILL, RELAIS_AUTO));
+    TEST_ASSERT_EQUAL(GAP - 100000, wait);
+    TEST_ASSERT_EQUAL(BIT(MIXER) | BIT(FILL), RelaisArbiter::getActive());
+
+    now += wait;
+    TEST_ASSERT_EQUAL(FILL, RelaisArbiter::startNext(now));
+    TEST_ASSERT_FALSE(RelaisArbiter::hasPending());
+    TEST_ASSERT_EQUAL(-1, RelaisArbiter::startNext(now));
+}
+
+void test_queued_start_waits_for_pending()
+{
+    TEST_ASSERT_EQUAL(RELAIS_STARTED, request(MIXER, RELAIS_MANUAL));
+    TEST_ASSERT_EQUAL(RELAIS_QUEUED, request(FILL, RELAIS_MANUAL));
+
+    // Gap has passed, but a Channel is still waiting in Front.
+    now += 2 * GAP;
+    RelaisArbiter::release(MIXER);
+    TEST_ASSERT_EQUAL(RELAIS_QUEUED, request(MIXER, RELAIS_MANUAL));
+    TEST_ASSERT_EQUAL(0, wait);
+}
+
+void test_pending_starts_by_priority()
+{
+    RelaisArbiter::reset(GAP);
+    RelaisArbiter::setPriority(MIXER, 3);
+    RelaisArbiter::setPriority(EMPTY, 2);
+
+    TEST_ASSERT_EQUAL(RELAIS_STARTED, request(FILL, RELAIS_MANUAL));
+    TEST_ASSERT_EQUAL(RELAIS_QUEUED, request(EMPTY, RELAIS_MANUAL));
+    TEST_ASSERT_EQUAL(RELAIS_QUEUED, request(MIXER, RELAIS_MANUAL));
+
+    now += GAP;
+    TEST_ASSERT_EQUAL(MIXER, RelaisArbiter::startNext(now));
+    TEST_ASSERT_TRUE(RelaisArbiter::hasPending());
+
+    now += GAP;
+    TEST_ASSERT_EQUAL(EMPTY, RelaisArbiter::startNext(now));
+    TEST_ASSERT_FALSE(RelaisArbiter::hasPending());
+}
+
+void test_preemption_cancels_pending_start()
+{
+    TEST_ASSERT_EQUAL(RELAIS_STARTED, request(MIXER, RELAIS_MANUAL));
+    TEST_ASSERT_EQUAL(RELAIS_QUEUED, request(FILL, RELAIS_MANUAL));
+    TEST_ASSERT_EQUAL(RELAIS_QUEUED, request(EMPTY, RELAIS_AUTO));
+    TEST_ASSERT_EQUAL(BIT(FILL), conflicts);
+
+    now += GAP;
+    TEST_ASSERT_EQUAL(EMPTY, RelaisArbiter::startNext(now));
+    TEST_ASSERT_FALSE(RelaisArbiter::hasPending());
+    TEST_ASSERT_EQUAL(BIT(MIXER) | BIT(EMPTY), RelaisArbiter::getActive());
+}
+
+void test_preempted_channel_stops_its_run()
+{
+    TEST_ASSERT_EQUAL(RELAIS_STARTED, request(FILL, RELAIS_MANUAL));
+    now += GAP;
+
+    TEST_ASSERT_EQUAL(RELAIS_STARTED, request(EMPTY, RELAIS_AUTO));
+    TEST_ASSERT_EQUAL(BIT(FILL), conflicts);
+
+    // Fill was running, so the Stats see its Stop once, and the next Start is a new Run.
+    TEST_ASSERT_TRUE(RelaisArbiter::release(FILL));
+    TEST_ASSERT_FALSE(RelaisArbiter::release(FILL));
+    TEST_ASSERT_EQUAL(BIT(EMPTY), RelaisArbiter::getActive());
+}
+
+void test_preempted_pending_channel_was_not_running()
+{
+    TEST_ASSERT_EQUAL(RELAIS_STARTED, request(MIXER, RELAIS_MANUAL));
+    TEST_ASSERT_EQUAL(RELAIS_QUEUED, request(FILL, RELAIS_MANUAL));
+    TEST_ASSERT_EQUAL(RELAIS_QUEUED, request(EMPTY, RELAIS_AUTO));
+    TEST_ASSERT_EQUAL(BIT(FILL), conflicts);
+
+    TEST_ASSERT_FALSE(RelaisArbiter::release(FILL));
+}
+
+void test_release_of_pending_channel()
+{
+    TEST_ASSERT_EQUAL(RELAIS_STARTED, request(MIXER, RELAIS_MANUAL));
+    TEST_ASSERT_EQUAL(RELAIS_QUEUED, request(FILL, RELAIS_MANUAL));
+
+    TEST_ASSERT_FALSE(RelaisArbiter::release(FILL));
+    TEST_ASSERT_FALSE(RelaisArbiter::hasPending());
+    TEST_ASSERT_EQUAL(BIT(MIXER), RelaisArbiter::getActive());
+}
+
+void test_reset_keeps_running_channels()
+{
+    TEST_ASSERT_EQUAL(RELAIS_STARTED, request(FILL, RELAIS_AUTO));
+
+    RelaisArbiter::reset(GAP);
+    TEST_ASSERT_EQUAL(BIT(FILL), RelaisArbiter::getActive());
+}
+
+/**
+ * Feeds random Commands of both Sources and checks after every Step that
+ * interlocked Channels are never on together and Starts keep the Gap.
+ */
+void test_random_commands_keep_invariants()
+{
+    uint32_t seed = 12345;
+    int64_t lastStart = INT64_MIN / 2;
+    uint32_t running = 0;
+
+    for (int step = 0; step < 20000; step++)
+    {
+        seed = seed * 1103515245 + 12345;
+        uint8_t index = (seed >> 16) % RELAIS_COUNT;
+        uint8_t action = (seed >> 8) % 4;
+
+        now += (seed >> 4) % (GAP / 2);
+
+        if (action == 0)
+        {
+            RelaisArbiter::release(index);
+            running &= ~BIT(index);
+        }
+        else if (action == 3 && now - lastStart >= GAP)
+        {
+            // Stagger Timer fires one Gap after the last Start.
+            int8_t next = RelaisArbiter::startNext(now);
+
+            if (next >= 0)
+            {
+                lastStart = now;
+                running |= BIT(next);
+            }
+        }
+        else if (action != 3)
+        {
+            uint8_t result = request(index, action == 1 ? RELAIS_MANUAL : RELAIS_AUTO);
+            running &= ~conflicts;
+
+            if (result == RELAIS_STARTED)
+            {
+                TEST_ASSERT_TRUE(now - lastStart >= GAP);
+                lastStart = now;
+                running |= BIT(index);
+            }
+        }
+
+        uint32_t active = RelaisArbiter::getActive();
+        TEST_ASSERT_EQUAL_HEX32(running, active & running);
+        TEST_ASSERT_NOT_EQUAL(BIT(FILL) | BIT(EMPTY), active & (BIT(FILL) | BIT(EMPTY)));
+    }
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_matrix_is_symmetric);
+    RUN_TEST(test_manual_never_preempts_automation);
+    RUN_TEST(test_automation_preempts_lower_priority);
+    RUN_TEST(test_manual_preempts_lower_manual);
+    RUN_TEST(test_equal_priority_keeps_running_channel);
+    RUN_TEST(test_automation_takes_over_manual_channel);
+    RUN_TEST(test_release_ends_automation_hold);
+    RUN_TEST(test_start_inside_gap_is_queued);
+    RUN_TEST(test_queued_start_waits_for_pending);
+    RUN_TEST(test_pending_starts_by_priority);
+    RUN_TEST(test_preemption_cancels_pending_start);
+    RUN_TEST(test_preempted_channel_stops_its_run);
+    RUN_TEST(test_preempted_pending_channel_was_not_running);
+    RUN_TEST(test_release_of_pending_channel);
+    RUN_TEST(test_reset_keeps_running_channels);
+    RUN_TEST(test_random_commands_keep_invariants);
+    return UNITY_END();
+}
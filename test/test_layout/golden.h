@@ -0,0 +1,140 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+// Golden Images of the builtin Layouts (Values of setUp(), Characters as 5x7 Blocks).
+// Status Screen (Level 42%, Tank filled up to Row 41).
+const char* const goldenDefault[OLED_HEIGHT] = {
+    "#####.#####.#####.#####.#####.#####.#####.#####.#####...........................................................................",
+    "#####.#####.#####.#####.#####.#####.#####.#####.#####...........................................................................",
+    "#####.#####.#####.#####.#####.#####.#####.#####.#####...........................................................................",
+    "#####.#####.#####.#####.#####.#####.#####.#####.#####...........................................................................",
+    "#####.#####.#####.#####.#####.#####.#####.#####.#####...........................................................................",
+    "#####.#####.#####.#####.#####.#####.#####.#####.#####...........................................................................",
+    "#####.#####.#####.#####.#####.#####.#####.#####.#####...........................................................................",
+    "................................................................................................................................",
+    "................................................................................................................................",
+    "################################################################################################################################",
+    "................................................................................................................................",
+    "................................................................................................................................",
+    "................................................................................................................................",
+    "................................................................................................................................",
+    "................................................................................................................................",
+    "................................................................................................................................",
+    "................................................................................................................................",
+    "................................................................................................................................",
+    "#####.#####.#####.#####.#####.......#####.#####................................................##############################...",
+    "#####.#####.#####.#####.#####.......#####.#####................................................#............................#...",
+    "#####.#####.#####.#####.#####.......#####.#####................................................#............................#...",
+    "#####.#####.#####.#####.#####.......#####.#####................................................#............................#...",
+    "#####.#####.#####.#####.#####.......#####.#####................................................#............................#...",
+    "#####.#####.#####.#####.#####.......#####.#####................................................#............................#...",
+    "#####.#####.#####.#####.#####.......#####.#####................................................#............................#...",
+    "...............................................................................................#............................#...",
+    "#####.#####.#####.#####.#####.#####.......#####.#####.#####.#####.#####........................#............................#...",
+    "#####.#####.#####.#####.#####.#####.......#####.#####.#####.#####.#####........................#............................#...",
+    "#####.#####.#####.#####.#####.#####.......#####.#####.#####.#####.#####........................#............................#...",
+    "#####.#####.#####.#####.#####.#####.......#####.#####.#####.#####.#####........................#............................#...",
+    "#####.#####.#####.#####.#####.#####.......#####.#####.#####.#####.#####........................#............................#...",
+    "#####.#####.#####.#####.#####.#####.......#####.#####.#####.#####.#####........................#............................#...",
+    "#####.#####.#####.#####.#####.#####.......#####.#####.#####.#####.#####........................#............................#...",
+    "...............................................................................................#............................#...",
+    "#####.#####.#####.#####.#####.#####.#####.......#####.#####.#####.#####.#####.#####............#............................#...",
+    "#####.#####.#####.#####.#####.#####.#####.......#####.#####.#####.#####.#####.#####............#............................#...",
+    "#####.#####.#####.#####.#####.#####.#####.......#####.#####.#####.#####.#####.#####............#............................#...",
+    "#####.#####.#####.#####.#####.#####.#####.......#####.#####.#####.#####.#####.#####............#............................#...",
+    "#####.#####.#####.#####.#####.#####.#####.......#####.#####.#####.#####.#####.#####............#............................#...",
+    "#####.#####.#####.#####.#####.#####.#####.......#####.#####.#####.#####.#####.#####............#............................#...",
+    "#####.#####.#####.#####.#####.#####.#####.......#####.#####.#####.#####.#####.#####............#............................#...",
+    "...............................................................................................#.##########################.#...",
+    "#####.#####.#####.#####.......#####.#####.#####.#####.#####....................................#.##########################.#...",
+    "#####.#####.#####.#####.......#####.#####.#####.#####.#####....................................#.##########################.#...",
+    "#####.#####.#####.#####.......#####.#####.#####.#####.#####....................................#.##########################.#...",
+    "#####.#####.#####.#####.......#####.#####.#####.#####.#####....................................#.##########################.#...",
+    "#####.#####.#####.#####.......#####.#####.#####.#####.#####....................................#.##########################.#...",
+    "#####.#####.#####.#####.......#####.#####.#####.#####.#####....................................#.##########################.#...",
+    "#####.#####.#####.#####.......#####.#####.#####.#####.#####....................................#.##########################.#...",
+    "...............................................................................................#.##########################.#...",
+    "#####.#####.#####.#####.#####.#####.#####.#####.......#####.#####.#####.#####.#####.#####.######.##########################.#...",
+    "#####.#####.#####.#####.#####.#####.#####.#####.......#####.#####.#####.#####.#####.#####.######.##########################.#...",
+    "#####.#####.#####.#####.#####.#####.#####.#####.......#####.#####.#####.#####.#####.#####.######.##########################.#...",
+    "#####.#####.#####.#####.#####.#####.#####.#####.......#####.#####.#####.#####.#####.#####.######.##########################.#...",
+    "#####.#####.#####.#####.#####.#####.#####.#####.......#####.#####.#####.#####.#####.#####.######.##########################.#...",
+    "#####.#####.#####.#####.#####.#####.#####.#####.......#####.#####.#####.#####.#####.#####.######.##########################.#...",
+    "#####.#####.#####.#####.#####.#####.#####.#####.......#####.#####.#####.#####.#####.#####.######............................#...",
+    "...............................................................................................##############################...",
+    "................................................................................................................................",
+    "................................................................................................................................",
+    "................................................................................................................................",
+    "................................................................................................................................",
+    "................................................................................................................................",
+    "................................................................................................................................"
+};
+
+// Debug Screen.
+const char* const goldenDebug[OLED_HEIGHT] = {
+    "#####.#####.#####.#####.#####...................................................................................................",
+    "#####.#####.#####.#####.#####...................................................................................................",
+    "#####.#####.#####.#####.#####...................................................................................................",
+    "#####.#####.#####.#####.#####...................................................................................................",
+    "#####.#####.#####.#####.#####...................................................................................................",
+    "#####.#####.#####.#####.#####...................................................................................................",
+    "#####.#####.#####.#####.#####...................................................................................................",
+    "................................................................................................................................",
+    "................................................................................................................................",
+    "################################################################################################################################",
+    "................................................................................................................................",
+    "................................................................................................................................",
+    "................................................................................................................................",
+    "................................................................................................................................",
+    "................................................................................................................................",
+    "................................................................................................................................",
+    "................................................................................................................................",
+    "................................................................................................................................",
+    "#####.#####.#####.#####.#####.......#####.#####.#####.#####.#####.#####.........................................................",
+    "#####.#####.#####.#####.#####.......#####.#####.#####.#####.#####.#####.........................................................",
+    "#####.#####.#####.#####.#####.......#####.#####.#####.#####.#####.#####.........................................................",
+    "#####.#####.#####.#####.#####.......#####.#####.#####.#####.#####.#####.........................................................",
+    "#####.#####.#####.#####.#####.......#####.#####.#####.#####.#####.#####.........................................................",
+    "#####.#####.#####.#####.#####.......#####.#####.#####.#####.#####.#####.........................................................",
+    "#####.#####.#####.#####.#####.......#####.#####.#####.#####.#####.#####.........................................................",
+    "................................................................................................................................",
+    "#####.#####.#####.#####.............#####.#####.#####.#####.#####.#####.........................................................",
+    "#####.#####.#####.#####.............#####.#####.#####.#####.#####.#####.........................................................",
+    "#####.#####.#####.#####.............#####.#####.#####.#####.#####.#####.........................................................",
+    "#####.#####.#####.#####.............#####.#####.#####.#####.#####.#####.........................................................",
+    "#####.#####.#####.#####.............#####.#####.#####.#####.#####.#####.........................................................",
+    "#####.#####.#####.#####.............#####.#####.#####.#####.#####.#####.........................................................",
+    "#####.#####.#####.#####.............#####.#####.#####.#####.#####.#####.........................................................",
+    "................................................................................................................................",
+    "#####.#####.#####.#####.#####.#####.......#####.#####.#####.#####.#####.#####...................................................",
+    "#####.#####.#####.#####.#####.#####.......#####.#####.#####.#####.#####.#####...................................................",
+    "#####.#####.#####.#####.#####.#####.......#####.#####.#####.#####.#####.#####...................................................",
+    "#####.#####.#####.#####.#####.#####.......#####.#####.#####.#####.#####.#####...................................................",
+    "#####.#####.#####.#####.#####.#####.......#####.#####.#####.#####.#####.#####...................................................",
+    "#####.#####.#####.#####.#####.#####.......#####.#####.#####.#####.#####.#####...................................................",
+    "#####.#####.#####.#####.#####.#####.......#####.#####.#####.#####.#####.#####...................................................",
+    "................................................................................................................................",
+    "#####.#####.#####.#####.#####.#####.......#####.#####.#####.#####.#####.........................................................",
+    "#####.#####.#####.#####.#####.#####.......#####.#####.#####.#####.#####.........................................................",
+    "#####.#####.#####.#####.#####.#####.......#####.#####.#####.#####.#####.........................................................",
+    "#####.#####.#####.#####.#####.#####.......#####.#####.#####.#####.#####.........................................................",
+    "#####.#####.#####.#####.#####.#####.......#####.#####.#####.#####.#####.........................................................",
+    "#####.#####.#####.#####.#####.#####.......#####.#####.#####.#####.#####.........................................................",
+    "#####.#####.#####.#####.#####.#####.......#####.#####.#####.#####.#####.........................................................",
+    "................................................................................................................................",
+    "#####.#####.#####.#####.#####.#####.......#####.#####.#####.#####.#####.........................................................",
+    "#####.#####.#####.#####.#####.#####.......#####.#####.#####.#####.#####.........................................................",
+    "#####.#####.#####.#####.#####.#####.......#####.#####.#####.#####.#####.........................................................",
+    "#####.#####.#####.#####.#####.#####.......#####.#####.#####.#####.#####.........................................................",
+    "#####.#####.#####.#####.#####.#####.......#####.#####.#####.#####.#####.........................................................",
+    "#####.#####.#####.#####.#####.#####.......#####.#####.#####.#####.#####.........................................................",
+    "#####.#####.#####.#####.#####.#####.......#####.#####.#####.#####.#####.........................................................",
+    "................................................................................................................................",
+    "................................................................................................................................",
+    "................................................................................................................................",
+    "................................................................................................................................",
+    "................................................................................................................................",
+    "................................................................................................................................",
+    "................................................................................................................................"
+};
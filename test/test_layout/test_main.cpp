@@ -0,0 +1,300 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#include <ArduinoJson.h>
+#include <fstream>
+#include <math.h>
+#include <sstream>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <unity.h>
+
+#include "InternalConfig.h"
+#include "LayoutEngine.h"
+
+/**
+ * Framebuffer Canvas with the Text Metrics of the Adafruit classic Font
+ * (6x8 Cells, Wrap at the right Edge). Characters are drawn as 5x7 Blocks,
+ * so the Golden Images check Positions and Bindings, not the Glyphs.
+ */
+bool pixels[OLED_HEIGHT][OLED_WIDTH];
+int16_t cursorX;
+int16_t cursorY;
+
+// Store bound Values (Index = BIND_*).
+float values[BIND_STACK + 1];
+
+// Store printed Text of the last Frame.
+std::string printed;
+
+void setPixel(int16_t x, int16_t y, uint8_t color)
+{
+    if (x >= 0 && x < OLED_WIDTH && y >= 0 && y < OLED_HEIGHT)
+        pixels[y][x] = color != 0;
+}
+
+void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint8_t color)
+{
+    for (int16_t row = y; row < y + h; row++)
+    {
+        for (int16_t column = x; column < x + w; column++)
+        {
+            setPixel(column, row, color);
+        }
+    }
+}
+
+void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint8_t color)
+{
+    fillRect(x, y, w, 1, color);
+    fillRect(x, y + h - 1, w, 1, color);
+    fillRect(x, y, 1, h, color);
+    fillRect(x + w - 1, y, 1, h, color);
+}
+
+void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t color)
+{
+    int16_t dx = abs(x1 - x0);
+    int16_t dy = -abs(y1 - y0);
+    int16_t sx = x0 < x1 ? 1 : -1;
+    int16_t sy = y0 < y1 ? 1 : -1;
+    int16_t error = dx + dy;
+
+    while (true)
+    {
+        setPixel(x0, y0, color);
+
+        if (x0 == x1 && y0 == y1)
+            break;
+
+        if (2 * error >= dy)
+        {
+            error += dy;
+            x0 += sx;
+        }
+
+        if (2 * error <= dx)
+        {
+            error += dx;
+            y0 += sy;
+        }
+    }
+}
+
+void setCursor(int16_t x, int16_t y)
+{
+    cursorX = x;
+    cursorY = y;
+}
+
+void newline()
+{
+    cursorX = 0;
+    cursorY += 8;
+    printed += '\n';
+}
+
+void print(const char* text)
+{
+    printed += text;
+
+    for (; *text != '\0'; text++)
+    {
+        if (cursorX + 6 > OLED_WIDTH)
+        {
+            cursorX = 0;
+            cursorY += 8;
+        }
+
+        if (*text != ' ')
+            fillRect(cursorX, cursorY, 5, 7, 1);
+
+        cursorX += 6;
+    }
+}
+
+float getBinding(uint8_t binding)
+{
+    return values[binding];
+}
+
+const LayoutCanvas canvas = {setCursor, print, newline, drawLine, drawRect, fillRect, getBinding};
+
+/**
+ * Compiles a Layout and renders one Frame.
+ */
+bool renderLayout(const char* layout, int16_t shift = 0)
+{
+    JsonDocument doc;
+
+    if (deserializeJson(doc, layout) || !LayoutEngine::compile(doc.as<JsonArrayConst>()))
+        return false;
+
+    memset(pixels, 0, sizeof(pixels));
+    printed.clear();
+    setCursor(0, 0);
+
+    LayoutEngine::render(canvas, shift, shift);
+
+    return true;
+}
+
+/**
+ * Compares the Framebuffer against a Golden Image ('#' = Pixel on).
+ */
+void checkGolden(const char* const golden[OLED_HEIGHT])
+{
+    for (uint8_t y = 0; y < OLED_HEIGHT; y++)
+    {
+        char row[OLED_WIDTH + 1];
+
+        for (uint8_t x = 0; x < OLED_WIDTH; x++)
+        {
+            row[x] = pixels[y][x] ? '#' : '.';
+        }
+
+        row[OLED_WIDTH] = '\0';
+
+        if (strcmp(golden[y], row) != 0)
+        {
+            printf("Row %u\n  expected %s\n  rendered %s\n", y, golden[y], row);
+            TEST_FAIL_MESSAGE("Framebuffer differs from Golden Image");
+        }
+    }
+}
+
+#include "golden.h"
+
+void setUp()
+{
+    memset(values, 0, sizeof(values));
+
+    values[BIND_LEVEL] = 42.0f;
+    values[BIND_VOLUME] = 420.0f;
+    values[BIND_VOLTAGE] = 1.23f;
+    values[BIND_CURRENT] = 11.24f;
+    values[BIND_WIFI] = 1.0f;
+    values[BIND_HEAP] = 182.4f;
+    values[BIND_MINHEAP] = 150.2f;
+    values[BIND_BLOCK] = 110.0f;
+    values[BIND_STACK] = 1.25f;
+}
+
+void tearDown()
+{
+}
+
+void test_default_layout_text()
+{
+    TEST_ASSERT_TRUE(renderLayout(layoutDefault));
+    TEST_ASSERT_EQUAL_STRING("BYTELEVELWiFi: OK\nLevel: 42.0%\nVolume: 420.0L\nADC: 1.23V\nCurrent: 11.24mA\n",
+                             printed.c_str());
+}
+
+void test_default_layout_golden()
+{
+    TEST_ASSERT_TRUE(renderLayout(layoutDefault));
+    checkGolden(goldenDefault);
+}
+
+void test_debug_layout_golden()
+{
+    TEST_ASSERT_TRUE(renderLayout(layoutDebug));
+    TEST_ASSERT_EQUAL_STRING("DEBUGHeap: 182.4K\nMin:  150.2K\nBlock: 110.0K\nStack: 1.25K\nLevel: 42.0%\n",
+                             printed.c_str());
+    checkGolden(goldenDebug);
+}
+
+void test_shipped_layout_matches_builtin()
+{
+    std::ifstream file("data/layout.json");
+    std::stringstream content;
+
+    content << file.rdbuf();
+
+    if (content.str().empty())
+        TEST_IGNORE_MESSAGE("data/layout.json not found, run from the Project Directory");
+
+    TEST_ASSERT_TRUE(renderLayout(content.str().c_str()));
+    checkGolden(goldenDefault);
+}
+
+void test_fill_level_is_clamped()
+{
+    values[BIND_LEVEL] = 150.0f;
+    renderLayout(layoutDefault);
+
+    // Tank filled up to the Top (y 20).
+    TEST_ASSERT_TRUE(pixels[20][110]);
+
+    values[BIND_LEVEL] = NAN;
+    renderLayout(layoutDefault);
+
+    // Empty Tank, only the Outline.
+    TEST_ASSERT_FALSE(pixels[55][110]);
+    TEST_ASSERT_TRUE(pixels[57][110]);
+}
+
+void test_shift_moves_frame()
+{
+    renderLayout(layoutDefault, 1);
+
+    // Separator Line moves from Row 9 to 10.
+    TEST_ASSERT_FALSE(pixels[9][60]);
+    TEST_ASSERT_TRUE(pixels[10][60]);
+}
+
+void test_unknown_op_is_rejected()
+{
+    TEST_ASSERT_FALSE(renderLayout(R"([{"op": "setCursor", "x": 0, "y": 0}, {"op": "drawCircle", "x": 5}])"));
+    TEST_ASSERT_EQUAL(0, LayoutEngine::getCount());
+
+    TEST_ASSERT_FALSE(renderLayout(R"([{"op": "prnt", "text": "Level"}])"));
+}
+
+void test_unknown_binding_is_rejected()
+{
+    TEST_ASSERT_FALSE(renderLayout(R"([{"op": "print", "text": "{lvl:1}"}])"));
+    TEST_ASSERT_FALSE(renderLayout(R"([{"op": "print", "text": "{level"}])"));
+    TEST_ASSERT_FALSE(renderLayout(R"([{"op": "fillLevel", "x": 0, "y": 0, "w": 8, "h": 8, "value": "lvl"}])"));
+}
+
+void test_too_many_ops_are_rejected()
+{
+    std::string layout = "[";
+
+    for (int i = 0; i <= LAYOUT_OPS; i++)
+    {
+        layout += (i > 0 ? "," : "");
+        layout += R"({"op": "setCursor", "x": 0, "y": 0})";
+    }
+
+    layout += "]";
+
+    TEST_ASSERT_FALSE(renderLayout(layout.c_str()));
+}
+
+void test_bindings_are_resolved()
+{
+    TEST_ASSERT_EQUAL(BIND_LEVEL, LayoutEngine::findBinding("level", 5));
+    TEST_ASSERT_EQUAL(BIND_STACK, LayoutEngine::findBinding("stack", 5));
+    TEST_ASSERT_EQUAL(-1, LayoutEngine::findBinding("lev", 3));
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_default_layout_text);
+    RUN_TEST(test_default_layout_golden);
+    RUN_TEST(test_debug_layout_golden);
+    RUN_TEST(test_shipped_layout_matches_builtin);
+    RUN_TEST(test_fill_level_is_clamped);
+    RUN_TEST(test_shift_moves_frame);
+    RUN_TEST(test_unknown_op_is_rejected);
+    RUN_TEST(test_unknown_binding_is_rejected);
+    RUN_TEST(test_too_many_ops_are_rejected);
+    RUN_TEST(test_bindings_are_resolved);
+    return UNITY_END();
+}
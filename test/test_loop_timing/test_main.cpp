@@ -0,0 +1,179 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdio.h>
+#include <string.h>
+#include <thread>
+#include <unity.h>
+
+#include "FrameDiff.h"
+#include "InternalConfig.h"
+#include "RelaisArbiter.h"
+
+// Define Bytes of a Frame.
+#define FRAME_SIZE (OLED_WIDTH * OLED_HEIGHT / 8)
+
+// Define Data Bytes per I2C Transmission (I2C_BUFFER_LENGTH of the ESP32 Core - Control Byte).
+#define CHUNK 127
+
+// Define Time of one I2C Byte at 100 kHz (9 Clocks), a slow or stretched Bus.
+#define BYTE_MICROS 90
+
+// Define maximum Latency of one Loop Iteration (µs), far below a Frame Transfer.
+#define LOOP_BUDGET 10000
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * Mocks a slow I2C Bus: every Transfer blocks for the Time the Bytes need
+ * on the Wire. `wire` is the Bus Mutex of `DeviceHandler::lockWire()`.
+ */
+std::mutex wire;
+std::atomic<bool> flushing(false);
+
+void command(uint8_t value)
+{
+    (void)value;
+    std::this_thread::sleep_for(std::chrono::microseconds(3 * BYTE_MICROS));
+}
+
+void data(const uint8_t* bytes, size_t length)
+{
+    (void)bytes;
+    std::this_thread::sleep_for(std::chrono::microseconds((2 + length) * BYTE_MICROS));
+}
+
+const DisplayBus bus = {command, data, CHUNK};
+
+// Store rendered Framebuffer.
+uint8_t frame[FRAME_SIZE];
+
+/**
+ * Transmits a complete Frame like the Display Task (Bus locked during the Flush).
+ *
+ * @return The Duration of the Flush (µs).
+ */
+int64_t flushDisplay()
+{
+    std::lock_guard<std::mutex> lock(wire);
+    Clock::time_point start = Clock::now();
+
+    flushing = true;
+    FrameDiff::invalidate();
+    FrameDiff::flush(bus, frame);
+    flushing = false;
+
+    return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+}
+
+/**
+ * One Iteration of the Control Path: Relais Arbitration and Timeouts.
+ * Like `loop()` it never takes the Wire Mutex.
+ */
+void controlStep(int64_t now)
+{
+    int64_t wait;
+    uint32_t conflicts;
+
+    RelaisArbiter::request(0, RELAIS_AUTO, now, &conflicts, &wait);
+    RelaisArbiter::setDeadline(0, now + RelaisArbiter::getTimeout(0, 30));
+    RelaisArbiter::getRemaining(0, now);
+    RelaisArbiter::release(0);
+}
+
+/**
+ * Measures the Control Loop while a Frame is transmitted.
+ *
+ * @param inLoop True to flush inside the Loop (the Display refreshed by `loop()`).
+ * @param flushMicros Receives the Duration of the Flush.
+ * @param overlapped Receives the Iterations which ran during the Flush.
+ * @return The maximum Latency of one Iteration (µs).
+ */
+int64_t measureLoop(bool inLoop, int64_t* flushMicros, uint32_t* overlapped)
+{
+    std::thread display;
+    int64_t latency = 0;
+
+    *overlapped = 0;
+
+    if (!inLoop)
+        display = std::thread([flushMicros]() { *flushMicros = flushDisplay(); });
+
+    Clock::time_point end = Clock::now() + std::chrono::milliseconds(250);
+
+    for (uint32_t i = 0; Clock::now() < end; i++)
+    {
+        Clock::time_point start = Clock::now();
+
+        if (flushing)
+            (*overlapped)++;
+
+        controlStep(i * 1000LL);
+
+        if (inLoop && i == 10)
+            *flushMicros = flushDisplay();
+
+        int64_t micros = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+
+        if (micros > latency)
+            latency = micros;
+
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+
+    if (display.joinable())
+        display.join();
+
+    char message[128];
+    snprintf(message, sizeof(message), "%s: Flush %lld us, max. Loop Latency %lld us",
+             inLoop ? "Inline" : "Task", (long long)*flushMicros, (long long)latency);
+    TEST_MESSAGE(message);
+
+    return latency;
+}
+
+void setUp()
+{
+    RelaisArbiter::reset(0);
+    memset(frame, 0x5A, sizeof(frame));
+}
+
+void tearDown()
+{
+}
+
+void test_loop_is_not_delayed_by_display_task()
+{
+    int64_t flushMicros = 0;
+    uint32_t overlapped;
+    int64_t latency = measureLoop(false, &flushMicros, &overlapped);
+
+    // The Flush is slow, the Loop kept running meanwhile.
+    TEST_ASSERT_TRUE(flushMicros >= FRAME_SIZE * BYTE_MICROS);
+    TEST_ASSERT_TRUE(overlapped > 10);
+    TEST_ASSERT_LESS_THAN(LOOP_BUDGET, latency);
+}
+
+void test_inline_flush_blocks_loop()
+{
+    int64_t flushMicros = 0;
+    uint32_t overlapped;
+    int64_t latency = measureLoop(true, &flushMicros, &overlapped);
+
+    // Reference: Rendering in `loop()` stalls the Control Path for the whole Transfer.
+    TEST_ASSERT_EQUAL(0, overlapped);
+    TEST_ASSERT_TRUE(latency >= flushMicros);
+    TEST_ASSERT_TRUE(latency > LOOP_BUDGET);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_loop_is_not_delayed_by_display_task);
+    RUN_TEST(test_inline_flush_blocks_loop);
+    return UNITY_END();
+}
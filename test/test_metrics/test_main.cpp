@@ -0,0 +1,439 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unity.h>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "MetricsRenderer.h"
+
+/**
+ * Parsed Sample and Family of the Exposition.
+ */
+struct Sample
+{
+    std::string name;
+    std::map<std::string, std::string> labels;
+    double value;
+};
+
+struct Family
+{
+    std::string name;
+    std::string type;
+    std::string unit;
+    std::string help;
+    std::vector<Sample> samples;
+};
+
+// Store Error of the last Parse.
+std::string parseError;
+
+// Store Values returned by the Getters.
+double level = 42.5;
+double voltage = 1.25;
+uint32_t connects = 3;
+bool relais[4] = {false, true, false, true};
+
+const Metric metrics[] = {
+    {"test_level_percent", "gauge", "percent", "Tank Level", 1, nullptr, [](uint8_t) -> double { return level; }},
+    {"test_voltage_volts", "gauge", "volts", "Sensor Voltage", 1, nullptr, [](uint8_t) -> double { return voltage; }},
+    {"test_relais_state", "gauge", "", "Relais State (1 = on)", 4, "channel",
+        [](uint8_t sample) -> double { return relais[sample] ? 1 : 0; }},
+    {"test_heap_free_bytes", "gauge", "bytes", "Free Heap", 1, nullptr, [](uint8_t) -> double { return 183456; }},
+    {"test_wifi_connects", "counter", "", "Wi-Fi Connects since Boot", 1, nullptr,
+        [](uint8_t) -> double { return connects; }},
+};
+
+constexpr uint8_t METRIC_COUNT = sizeof(metrics) / sizeof(metrics[0]);
+
+/**
+ * Renders the Exposition Line by Line like the chunked Response.
+ */
+std::string render(const Metric* table, uint8_t count)
+{
+    std::string text;
+    char buffer[160];
+
+    for (uint16_t line = 0; line < 1000; line++)
+    {
+        size_t length = MetricsRenderer::renderLine(table, count, line, buffer, sizeof(buffer));
+
+        if (length == 0)
+            break;
+
+        TEST_ASSERT_TRUE(length < sizeof(buffer));
+        text.append(buffer, length);
+    }
+
+    return text;
+}
+
+bool fail(const std::string& message, const std::string& line)
+{
+    parseError = message + ": " + line;
+    return false;
+}
+
+bool isName(const std::string& name, bool metric)
+{
+    if (name.empty() || isdigit((unsigned char)name[0]))
+        return false;
+
+    for (char c : name)
+    {
+        if (!isalnum((unsigned char)c) && c != '_' && !(metric && c == ':'))
+            return false;
+    }
+
+    return true;
+}
+
+/**
+ * Parses a Number as defined by the OpenMetrics ABNF (realnumber, NaN, +Inf, -Inf).
+ */
+bool parseNumber(const std::string& text, double* value)
+{
+    if (text == "NaN" || text == "+Inf" || text == "-Inf")
+    {
+        *value = text == "NaN" ? NAN : (text[0] == '+' ? INFINITY : -INFINITY);
+        return true;
+    }
+
+    size_t i = 0;
+
+    if (i < text.size() && (text[i] == '+' || text[i] == '-'))
+        i++;
+
+    size_t digits = i;
+
+    while (i < text.size() && isdigit((unsigned char)text[i]))
+        i++;
+
+    if (i < text.size() && text[i] == '.')
+    {
+        i++;
+
+        while (i < text.size() && isdigit((unsigned char)text[i]))
+            i++;
+    }
+
+    if (i == digits || !isdigit((unsigned char)text[digits]))
+        return false;
+
+    if (i < text.size() && (text[i] == 'e' || text[i] == 'E'))
+    {
+        i++;
+
+        if (i < text.size() && (text[i] == '+' || text[i] == '-'))
+            i++;
+
+        size_t exponent = i;
+
+        while (i < text.size() && isdigit((unsigned char)text[i]))
+            i++;
+
+        if (i == exponent)
+            return false;
+    }
+
+    if (i != text.size())
+        return false;
+
+    *value = strtod(text.c_str(), nullptr);
+    return true;
+}
+
+bool parseLabels(const std::string& text, size_t* pos, std::map<std::string, std::string>* labels, const std::string& line)
+{
+    (*pos)++;
+
+    while (*pos < text.size() && text[*pos] != '}')
+    {
+        size_t equals = text.find('=', *pos);
+
+        if (equals == std::string::npos || equals + 1 >= text.size() || text[equals + 1] != '"')
+            return fail("invalid label", line);
+
+        std::string name = text.substr(*pos, equals - *pos);
+        std::string value;
+        size_t i = equals + 2;
+
+        while (i < text.size() && text[i] != '"')
+        {
+            if (text[i] == '\\')
+            {
+                if (i + 1 >= text.size() || (text[i + 1] != '\\' && text[i + 1] != '"' && text[i + 1] != 'n'))
+                    return fail("invalid escape", line);
+
+                i++;
+            }
+
+            value += text[i++];
+        }
+
+        if (i >= text.size() || !isName(name, false) || labels->count(name) > 0)
+            return fail("invalid label name", line);
+
+        (*labels)[name] = value;
+        *pos = i + 1;
+
+        if (*pos < text.size() && text[*pos] == ',')
+            (*pos)++;
+    }
+
+    if (*pos >= text.size())
+        return fail("unterminated labels", line);
+
+    (*pos)++;
+    return true;
+}
+
+/**
+ * Strict OpenMetrics 1.0 Text Parser (Subset without Exemplars).
+ *
+ * Checks the ABNF of every Line, the Order of Metadata and Samples, unique
+ * and contiguous Families, UNIT Suffixes, Counter `_total` Samples and the
+ * terminating `# EOF`.
+ */
+bool parse(const std::string& text, std::vector<Family>* families)
+{
+    std::set<std::string> seen;
+    std::set<std::string> types = {"counter", "gauge", "histogram", "gaugehistogram", "stateset", "info", "summary", "unknown"};
+    size_t start = 0;
+    bool eof = false;
+
+    families->clear();
+
+    if (text.empty() || text.back() != '\n')
+        return fail("missing line break", text);
+
+    while (start < text.size())
+    {
+        size_t end = text.find('\n', start);
+        std::string line = text.substr(start, end - start);
+        start = end + 1;
+
+        if (eof)
+            return fail("content after EOF", line);
+
+        if (line == "# EOF")
+        {
+            eof = true;
+            continue;
+        }
+
+        if (line.compare(0, 2, "# ") == 0)
+        {
+            size_t keyword = line.find(' ', 2);
+            size_t name = line.find(' ', keyword + 1);
+
+            if (keyword == std::string::npos || name == std::string::npos)
+                return fail("invalid metadata", line);
+
+            std::string kind = line.substr(2, keyword - 2);
+            std::string family = line.substr(keyword + 1, name - keyword - 1);
+            std::string value = line.substr(name + 1);
+
+            if (!isName(family, true))
+                return fail("invalid family name", line);
+
+            if (families->empty() || families->back().name != family)
+            {
+                if (seen.count(family) > 0)
+                    return fail("family not contiguous", line);
+
+                seen.insert(family);
+                families->push_back({family, "unknown", "", "", {}});
+            }
+
+            Family& current = families->back();
+
+            if (!current.samples.empty())
+                return fail("metadata after samples", line);
+
+            if (kind == "TYPE")
+            {
+                if (types.count(value) == 0 || current.type != "unknown")
+                    return fail("invalid type", line);
+
+                current.type = value;
+            }
+            else if (kind == "UNIT")
+            {
+                std::string suffix = "_" + value;
+
+                if (!current.unit.empty() || family.size() < suffix.size() ||
+                    family.compare(family.size() - suffix.size(), suffix.size(), suffix) != 0)
+                    return fail("unit is no suffix", line);
+
+                current.unit = value;
+            }
+            else if (kind == "HELP")
+            {
+                if (!current.help.empty())
+                    return fail("duplicate help", line);
+
+                current.help = value;
+            }
+            else
+                return fail("unknown metadata", line);
+
+            continue;
+        }
+
+        if (line.empty() || line[0] == '#')
+            return fail("invalid line", line);
+
+        // Sample: name [labels] SP value.
+        Sample sample;
+        size_t pos = 0;
+
+        while (pos < line.size() && line[pos] != '{' && line[pos] != ' ')
+            pos++;
+
+        sample.name = line.substr(0, pos);
+
+        if (!isName(sample.name, true))
+            return fail("invalid sample name", line);
+
+        if (pos < line.size() && line[pos] == '{' && !parseLabels(line, &pos, &sample.labels, line))
+            return false;
+
+        if (pos >= line.size() || line[pos] != ' ' || !parseNumber(line.substr(pos + 1), &sample.value))
+            return fail("invalid value", line);
+
+        if (families->empty())
+            return fail("sample without family", line);
+
+        Family& current = families->back();
+        std::string expected = current.type == "counter" ? current.name + "_total" : current.name;
+
+        if (sample.name != expected)
+            return fail("sample does not match family", line);
+
+        if (current.type == "counter" && (isnan(sample.value) || sample.value < 0))
+            return fail("invalid counter value", line);
+
+        for (const Sample& other : current.samples)
+        {
+            if (other.labels == sample.labels)
+                return fail("duplicate label set", line);
+        }
+
+        current.samples.push_back(sample);
+    }
+
+    if (!eof)
+        return fail("missing EOF", "");
+
+    return true;
+}
+
+void setUp()
+{
+    level = 42.5;
+    voltage = 1.25;
+    connects = 3;
+}
+
+void tearDown()
+{
+}
+
+void test_exposition_is_valid()
+{
+    std::vector<Family> families;
+
+    TEST_ASSERT_TRUE_MESSAGE(parse(render(metrics, METRIC_COUNT), &families), parseError.c_str());
+    TEST_ASSERT_EQUAL(METRIC_COUNT, families.size());
+
+    for (uint8_t i = 0; i < METRIC_COUNT; i++)
+    {
+        TEST_ASSERT_EQUAL_STRING(metrics[i].name, families[i].name.c_str());
+        TEST_ASSERT_EQUAL_STRING(metrics[i].type, families[i].type.c_str());
+        TEST_ASSERT_EQUAL_STRING(metrics[i].unit, families[i].unit.c_str());
+        TEST_ASSERT_EQUAL_STRING(metrics[i].help, families[i].help.c_str());
+        TEST_ASSERT_EQUAL(metrics[i].samples, families[i].samples.size());
+    }
+}
+
+void test_values_come_from_their_getter()
+{
+    std::vector<Family> families;
+
+    TEST_ASSERT_TRUE_MESSAGE(parse(render(metrics, METRIC_COUNT), &families), parseError.c_str());
+
+    TEST_ASSERT_EQUAL_FLOAT(42.5, families[0].samples[0].value);
+    TEST_ASSERT_EQUAL_FLOAT(1.25, families[1].samples[0].value);
+    TEST_ASSERT_EQUAL_FLOAT(183456, families[3].samples[0].value);
+    TEST_ASSERT_EQUAL_FLOAT(3, families[4].samples[0].value);
+
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        const Sample& sample = families[2].samples[i];
+
+        TEST_ASSERT_EQUAL_STRING(std::to_string(i + 1).c_str(), sample.labels.at("channel").c_str());
+        TEST_ASSERT_EQUAL_FLOAT(relais[i] ? 1 : 0, sample.value);
+    }
+}
+
+void test_special_values()
+{
+    std::vector<Family> families;
+
+    level = NAN;
+    voltage = -INFINITY;
+
+    TEST_ASSERT_TRUE_MESSAGE(parse(render(metrics, METRIC_COUNT), &families), parseError.c_str());
+    TEST_ASSERT_TRUE(isnan(families[0].samples[0].value));
+    TEST_ASSERT_TRUE(isinf(families[1].samples[0].value) && families[1].samples[0].value < 0);
+}
+
+void test_large_values_keep_precision()
+{
+    std::vector<Family> families;
+
+    connects = 4000000000U;
+
+    TEST_ASSERT_TRUE_MESSAGE(parse(render(metrics, METRIC_COUNT), &families), parseError.c_str());
+    TEST_ASSERT_TRUE(families[4].samples[0].value == 4000000000.0);
+}
+
+void test_empty_table_is_only_eof()
+{
+    TEST_ASSERT_EQUAL_STRING("# EOF\n", render(metrics, 0).c_str());
+}
+
+void test_parser_rejects_invalid_exposition()
+{
+    std::vector<Family> families;
+
+    TEST_ASSERT_FALSE(parse("# TYPE a gauge\na 1\n", &families));
+    TEST_ASSERT_FALSE(parse("# TYPE a gauge\na nan\n# EOF\n", &families));
+    TEST_ASSERT_FALSE(parse("# TYPE a counter\na 1\n# EOF\n", &families));
+    TEST_ASSERT_FALSE(parse("# TYPE a_bytes gauge\n# UNIT a_bytes volts\n# EOF\n", &families));
+    TEST_ASSERT_FALSE(parse("# TYPE a gauge\na 1\n# HELP a late\n# EOF\n", &families));
+    TEST_ASSERT_FALSE(parse("# TYPE a gauge\n# TYPE b gauge\n# HELP a again\n# EOF\n", &families));
+    TEST_ASSERT_FALSE(parse("# TYPE a gauge\na{c=\"1\"} 1\na{c=\"1\"} 2\n# EOF\n", &families));
+    TEST_ASSERT_FALSE(parse("# EOF\n# TYPE a gauge\n", &families));
+    TEST_ASSERT_TRUE(parse("# TYPE a gauge\na{c=\"1\",d=\"x\"} -1.5e3\n# EOF\n", &families));
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_exposition_is_valid);
+    RUN_TEST(test_values_come_from_their_getter);
+    RUN_TEST(test_special_values);
+    RUN_TEST(test_large_values_keep_precision);
+    RUN_TEST(test_empty_table_is_only_eof);
+    RUN_TEST(test_parser_rejects_invalid_exposition);
+    return UNITY_END();
+}
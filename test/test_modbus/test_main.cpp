@@ -0,0 +1,281 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#include <string.h>
+#include <unity.h>
+#include <vector>
+
+#include "ModbusProtocol.h"
+
+#define COILS 3
+
+// Store fake Device (Coil 2 refuses to start, like an Interlock).
+bool coils[COILS];
+uint16_t inputs[MB_INPUT_COUNT];
+uint16_t holding[MB_HOLDING_COUNT];
+
+// Store Responses of the Server.
+std::vector<std::vector<uint8_t>> responses;
+
+uint16_t getCoilCount()
+{
+    return COILS;
+}
+
+bool getCoil(uint16_t address)
+{
+    return coils[address];
+}
+
+bool setCoil(uint16_t address, bool state)
+{
+    if (state && address == 2)
+        return false;
+
+    coils[address] = state;
+    return true;
+}
+
+void readImage(bool isHolding, uint16_t* image)
+{
+    if (isHolding)
+        memcpy(image, holding, sizeof(holding));
+    else
+        memcpy(image, inputs, sizeof(inputs));
+}
+
+bool isValidHolding(uint16_t address, uint16_t value)
+{
+    return address == MB_HOLDING_MODE ? value <= 2 : value <= 1000;
+}
+
+void setHolding(uint16_t address, uint16_t value)
+{
+    holding[address] = value;
+}
+
+void send(void* client, const uint8_t* data, size_t length)
+{
+    TEST_ASSERT_EQUAL_PTR(&responses, client);
+    responses.emplace_back(data, data + length);
+}
+
+const ModbusDevice device = {getCoilCount, getCoil, setCoil, readImage, isValidHolding, setHolding, send};
+
+ModbusBuffer buffer;
+uint16_t transaction = 0;
+
+/**
+ * Builds a Request like a Modbus TCP Client (MBAP Header, Unit ID 1, PDU).
+ */
+std::vector<uint8_t> request(std::vector<uint8_t> pdu)
+{
+    transaction++;
+
+    std::vector<uint8_t> frame = {
+        (uint8_t)(transaction >> 8), (uint8_t)transaction, 0, 0,
+        (uint8_t)((pdu.size() + 1) >> 8), (uint8_t)(pdu.size() + 1), 1
+    };
+
+    frame.insert(frame.end(), pdu.begin(), pdu.end());
+    return frame;
+}
+
+/**
+ * Sends Data in Segments of the given Size.
+ */
+bool transmit(const std::vector<uint8_t>& data, size_t segment)
+{
+    for (size_t i = 0; i < data.size(); i += segment)
+    {
+        size_t length = data.size() - i < segment ? data.size() - i : segment;
+
+        // Exact Heap Copy, so ASan catches Reads beyond the Segment.
+        std::vector<uint8_t> copy(data.begin() + i, data.begin() + i + length);
+
+        if (!ModbusProtocol::receive(device, &buffer, &responses, copy.data(), copy.size()))
+            return false;
+    }
+
+    return true;
+}
+
+/**
+ * Checks the last Response PDU and the echoed Header.
+ */
+void expectPDU(const std::vector<uint8_t>& pdu)
+{
+    TEST_ASSERT_EQUAL(1, responses.size());
+
+    const std::vector<uint8_t>& frame = responses[0];
+
+    TEST_ASSERT_EQUAL(7 + pdu.size(), frame.size());
+    TEST_ASSERT_EQUAL(transaction >> 8, frame[0]);
+    TEST_ASSERT_EQUAL(transaction & 0xFF, frame[1]);
+    TEST_ASSERT_EQUAL(0, frame[2] | frame[3]);
+    TEST_ASSERT_EQUAL(pdu.size() + 1, (frame[4] << 8) | frame[5]);
+    TEST_ASSERT_EQUAL(1, frame[6]);
+    TEST_ASSERT_EQUAL_MEMORY(pdu.data(), frame.data() + 7, pdu.size());
+}
+
+void setUp()
+{
+    memset(coils, 0, sizeof(coils));
+    memset(holding, 0, sizeof(holding));
+
+    for (uint16_t i = 0; i < MB_INPUT_COUNT; i++)
+        inputs[i] = 0x1100 + i;
+
+    buffer.length = 0;
+    responses.clear();
+}
+
+void tearDown()
+{
+}
+
+void test_read_input_registers()
+{
+    TEST_ASSERT_TRUE(transmit(request({0x04, 0x00, 0x08, 0x00, 0x02}), 64));
+    expectPDU({0x04, 0x04, 0x11, 0x08, 0x11, 0x09});
+}
+
+void test_frame_split_at_every_byte()
+{
+    std::vector<uint8_t> frame = request({0x10, 0x00, 0x01, 0x00, 0x02, 0x04, 0x01, 0xF4, 0x00, 0x64});
+
+    for (size_t segment = 1; segment < frame.size(); segment++)
+    {
+        responses.clear();
+        memset(holding, 0, sizeof(holding));
+
+        TEST_ASSERT_TRUE(transmit(frame, segment));
+        expectPDU({0x10, 0x00, 0x01, 0x00, 0x02});
+        TEST_ASSERT_EQUAL(500, holding[MB_HOLDING_MAX]);
+        TEST_ASSERT_EQUAL(100, holding[MB_HOLDING_FILL]);
+    }
+}
+
+void test_frames_across_segments()
+{
+    std::vector<uint8_t> stream = request({0x05, 0x00, 0x00, 0xFF, 0x00});
+    std::vector<uint8_t> second = request({0x01, 0x00, 0x00, 0x00, 0x03});
+    stream.insert(stream.end(), second.begin(), second.end());
+
+    // Second Frame starts in the Middle of a Segment and ends in the next one.
+    TEST_ASSERT_TRUE(transmit(stream, 9));
+    TEST_ASSERT_EQUAL(2, responses.size());
+    TEST_ASSERT_EQUAL(0x05, responses[0][7]);
+    TEST_ASSERT_EQUAL(transaction, (responses[1][0] << 8) | responses[1][1]);
+    TEST_ASSERT_EQUAL(0x01, responses[1][7]);
+    TEST_ASSERT_EQUAL(0x01, responses[1][9]);
+}
+
+void test_short_multiple_writes_are_rejected()
+{
+    std::vector<uint8_t> pdu = {0x10, 0x00, 0x00, 0x00, 0x01};
+
+    for (uint8_t function : {0x0F, 0x10})
+    {
+        pdu[0] = function;
+
+        for (size_t length = 1; length < 6; length++)
+        {
+            responses.clear();
+
+            TEST_ASSERT_TRUE(transmit(request(std::vector<uint8_t>(pdu.begin(), pdu.begin() + length)), 64));
+            expectPDU({(uint8_t)(function | 0x80), 0x03});
+        }
+    }
+
+    TEST_ASSERT_EQUAL(0, holding[0]);
+    TEST_ASSERT_FALSE(coils[0]);
+}
+
+void test_byte_count_must_match()
+{
+    TEST_ASSERT_TRUE(transmit(request({0x10, 0x00, 0x00, 0x00, 0x02, 0x04, 0x00, 0x01}), 64));
+    expectPDU({0x90, 0x03});
+
+    responses.clear();
+    TEST_ASSERT_TRUE(transmit(request({0x0F, 0x00, 0x00, 0x00, 0x03, 0x01}), 64));
+    expectPDU({0x8F, 0x03});
+}
+
+void test_write_coils()
+{
+    TEST_ASSERT_TRUE(transmit(request({0x0F, 0x00, 0x00, 0x00, 0x02, 0x01, 0x03}), 64));
+    expectPDU({0x0F, 0x00, 0x00, 0x00, 0x02});
+    TEST_ASSERT_TRUE(coils[0] && coils[1]);
+}
+
+void test_rejected_start_is_device_failure()
+{
+    TEST_ASSERT_TRUE(transmit(request({0x05, 0x00, 0x02, 0xFF, 0x00}), 64));
+    expectPDU({0x85, 0x04});
+}
+
+void test_invalid_values_and_addresses()
+{
+    TEST_ASSERT_TRUE(transmit(request({0x06, 0x00, 0x00, 0x00, 0x03}), 64));
+    expectPDU({0x86, 0x03});
+
+    responses.clear();
+    TEST_ASSERT_TRUE(transmit(request({0x03, 0x00, 0x03, 0x00, 0x02}), 64));
+    expectPDU({0x83, 0x02});
+
+    responses.clear();
+    TEST_ASSERT_TRUE(transmit(request({0x01, 0x00, 0x00, 0x00, 0x04}), 64));
+    expectPDU({0x81, 0x02});
+
+    responses.clear();
+    TEST_ASSERT_TRUE(transmit(request({0x04, 0x00, 0x00, 0x00}), 64));
+    expectPDU({0x84, 0x03});
+
+    responses.clear();
+    TEST_ASSERT_TRUE(transmit(request({0x2B}), 64));
+    expectPDU({0xAB, 0x01});
+}
+
+void test_invalid_header_closes_connection()
+{
+    std::vector<uint8_t> frame = request({0x04, 0x00, 0x00, 0x00, 0x01});
+
+    frame[3] = 1;
+    TEST_ASSERT_FALSE(transmit(frame, 64));
+
+    frame = request({0x04, 0x00, 0x00, 0x00, 0x01});
+    frame[4] = 0x01;
+    TEST_ASSERT_FALSE(transmit(frame, 3));
+
+    frame = request({});
+    TEST_ASSERT_FALSE(transmit(frame, 64));
+    TEST_ASSERT_EQUAL(0, responses.size());
+}
+
+void test_largest_frame()
+{
+    // 123 Registers are the Maximum of Function 16 (253 Bytes PDU).
+    std::vector<uint8_t> pdu = {0x10, 0x00, 0x00, 0x00, 123, 246};
+    pdu.resize(6 + 246, 0);
+
+    TEST_ASSERT_TRUE(transmit(request(pdu), 100));
+    expectPDU({0x90, 0x02});
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_read_input_registers);
+    RUN_TEST(test_frame_split_at_every_byte);
+    RUN_TEST(test_frames_across_segments);
+    RUN_TEST(test_short_multiple_writes_are_rejected);
+    RUN_TEST(test_byte_count_must_match);
+    RUN_TEST(test_write_coils);
+    RUN_TEST(test_rejected_start_is_device_failure);
+    RUN_TEST(test_invalid_values_and_addresses);
+    RUN_TEST(test_invalid_header_closes_connection);
+    RUN_TEST(test_largest_frame);
+    return UNITY_END();
+}
@@ -0,0 +1,234 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#include <string.h>
+#include <unity.h>
+
+#include "PatchParser.h"
+
+/**
+ * Patch generated by tools/mkpatch.py from the Images built by `buildImages()`.
+ * COPY and INSERT alternate, including a Copy of a later Block to the Start.
+ */
+const uint8_t fixture[] = {
+    0x42, 0x4c, 0x44, 0x31, 0x66, 0x08, 0x00, 0x00, 0x02, 0x10, 0x00, 0x00, 0x00, 0x7f, 0x69, 0x80,
+    0x4d, 0xe8, 0x85, 0x9e, 0x59, 0x04, 0x40, 0x58, 0x1a, 0xd7, 0xfb, 0x8e, 0x3c, 0x01, 0xc0, 0x04,
+    0x00, 0x00, 0xb8, 0x00, 0x00, 0x00, 0x02, 0x28, 0x00, 0x00, 0x00, 0x8c, 0x21, 0xff, 0x72, 0xed,
+    0xd7, 0x18, 0xd9, 0x4e, 0x13, 0x95, 0x13, 0xdc, 0x1b, 0x63, 0xfc, 0x93, 0x06, 0xf6, 0xbf, 0x9c,
+    0xe5, 0x06, 0xe0, 0x6d, 0xb0, 0x0a, 0x05, 0x9f, 0xf2, 0x75, 0x87, 0x8e, 0x34, 0xb3, 0xbc, 0xb3,
+    0x2b, 0xe2, 0x02, 0x01, 0x00, 0x00, 0x00, 0x00, 0x84, 0x03, 0x00, 0x00, 0x02, 0x46, 0x00, 0x00,
+    0x00, 0x53, 0xc3, 0x7d, 0x78, 0x8e, 0xb4, 0x4d, 0xb7, 0x48, 0x2f, 0x6d, 0x46, 0x3d, 0x19, 0xe5,
+    0x70, 0x24, 0x4c, 0xbb, 0xa0, 0xe3, 0x58, 0xfc, 0x78, 0x74, 0xfa, 0x8c, 0xb1, 0x95, 0x5c, 0xaf,
+    0xb5, 0x32, 0x12, 0x53, 0xfe, 0x93, 0xd1, 0x23, 0x2c, 0x45, 0xed, 0x4c, 0xe9, 0xc9, 0x99, 0x0d,
+    0x7d, 0xff, 0xdc, 0x01, 0x30, 0x51, 0x55, 0x2c, 0x63, 0xa0, 0xb0, 0xc7, 0x6d, 0xee, 0xe4, 0xcc,
+    0x36, 0xd0, 0x32, 0x40, 0x96, 0x91, 0xdd, 0x01, 0xc0, 0x03, 0x00, 0x00, 0xac, 0x03, 0x00, 0x00,
+    0x00
+};
+
+// Store running (old) and expected (new) Image.
+uint8_t source[2048];
+uint8_t expected[2150];
+
+// Store reconstructed Image.
+uint8_t output[4096];
+size_t outputLength;
+
+/**
+ * Fills a Buffer with the Bytes of a linear congruential Generator, as
+ * done by the Python Script which generated the Fixture.
+ */
+void fill(uint8_t* data, size_t length, uint32_t seed)
+{
+    for (size_t i = 0; i < length; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        data[i] = (seed >> 16) & 0xff;
+    }
+}
+
+/**
+ * Builds new = old[1200:1400] + 40 new + old[0:900] + 70 new + old[960:1900].
+ */
+void buildImages()
+{
+    uint8_t* next = expected;
+
+    fill(source, sizeof(source), 1);
+
+    memcpy(next, source + 1200, 200);
+    next += 200;
+    fill(next, 40, 2);
+    next += 40;
+    memcpy(next, source, 900);
+    next += 900;
+    fill(next, 70, 3);
+    next += 70;
+    memcpy(next, source + 960, 940);
+}
+
+bool copy(uint32_t offset, uint32_t length)
+{
+    // Same Bounds Check as `PatchHandler::copySource()`.
+    if (offset + length > sizeof(source) || offset + length < offset || outputLength + length > sizeof(output))
+        return false;
+
+    memcpy(output + outputLength, source + offset, length);
+    outputLength += length;
+
+    return true;
+}
+
+bool insert(const uint8_t* data, size_t length)
+{
+    if (outputLength + length > sizeof(output))
+        return false;
+
+    memcpy(output + outputLength, data, length);
+    outputLength += length;
+
+    return true;
+}
+
+/**
+ * Feeds a Patch in Chunks of the given Size.
+ *
+ * @return True if every Chunk was accepted.
+ */
+bool apply(const uint8_t* patch, size_t length, size_t chunk)
+{
+    PatchParser::begin(copy, insert);
+
+    for (size_t i = 0; i < length; i += chunk)
+    {
+        if (!PatchParser::feed(patch + i, (length - i < chunk ? length - i : chunk)))
+            return false;
+    }
+
+    return true;
+}
+
+void setUp()
+{
+    buildImages();
+
+    memset(output, 0, sizeof(output));
+    outputLength = 0;
+}
+
+void tearDown()
+{
+}
+
+void test_fixture_matches_images()
+{
+    TEST_ASSERT_TRUE(apply(fixture, sizeof(fixture), sizeof(fixture)));
+    TEST_ASSERT_TRUE(PatchParser::isDone());
+    TEST_ASSERT_EQUAL(sizeof(expected), PatchParser::getTarget());
+    TEST_ASSERT_EQUAL(sizeof(expected), outputLength);
+    TEST_ASSERT_EQUAL_MEMORY(expected, output, sizeof(expected));
+}
+
+void test_every_chunk_size()
+{
+    for (size_t chunk = 1; chunk <= sizeof(fixture); chunk++)
+    {
+        outputLength = 0;
+
+        TEST_ASSERT_TRUE(apply(fixture, sizeof(fixture), chunk));
+        TEST_ASSERT_TRUE(PatchParser::isDone());
+        TEST_ASSERT_EQUAL(sizeof(expected), outputLength);
+        TEST_ASSERT_EQUAL_MEMORY(expected, output, sizeof(expected));
+    }
+}
+
+void test_truncated_stream_is_not_done()
+{
+    for (size_t length = 0; length < sizeof(fixture); length++)
+    {
+        outputLength = 0;
+
+        apply(fixture, length, 7);
+        TEST_ASSERT_FALSE(PatchParser::isDone());
+    }
+}
+
+void test_bad_magic()
+{
+    const uint8_t patch[] = {'B', 'L', 'D', '2', 4, 0, 0, 0, 0x02, 4, 0, 0, 0, 1, 2, 3, 4, 0x00};
+
+    TEST_ASSERT_FALSE(apply(patch, sizeof(patch), 1));
+    TEST_ASSERT_EQUAL(0, outputLength);
+}
+
+void test_unknown_opcode()
+{
+    const uint8_t patch[] = {'B', 'L', 'D', '1', 4, 0, 0, 0, 0x03, 4, 0, 0, 0};
+
+    TEST_ASSERT_FALSE(apply(patch, sizeof(patch), sizeof(patch)));
+}
+
+void test_trailing_data()
+{
+    const uint8_t patch[] = {'B', 'L', 'D', '1', 1, 0, 0, 0, 0x02, 1, 0, 0, 0, 0xaa, 0x00, 0x00};
+
+    TEST_ASSERT_FALSE(apply(patch, sizeof(patch), 1));
+}
+
+void test_empty_insert()
+{
+    const uint8_t patch[] = {'B', 'L', 'D', '1', 2, 0, 0, 0, 0x02, 0, 0, 0, 0, 0x02, 2, 0, 0, 0, 0xaa, 0xbb, 0x00};
+
+    TEST_ASSERT_TRUE(apply(patch, sizeof(patch), 1));
+    TEST_ASSERT_TRUE(PatchParser::isDone());
+    TEST_ASSERT_EQUAL(2, outputLength);
+}
+
+void test_insert_beyond_target()
+{
+    const uint8_t patch[] = {'B', 'L', 'D', '1', 2, 0, 0, 0, 0x02, 3, 0, 0, 0, 1, 2, 3, 0x00};
+
+    TEST_ASSERT_FALSE(apply(patch, sizeof(patch), sizeof(patch)));
+    TEST_ASSERT_EQUAL(0, outputLength);
+}
+
+void test_copy_beyond_target()
+{
+    const uint8_t patch[] = {'B', 'L', 'D', '1', 16, 0, 0, 0, 0x01, 0, 0, 0, 0, 17, 0, 0, 0, 0x00};
+
+    TEST_ASSERT_FALSE(apply(patch, sizeof(patch), sizeof(patch)));
+    TEST_ASSERT_EQUAL(0, outputLength);
+}
+
+void test_copy_beyond_source()
+{
+    // Offset 0xffffff00 + Length 0x100 overflows 32 Bit.
+    const uint8_t patch[] = {'B', 'L', 'D', '1', 0, 1, 0, 0, 0x01, 0, 0xff, 0xff, 0xff, 0, 1, 0, 0, 0x00};
+
+    TEST_ASSERT_FALSE(apply(patch, sizeof(patch), sizeof(patch)));
+}
+
+void test_end_before_target()
+{
+    const uint8_t patch[] = {'B', 'L', 'D', '1', 8, 0, 0, 0, 0x01, 0, 0, 0, 0, 4, 0, 0, 0, 0x00};
+
+    TEST_ASSERT_TRUE(apply(patch, sizeof(patch), sizeof(patch)));
+    TEST_ASSERT_FALSE(PatchParser::isDone());
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_fixture_matches_images);
+    RUN_TEST(test_every_chunk_size);
+    RUN_TEST(test_truncated_stream_is_not_done);
+    RUN_TEST(test_bad_magic);
+    RUN_TEST(test_unknown_opcode);
+    RUN_TEST(test_trailing_data);
+    RUN_TEST(test_empty_insert);
+    RUN_TEST(test_insert_beyond_target);
+    RUN_TEST(test_copy_beyond_target);
+    RUN_TEST(test_copy_beyond_source);
+    RUN_TEST(test_end_before_target);
+    return UNITY_END();
+}
@@ -0,0 +1,229 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#include <unity.h>
+
+#include "InternalConfig.h"
+#include "WiFiRoaming.h"
+
+/**
+ * Describes a fake Scan Result.
+ */
+struct FakeResult
+{
+    int network;
+    int32_t rssi;
+    uint8_t bssid[6];
+};
+
+// Store fake Scan Results and Network Priorities.
+FakeResult fakeResults[8];
+int fakePriorities[WIFI_NETWORKS_MAX];
+
+const uint8_t bssidA[6] = {0xAA, 0, 0, 0, 0, 1};
+const uint8_t bssidB[6] = {0xBB, 0, 0, 0, 0, 2};
+const uint8_t bssidC[6] = {0xCC, 0, 0, 0, 0, 3};
+
+WiFiResults scan(int16_t count)
+{
+    return {
+        count,
+        [](int16_t index) { return fakeResults[index].network; },
+        [](int network) { return fakePriorities[network]; },
+        [](int16_t index) { return fakeResults[index].rssi; },
+        [](int16_t index) { return (const uint8_t*)fakeResults[index].bssid; }
+    };
+}
+
+void setResult(int16_t index, int network, int32_t rssi, const uint8_t* bssid)
+{
+    fakeResults[index].network = network;
+    fakeResults[index].rssi = rssi;
+
+    for (uint8_t i = 0; i < 6; i++)
+    {
+        fakeResults[index].bssid[i] = bssid[i];
+    }
+}
+
+void setUp()
+{
+    for (uint8_t i = 0; i < WIFI_NETWORKS_MAX; i++)
+    {
+        fakePriorities[i] = 0;
+    }
+}
+
+void tearDown()
+{
+}
+
+void test_select_prefers_priority()
+{
+    fakePriorities[1] = 1;
+    setResult(0, 0, -40, bssidA);
+    setResult(1, 1, -80, bssidB);
+
+    TEST_ASSERT_EQUAL(1, WiFiRoaming::selectResult(scan(2), INT32_MIN, NULL));
+}
+
+void test_select_prefers_rssi_within_priority()
+{
+    setResult(0, 0, -70, bssidA);
+    setResult(1, 1, -50, bssidB);
+    setResult(2, 0, -60, bssidC);
+
+    TEST_ASSERT_EQUAL(1, WiFiRoaming::selectResult(scan(3), INT32_MIN, NULL));
+}
+
+void test_select_skips_unknown_networks()
+{
+    setResult(0, -1, -30, bssidA);
+    setResult(1, 0, -70, bssidB);
+
+    TEST_ASSERT_EQUAL(1, WiFiRoaming::selectResult(scan(2), INT32_MIN, NULL));
+    TEST_ASSERT_EQUAL(-1, WiFiRoaming::selectResult(scan(1), INT32_MIN, NULL));
+}
+
+void test_select_without_results()
+{
+    TEST_ASSERT_EQUAL(-1, WiFiRoaming::selectResult(scan(0), INT32_MIN, NULL));
+
+    // WIFI_SCAN_FAILED
+    TEST_ASSERT_EQUAL(-1, WiFiRoaming::selectResult(scan(-2), INT32_MIN, NULL));
+}
+
+void test_roam_needs_hysteresis()
+{
+    int32_t current = -80;
+
+    setResult(0, 0, current, bssidA);
+    setResult(1, 0, current + WIFI_ROAM_HYSTERESIS - 1, bssidB);
+
+    TEST_ASSERT_EQUAL(-1, WiFiRoaming::selectResult(scan(2), current + WIFI_ROAM_HYSTERESIS, bssidA));
+
+    setResult(1, 0, current + WIFI_ROAM_HYSTERESIS, bssidB);
+
+    TEST_ASSERT_EQUAL(1, WiFiRoaming::selectResult(scan(2), current + WIFI_ROAM_HYSTERESIS, bssidA));
+}
+
+void test_roam_skips_connected_bssid()
+{
+    // The connected AP is reported stronger in the Scan than by the Station.
+    setResult(0, 0, -50, bssidA);
+    setResult(1, 0, -65, bssidB);
+
+    TEST_ASSERT_EQUAL(1, WiFiRoaming::selectResult(scan(2), -72, bssidA));
+}
+
+void test_signal_needs_weak_samples()
+{
+    WiFiRoam roam;
+    unsigned long now = 1000;
+
+    WiFiRoaming::begin(roam, now);
+
+    for (uint8_t i = 1; i < WIFI_ROAM_SAMPLES; i++)
+    {
+        now += WIFI_ROAM_INTERVAL;
+        TEST_ASSERT_FALSE(WiFiRoaming::checkSignal(roam, now, WIFI_ROAM_THRESHOLD - 1));
+    }
+
+    now += WIFI_ROAM_INTERVAL;
+    TEST_ASSERT_TRUE(WiFiRoaming::checkSignal(roam, now, WIFI_ROAM_THRESHOLD - 1));
+}
+
+void test_signal_is_sampled_per_interval()
+{
+    WiFiRoam roam;
+    unsigned long now = 1000;
+
+    WiFiRoaming::begin(roam, now);
+
+    // Calls within the Interval don't count as Samples.
+    for (uint8_t i = 0; i < 10; i++)
+    {
+        TEST_ASSERT_FALSE(WiFiRoaming::checkSignal(roam, now + i, WIFI_ROAM_THRESHOLD - 1));
+    }
+
+    TEST_ASSERT_EQUAL(0, roam.weakSamples);
+}
+
+void test_strong_sample_resets_count()
+{
+    WiFiRoam roam;
+    unsigned long now = 1000;
+
+    WiFiRoaming::begin(roam, now);
+
+    for (uint8_t i = 1; i < WIFI_ROAM_SAMPLES; i++)
+    {
+        now += WIFI_ROAM_INTERVAL;
+        WiFiRoaming::checkSignal(roam, now, WIFI_ROAM_THRESHOLD - 1);
+    }
+
+    now += WIFI_ROAM_INTERVAL;
+    TEST_ASSERT_FALSE(WiFiRoaming::checkSignal(roam, now, WIFI_ROAM_THRESHOLD));
+
+    now += WIFI_ROAM_INTERVAL;
+    TEST_ASSERT_FALSE(WiFiRoaming::checkSignal(roam, now, WIFI_ROAM_THRESHOLD - 1));
+}
+
+void test_scan_cooldown()
+{
+    WiFiRoam roam;
+    unsigned long now = 1000;
+    unsigned long lastScan = 0;
+    uint8_t scans = 0;
+
+    WiFiRoaming::begin(roam, now);
+
+    // Weak for 20 Minutes: one Scan every WIFI_ROAM_COOLDOWN at most.
+    while (now < 1000 + 4 * WIFI_ROAM_COOLDOWN)
+    {
+        now += WIFI_ROAM_INTERVAL;
+
+        if (WiFiRoaming::checkSignal(roam, now, WIFI_ROAM_THRESHOLD - 10))
+        {
+            if (scans > 0)
+                TEST_ASSERT_TRUE(now - lastScan >= WIFI_ROAM_COOLDOWN);
+
+            lastScan = now;
+            scans++;
+        }
+    }
+
+    TEST_ASSERT_EQUAL(4, scans);
+}
+
+void test_signal_across_millis_wrap()
+{
+    WiFiRoam roam;
+    unsigned long now = 0xFFFFFFFFUL - WIFI_ROAM_INTERVAL;
+
+    WiFiRoaming::begin(roam, now);
+
+    for (uint8_t i = 0; i < WIFI_ROAM_SAMPLES; i++)
+    {
+        now = (uint32_t)(now + WIFI_ROAM_INTERVAL);
+        TEST_ASSERT_EQUAL(i == WIFI_ROAM_SAMPLES - 1, WiFiRoaming::checkSignal(roam, now, WIFI_ROAM_THRESHOLD - 1));
+    }
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_select_prefers_priority);
+    RUN_TEST(test_select_prefers_rssi_within_priority);
+    RUN_TEST(test_select_skips_unknown_networks);
+    RUN_TEST(test_select_without_results);
+    RUN_TEST(test_roam_needs_hysteresis);
+    RUN_TEST(test_roam_skips_connected_bssid);
+    RUN_TEST(test_signal_needs_weak_samples);
+    RUN_TEST(test_signal_is_sampled_per_interval);
+    RUN_TEST(test_strong_sample_resets_count);
+    RUN_TEST(test_scan_cooldown);
+    RUN_TEST(test_signal_across_millis_wrap);
+    return UNITY_END();
+}
@@ -0,0 +1,283 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#include <unity.h>
+
+#include "InternalConfig.h"
+#include "SensorRegistry.h"
+
+// Store Values of the fake Drivers and their Calls per Type.
+float adcValue = 1.0f;
+float adsValue = 2.0f;
+float dsValue = 21.5f;
+bool adcReady = true;
+bool dsReady = true;
+int calls[SENSOR_TYPES];
+uint8_t lastPin = 0;
+
+bool readADC(Sensor& sensor, float& raw)
+{
+    calls[SENSOR_ADC]++;
+    lastPin = sensor.pin;
+    raw = adcValue;
+    return adcReady;
+}
+
+bool readADS1115(Sensor& sensor, float& raw)
+{
+    calls[SENSOR_ADS1115]++;
+    lastPin = sensor.pin;
+
+    // Conversion is started on the first Visit and read on the next.
+    if (!sensor.started)
+    {
+        sensor.started = true;
+        return false;
+    }
+
+    raw = adsValue;
+    return true;
+}
+
+bool readDS18B20(Sensor& sensor, float& raw)
+{
+    calls[SENSOR_DS18B20]++;
+    lastPin = sensor.pin;
+    raw = dsValue;
+    return dsReady;
+}
+
+void setUp()
+{
+    SensorRegistry::begin({readADC, readADS1115, readDS18B20});
+
+    adcValue = 1.0f;
+    adsValue = 2.0f;
+    dsValue = 21.5f;
+    adcReady = true;
+    dsReady = true;
+
+    for (int& count : calls)
+        count = 0;
+}
+
+void tearDown()
+{
+}
+
+void test_find_type()
+{
+    TEST_ASSERT_EQUAL(SENSOR_ADC, SensorRegistry::findType("adc"));
+    TEST_ASSERT_EQUAL(SENSOR_ADS1115, SensorRegistry::findType("ads1115"));
+    TEST_ASSERT_EQUAL(SENSOR_DS18B20, SensorRegistry::findType("ds18b20"));
+    TEST_ASSERT_EQUAL(-1, SensorRegistry::findType("bme280"));
+    TEST_ASSERT_EQUAL(-1, SensorRegistry::findType(""));
+}
+
+void test_add_with_defaults()
+{
+    Sensor* sensor = SensorRegistry::add(SENSOR_DS18B20, nullptr);
+
+    TEST_ASSERT_NOT_NULL(sensor);
+    TEST_ASSERT_EQUAL(1, SensorRegistry::getCount());
+    TEST_ASSERT_EQUAL_STRING("ds18b20", SensorRegistry::getName(0));
+    TEST_ASSERT_EQUAL_STRING("ds18b20", SensorRegistry::getType(0));
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, sensor->scale);
+    TEST_ASSERT_EQUAL_FLOAT(EMA_ALPHA, sensor->alpha);
+    TEST_ASSERT_EQUAL(65536, sensor->trimGain);
+    TEST_ASSERT_FALSE(SensorRegistry::isValid(0));
+}
+
+void test_long_name_is_truncated()
+{
+    SensorRegistry::add(SENSOR_ADC, "a_very_long_sensor_name");
+
+    TEST_ASSERT_EQUAL_STRING("a_very_long", SensorRegistry::getName(0));
+}
+
+void test_registry_is_limited()
+{
+    for (uint8_t i = 0; i < SENSOR_MAX; i++)
+        TEST_ASSERT_NOT_NULL(SensorRegistry::add(SENSOR_ADC, nullptr));
+
+    TEST_ASSERT_NULL(SensorRegistry::add(SENSOR_ADC, nullptr));
+    TEST_ASSERT_NULL(SensorRegistry::add(SENSOR_TYPES, nullptr));
+    TEST_ASSERT_EQUAL(SENSOR_MAX, SensorRegistry::getCount());
+}
+
+void test_invalid_index()
+{
+    SensorRegistry::add(SENSOR_ADC, "tank");
+
+    TEST_ASSERT_EQUAL_STRING("", SensorRegistry::getName(1));
+    TEST_ASSERT_EQUAL_STRING("", SensorRegistry::getType(1));
+    TEST_ASSERT_FALSE(SensorRegistry::isValid(1));
+    TEST_ASSERT_FALSE(SensorRegistry::sample(1));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, SensorRegistry::getValue(1));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, SensorRegistry::getLevel(1));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, SensorRegistry::getVolume(1));
+}
+
+void test_dispatch_by_type()
+{
+    SensorRegistry::add(SENSOR_ADC, "tank")->pin = 3;
+    SensorRegistry::add(SENSOR_DS18B20, "water")->pin = 4;
+    SensorRegistry::add(SENSOR_ADS1115, "tank2")->pin = 5;
+
+    TEST_ASSERT_TRUE(SensorRegistry::sample(1));
+    TEST_ASSERT_EQUAL(4, lastPin);
+    TEST_ASSERT_EQUAL(1, calls[SENSOR_DS18B20]);
+    TEST_ASSERT_EQUAL(0, calls[SENSOR_ADC] + calls[SENSOR_ADS1115]);
+    TEST_ASSERT_EQUAL_FLOAT(21.5f, SensorRegistry::getValue(1));
+    TEST_ASSERT_FALSE(SensorRegistry::isValid(0));
+}
+
+void test_calibration_and_filter()
+{
+    Sensor* sensor = SensorRegistry::add(SENSOR_ADC, "tank");
+    sensor->scale = 2.0f;
+    sensor->offset = -0.5f;
+    sensor->alpha = 0.25f;
+
+    // First Value initializes the Filter.
+    adcValue = 1.0f;
+    SensorRegistry::sample(0);
+    TEST_ASSERT_EQUAL_FLOAT(1.5f, SensorRegistry::getValue(0));
+
+    adcValue = 3.0f;
+    SensorRegistry::sample(0);
+    TEST_ASSERT_EQUAL_FLOAT(1.5f * 0.75f + 5.5f * 0.25f, SensorRegistry::getValue(0));
+}
+
+void test_failed_read_keeps_value()
+{
+    SensorRegistry::add(SENSOR_ADC, "tank");
+
+    adcReady = false;
+    TEST_ASSERT_FALSE(SensorRegistry::sample(0));
+    TEST_ASSERT_FALSE(SensorRegistry::isValid(0));
+
+    adcReady = true;
+    SensorRegistry::sample(0);
+
+    adcReady = false;
+    adcValue = 9.0f;
+    TEST_ASSERT_FALSE(SensorRegistry::sample(0));
+    TEST_ASSERT_TRUE(SensorRegistry::isValid(0));
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, SensorRegistry::getValue(0));
+}
+
+void test_conversion_on_next_visit()
+{
+    SensorRegistry::add(SENSOR_ADS1115, "tank2");
+
+    TEST_ASSERT_FALSE(SensorRegistry::sample(0));
+    TEST_ASSERT_FALSE(SensorRegistry::isValid(0));
+    TEST_ASSERT_TRUE(SensorRegistry::sample(0));
+    TEST_ASSERT_EQUAL_FLOAT(2.0f, SensorRegistry::getValue(0));
+}
+
+void test_missing_driver_is_skipped()
+{
+    SensorRegistry::begin({readADC, nullptr, readDS18B20});
+    SensorRegistry::add(SENSOR_ADS1115, "tank2");
+
+    TEST_ASSERT_FALSE(SensorRegistry::sample(0));
+    TEST_ASSERT_FALSE(SensorRegistry::isValid(0));
+}
+
+void test_round_robin()
+{
+    SensorRegistry::add(SENSOR_ADC, "tank");
+    SensorRegistry::add(SENSOR_DS18B20, "water");
+    SensorRegistry::add(SENSOR_ADS1115, "tank2");
+
+    for (int round = 0; round < 4; round++)
+    {
+        TEST_ASSERT_EQUAL(0, SensorRegistry::step());
+        TEST_ASSERT_EQUAL(1, SensorRegistry::step());
+        TEST_ASSERT_EQUAL(2, SensorRegistry::step());
+    }
+
+    TEST_ASSERT_EQUAL(4, calls[SENSOR_ADC]);
+    TEST_ASSERT_EQUAL(4, calls[SENSOR_DS18B20]);
+    TEST_ASSERT_EQUAL(4, calls[SENSOR_ADS1115]);
+    TEST_ASSERT_TRUE(SensorRegistry::isValid(2));
+}
+
+void test_step_without_sensors()
+{
+    TEST_ASSERT_EQUAL(0, SensorRegistry::step());
+    TEST_ASSERT_EQUAL(0, calls[SENSOR_ADC] + calls[SENSOR_ADS1115] + calls[SENSOR_DS18B20]);
+}
+
+void test_slice_per_sensor()
+{
+    TEST_ASSERT_EQUAL(1000, SensorRegistry::getSlice(1000));
+
+    SensorRegistry::add(SENSOR_ADC, "tank");
+    TEST_ASSERT_EQUAL(1000, SensorRegistry::getSlice(1000));
+
+    SensorRegistry::add(SENSOR_DS18B20, "water");
+    SensorRegistry::add(SENSOR_ADS1115, "tank2");
+    TEST_ASSERT_EQUAL(333, SensorRegistry::getSlice(1000));
+
+    // Never 0 Ticks.
+    TEST_ASSERT_EQUAL(1, SensorRegistry::getSlice(2));
+}
+
+void test_level_and_volume()
+{
+    Sensor* sensor = SensorRegistry::add(SENSOR_ADC, "tank");
+    sensor->min = 0.5f;
+    sensor->max = 2.5f;
+    sensor->volume = 1000.0f;
+
+    adcValue = 1.0f;
+    SensorRegistry::sample(0);
+    TEST_ASSERT_EQUAL_FLOAT(25.0f, SensorRegistry::getLevel(0));
+    TEST_ASSERT_EQUAL_FLOAT(250.0f, SensorRegistry::getVolume(0));
+
+    // Level is limited to 0 - 100 %.
+    SensorRegistry::begin({readADC, readADS1115, readDS18B20});
+    sensor = SensorRegistry::add(SENSOR_ADC, "tank");
+    sensor->min = 0.5f;
+    sensor->max = 2.5f;
+    adcValue = 3.0f;
+    SensorRegistry::sample(0);
+    TEST_ASSERT_EQUAL_FLOAT(100.0f, SensorRegistry::getLevel(0));
+
+    sensor->value = 0.1f;
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, SensorRegistry::getLevel(0));
+}
+
+void test_no_level_without_mapping()
+{
+    SensorRegistry::add(SENSOR_DS18B20, "water");
+    SensorRegistry::sample(0);
+
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, SensorRegistry::getLevel(0));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, SensorRegistry::getVolume(0));
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_find_type);
+    RUN_TEST(test_add_with_defaults);
+    RUN_TEST(test_long_name_is_truncated);
+    RUN_TEST(test_registry_is_limited);
+    RUN_TEST(test_invalid_index);
+    RUN_TEST(test_dispatch_by_type);
+    RUN_TEST(test_calibration_and_filter);
+    RUN_TEST(test_failed_read_keeps_value);
+    RUN_TEST(test_conversion_on_next_visit);
+    RUN_TEST(test_missing_driver_is_skipped);
+    RUN_TEST(test_round_robin);
+    RUN_TEST(test_step_without_sensors);
+    RUN_TEST(test_slice_per_sensor);
+    RUN_TEST(test_level_and_volume);
+    RUN_TEST(test_no_level_without_mapping);
+    return UNITY_END();
+}
@@ -0,0 +1,275 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#include <map>
+#include <stddef.h>
+#include <string>
+#include <string.h>
+#include <unity.h>
+
+#include "ConfigStore.h"
+#include "InternalConfig.h"
+#include "StatsStore.h"
+
+// Define Pump Power of Channel 1 (W).
+#define POWER 550
+
+// Store RAM File System (Path => Content).
+std::map<std::string, std::string> files;
+
+// Store Power Budget: Bytes until the Power is cut.
+long budget;
+bool powerLost;
+
+// Store Counters in RAM (StatsHandler::stats).
+StatsRecord stats;
+
+size_t readFile(const char* path, uint8_t* buffer, size_t size)
+{
+    if (files.count(path) == 0)
+        return 0;
+
+    const std::string& file = files[path];
+    size_t length = file.size() < size ? file.size() : size;
+
+    memcpy(buffer, file.data(), length);
+
+    return length;
+}
+
+/**
+ * Writes a Slot in place, the Power Loss truncates it (worse than the Temp
+ * File of `FileHandler::saveFile()`).
+ */
+bool writeFile(const char* path, const uint8_t* data, size_t length)
+{
+    if (powerLost)
+        return false;
+
+    long written = (long)length;
+
+    if (budget < written)
+    {
+        powerLost = true;
+        written = budget;
+    }
+
+    budget -= written;
+    files[path] = std::string((const char*)data, written);
+
+    return written == (long)length;
+}
+
+const StatsFiles fake = {readFile, writeFile};
+
+/**
+ * Accounts a Run of Channel 1 like `StatsHandler::accumulate()`.
+ */
+void run(uint64_t ms)
+{
+    stats.channels[0].onTime += ms;
+    stats.channels[0].energy += POWER * ms;
+
+    if (ms > stats.channels[0].longest)
+        stats.channels[0].longest = ms;
+}
+
+/**
+ * Flushes the Counters like `StatsHandler::flush()`.
+ */
+bool flush()
+{
+    stats.sequence++;
+    StatsRecord record = stats;
+
+    return StatsStore::store(fake, &record);
+}
+
+/**
+ * Boots with empty Counters and restores the newest Slot.
+ */
+bool boot(StatsRecord* restored)
+{
+    budget = 1L << 30;
+    powerLost = false;
+
+    *restored = {};
+
+    return StatsStore::load(fake, restored);
+}
+
+void setUp()
+{
+    files.clear();
+    budget = 1L << 30;
+    powerLost = false;
+
+    stats = {};
+    stats.magic = STATS_MAGIC;
+    stats.count = RELAIS_COUNT;
+
+    // One Hour of History, one Start and one Flush every Interval.
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        stats.channels[0].starts++;
+        run(STATS_INTERVAL);
+        flush();
+    }
+}
+
+void tearDown()
+{
+}
+
+void test_store_and_load()
+{
+    StatsRecord restored;
+
+    TEST_ASSERT_TRUE(boot(&restored));
+    TEST_ASSERT_EQUAL_MEMORY(&stats, &restored, offsetof(StatsRecord, crc));
+    TEST_ASSERT_EQUAL_MEMORY(stats.channels, restored.channels, sizeof(stats.channels));
+}
+
+void test_slots_rotate()
+{
+    TEST_ASSERT_EQUAL(STATS_SLOTS, files.size());
+
+    for (uint8_t i = 0; i < STATS_SLOTS; i++)
+    {
+        flush();
+    }
+
+    StatsRecord restored;
+
+    TEST_ASSERT_EQUAL(STATS_SLOTS, files.size());
+    TEST_ASSERT_TRUE(boot(&restored));
+    TEST_ASSERT_EQUAL(8, restored.sequence);
+}
+
+void test_power_loss_inside_flush_interval()
+{
+    const std::map<std::string, std::string> flushedFiles = files;
+    const StatsRecord flushed = stats;
+
+    for (long offset = 0; offset <= (long)sizeof(StatsRecord); offset++)
+    {
+        files = flushedFiles;
+        stats = flushed;
+
+        // Pump runs on, then the Power is cut while the next Slot is written.
+        stats.channels[0].starts++;
+        run(STATS_INTERVAL / 2);
+
+        budget = offset;
+        bool stored = flush();
+
+        StatsRecord restored;
+
+        TEST_ASSERT_TRUE(boot(&restored));
+        TEST_ASSERT_EQUAL(stored ? flushed.sequence + 1 : flushed.sequence, restored.sequence);
+
+        // At most one Flush Interval of Run Time is lost, the Counters never go back.
+        const StatsChannel& channel = restored.channels[0];
+
+        TEST_ASSERT_TRUE(channel.onTime >= flushed.channels[0].onTime);
+        TEST_ASSERT_TRUE(stats.channels[0].onTime - channel.onTime <= STATS_INTERVAL);
+        TEST_ASSERT_EQUAL(channel.onTime * POWER, channel.energy);
+        TEST_ASSERT_TRUE(channel.starts >= flushed.channels[0].starts);
+    }
+}
+
+void test_power_loss_before_flush()
+{
+    run(STATS_INTERVAL - 1);
+
+    StatsRecord restored;
+
+    TEST_ASSERT_TRUE(boot(&restored));
+    TEST_ASSERT_EQUAL(4 * STATS_INTERVAL, restored.channels[0].onTime);
+    TEST_ASSERT_EQUAL(4, restored.channels[0].starts);
+}
+
+void test_corrupt_slot_falls_back()
+{
+    // Newest Slot (Sequence 4).
+    files["/stats0.bin"][offsetof(StatsRecord, channels) + 2] ^= 0x01;
+
+    StatsRecord restored;
+
+    TEST_ASSERT_TRUE(boot(&restored));
+    TEST_ASSERT_EQUAL(3, restored.sequence);
+    TEST_ASSERT_EQUAL(3 * STATS_INTERVAL, restored.channels[0].onTime);
+}
+
+void test_added_channels_start_at_zero()
+{
+    files.clear();
+
+    // Slot written with a Table of one Channel.
+    StatsRecord record = {};
+    size_t length = offsetof(StatsRecord, channels) + sizeof(StatsChannel);
+
+    record.magic = STATS_MAGIC;
+    record.sequence = 7;
+    record.count = 1;
+    record.channels[0].starts = 12;
+    record.crc = ConfigStore::crc32((const uint8_t*)&record, length);
+
+    files["/stats3.bin"] = std::string((const char*)&record, length);
+
+    StatsRecord restored;
+
+    TEST_ASSERT_TRUE(boot(&restored));
+    TEST_ASSERT_EQUAL(RELAIS_COUNT, restored.count);
+    TEST_ASSERT_EQUAL(12, restored.channels[0].starts);
+    TEST_ASSERT_EQUAL(0, restored.channels[RELAIS_COUNT - 1].starts);
+}
+
+void test_record_checks()
+{
+    StatsRecord record = stats;
+
+    StatsStore::store(fake, &record);
+    TEST_ASSERT_TRUE(StatsStore::checkRecord(record, sizeof(record)));
+
+    // Truncated Slot.
+    TEST_ASSERT_FALSE(StatsStore::checkRecord(record, sizeof(record) - 1));
+    TEST_ASSERT_FALSE(StatsStore::checkRecord(record, 0));
+
+    // Wrong Magic and Channel Count.
+    record.magic++;
+    TEST_ASSERT_FALSE(StatsStore::checkRecord(record, sizeof(record)));
+
+    record = stats;
+    StatsStore::store(fake, &record);
+    record.count = 0;
+    TEST_ASSERT_FALSE(StatsStore::checkRecord(record, offsetof(StatsRecord, channels)));
+
+    record.count = RELAIS_COUNT + 1;
+    TEST_ASSERT_FALSE(StatsStore::checkRecord(record, sizeof(record) + sizeof(StatsChannel)));
+}
+
+void test_nothing_stored()
+{
+    files.clear();
+
+    StatsRecord restored;
+
+    TEST_ASSERT_FALSE(boot(&restored));
+    TEST_ASSERT_EQUAL(0, restored.sequence);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_store_and_load);
+    RUN_TEST(test_slots_rotate);
+    RUN_TEST(test_power_loss_inside_flush_interval);
+    RUN_TEST(test_power_loss_before_flush);
+    RUN_TEST(test_corrupt_slot_falls_back);
+    RUN_TEST(test_added_channels_start_at_zero);
+    RUN_TEST(test_record_checks);
+    RUN_TEST(test_nothing_stored);
+    return UNITY_END();
+}
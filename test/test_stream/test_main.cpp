@@ -0,0 +1,212 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#include <ArduinoJson.h>
+#include <sstream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <unity.h>
+
+/**
+ * Counts the Heap like `ESP.getMinFreeHeap()`. Every Block carries its Size,
+ * so `reallocate` is tracked as well.
+ */
+class CountingAllocator : public ArduinoJson::Allocator
+{
+public:
+    size_t current = 0;
+    size_t peak = 0;
+
+    void* allocate(size_t size) override
+    {
+        size_t* block = (size_t*)malloc(sizeof(max_align_t) + size);
+
+        if (block == nullptr)
+            return nullptr;
+
+        *block = size;
+        track(size);
+
+        return (uint8_t*)block + sizeof(max_align_t);
+    }
+
+    void deallocate(void* pointer) override
+    {
+        if (pointer == nullptr)
+            return;
+
+        size_t* block = (size_t*)((uint8_t*)pointer - sizeof(max_align_t));
+
+        current -= *block;
+        free(block);
+    }
+
+    void* reallocate(void* pointer, size_t size) override
+    {
+        if (pointer == nullptr)
+            return allocate(size);
+
+        size_t* block = (size_t*)((uint8_t*)pointer - sizeof(max_align_t));
+        size_t previous = *block;
+
+        block = (size_t*)realloc(block, sizeof(max_align_t) + size);
+
+        if (block == nullptr)
+            return nullptr;
+
+        *block = size;
+        current -= previous;
+        track(size);
+
+        return (uint8_t*)block + sizeof(max_align_t);
+    }
+
+    void track(size_t size)
+    {
+        current += size;
+
+        if (current > peak)
+            peak = current;
+    }
+};
+
+/**
+ * Builds a Config with `sensors` Entries and a `history` of `samples` Values,
+ * the Size grows like a Config with many Sensors and Statistics.
+ */
+std::string buildFile(int sensors, int samples)
+{
+    std::string file = "{\"version\":\"1.5.0\",\"sensors\":[";
+
+    for (int i = 0; i < sensors; i++)
+    {
+        char entry[160];
+
+        snprintf(entry, sizeof(entry), "%s{\"type\":\"ads1115\",\"name\":\"tank%d\",\"address\":72,\"channel\":%d,"
+                 "\"min\":0.4,\"max\":2.0,\"volume\":500,\"trim\":[[500,512],[2000,1985]]}", i > 0 ? "," : "", i, i % 4);
+        file += entry;
+    }
+
+    file += "],\"history\":[";
+
+    for (int i = 0; i < samples; i++)
+    {
+        char value[16];
+
+        snprintf(value, sizeof(value), "%s%d.%02d", i > 0 ? "," : "", 40 + i % 50, i % 100);
+        file += value;
+    }
+
+    file += "]}";
+
+    return file;
+}
+
+/**
+ * Parses like the old `readFile()`: the whole File as String first.
+ *
+ * @return The Peak Heap (Bytes).
+ */
+size_t parseMaterialized(const std::string& file, std::string& result)
+{
+    CountingAllocator heap;
+
+    {
+        JsonDocument doc(&heap);
+
+        char* content = (char*)heap.allocate(file.size() + 1);
+        memcpy(content, file.c_str(), file.size() + 1);
+
+        DeserializationError error = deserializeJson(doc, content, file.size());
+        heap.deallocate(content);
+
+        TEST_ASSERT_FALSE(error);
+        serializeJson(doc, result);
+    }
+
+    TEST_ASSERT_EQUAL(0, heap.current);
+
+    return heap.peak;
+}
+
+/**
+ * Parses like `FileHandler::readJson()`: straight from the File Stream.
+ *
+ * @return The Peak Heap (Bytes).
+ */
+size_t parseStreamed(const std::string& file, std::string& result)
+{
+    CountingAllocator heap;
+    std::istringstream stream(file);
+
+    {
+        JsonDocument doc(&heap);
+
+        DeserializationError error = deserializeJson(doc, stream);
+
+        TEST_ASSERT_FALSE(error);
+        serializeJson(doc, result);
+    }
+
+    TEST_ASSERT_EQUAL(0, heap.current);
+
+    return heap.peak;
+}
+
+void measure(int sensors, int samples)
+{
+    std::string file = buildFile(sensors, samples);
+    std::string materialized;
+    std::string streamed;
+
+    size_t before = parseMaterialized(file, materialized);
+    size_t after = parseStreamed(file, streamed);
+
+    char message[128];
+    snprintf(message, sizeof(message), "%zu B File: Peak Heap %zu B (String) -> %zu B (Stream)", file.size(), before, after);
+    TEST_MESSAGE(message);
+
+    // Same Document without the File Copy.
+    TEST_ASSERT_EQUAL_STRING(materialized.c_str(), streamed.c_str());
+    TEST_ASSERT_LESS_THAN(before, after);
+}
+
+void setUp()
+{
+}
+
+void tearDown()
+{
+}
+
+void test_peak_heap_factory_config()
+{
+    measure(1, 0);
+}
+
+void test_peak_heap_16k()
+{
+    measure(8, 2000);
+}
+
+void test_peak_heap_64k()
+{
+    measure(32, 8000);
+}
+
+void test_peak_heap_256k()
+{
+    measure(64, 36000);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_peak_heap_factory_config);
+    RUN_TEST(test_peak_heap_16k);
+    RUN_TEST(test_peak_heap_64k);
+    RUN_TEST(test_peak_heap_256k);
+    return UNITY_END();
+}
@@ -0,0 +1,173 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#include <unity.h>
+
+#include "RelaisArbiter.h"
+
+// Channel 3 of the native RELAIS_TABLE is limited to 600 s.
+#define LIMITED 2
+#define UNLIMITED 0
+
+// Define 2^32 µs (esp_timer Value where a 32 Bit µs Counter wraps).
+#define WRAP_US 4294967296LL
+
+// Define 2^32 ms in µs (millis() Wraparound after 49.7 Days).
+#define WRAP_MS (4294967296LL * 1000LL)
+
+void setUp()
+{
+    RelaisArbiter::reset(0);
+
+    for (uint8_t i = 0; i < RELAIS_COUNT; i++)
+    {
+        RelaisArbiter::release(i);
+    }
+}
+
+void tearDown()
+{
+}
+
+void test_native_table()
+{
+    TEST_ASSERT_EQUAL(3, RELAIS_COUNT);
+    TEST_ASSERT_EQUAL(600, relaisChannels[LIMITED].maxOn);
+}
+
+void test_timeout_in_microseconds()
+{
+    TEST_ASSERT_EQUAL(30000000ULL, RelaisArbiter::getTimeout(UNLIMITED, 30));
+    TEST_ASSERT_EQUAL(30000000ULL, RelaisArbiter::getTimeout(LIMITED, 30));
+}
+
+void test_timeout_is_limited_to_max_on()
+{
+    TEST_ASSERT_EQUAL(600000000ULL, RelaisArbiter::getTimeout(LIMITED, 601));
+    TEST_ASSERT_EQUAL(600000000ULL, RelaisArbiter::getTimeout(LIMITED, 0));
+    TEST_ASSERT_EQUAL(0ULL, RelaisArbiter::getTimeout(UNLIMITED, 0));
+}
+
+void test_long_timeout_does_not_overflow()
+{
+    // 50 Days do not fit into 32 Bit µs or ms.
+    TEST_ASSERT_EQUAL(4320000000000ULL, RelaisArbiter::getTimeout(UNLIMITED, 4320000));
+}
+
+void test_remaining_time()
+{
+    RelaisArbiter::setDeadline(UNLIMITED, 1000000 + 30000000);
+
+    TEST_ASSERT_EQUAL(30000, RelaisArbiter::getRemaining(UNLIMITED, 1000000));
+    TEST_ASSERT_EQUAL(29999, RelaisArbiter::getRemaining(UNLIMITED, 1000001));
+    TEST_ASSERT_EQUAL(0, RelaisArbiter::getRemaining(UNLIMITED, 1000000 + 29999500));
+}
+
+void test_without_timeout()
+{
+    TEST_ASSERT_EQUAL(0, RelaisArbiter::getRemaining(UNLIMITED, 0));
+    TEST_ASSERT_EQUAL(0, RelaisArbiter::getRemaining(UNLIMITED, WRAP_MS));
+}
+
+void test_overshoot_reads_zero()
+{
+    RelaisArbiter::setDeadline(UNLIMITED, 5000000);
+
+    // Timer Task is late, the Deadline has passed.
+    TEST_ASSERT_EQUAL(0, RelaisArbiter::getRemaining(UNLIMITED, 5000000));
+    TEST_ASSERT_EQUAL(0, RelaisArbiter::getRemaining(UNLIMITED, 5000001));
+    TEST_ASSERT_EQUAL(0, RelaisArbiter::getRemaining(UNLIMITED, 5000000 + WRAP_US));
+}
+
+void test_wraparound_of_32_bit_microseconds()
+{
+    int64_t now = WRAP_US - 1000;
+
+    RelaisArbiter::setDeadline(UNLIMITED, now + RelaisArbiter::getTimeout(UNLIMITED, 5));
+
+    TEST_ASSERT_EQUAL(5000, RelaisArbiter::getRemaining(UNLIMITED, now));
+    TEST_ASSERT_EQUAL(4999, RelaisArbiter::getRemaining(UNLIMITED, WRAP_US));
+    TEST_ASSERT_EQUAL(0, RelaisArbiter::getRemaining(UNLIMITED, now + 5000000));
+}
+
+void test_wraparound_of_millis()
+{
+    int64_t now = WRAP_MS - 2000000;
+
+    RelaisArbiter::setDeadline(LIMITED, now + RelaisArbiter::getTimeout(LIMITED, 10));
+
+    TEST_ASSERT_EQUAL(10000, RelaisArbiter::getRemaining(LIMITED, now));
+    TEST_ASSERT_EQUAL(8000, RelaisArbiter::getRemaining(LIMITED, WRAP_MS));
+    TEST_ASSERT_EQUAL(0, RelaisArbiter::getRemaining(LIMITED, WRAP_MS + 8000000));
+}
+
+void test_remaining_is_clamped()
+{
+    RelaisArbiter::setDeadline(UNLIMITED, RelaisArbiter::getTimeout(UNLIMITED, 4320000));
+
+    TEST_ASSERT_EQUAL(INT32_MAX, RelaisArbiter::getRemaining(UNLIMITED, 1));
+}
+
+void test_release_clears_deadline()
+{
+    int64_t wait;
+    uint32_t conflicts;
+
+    RelaisArbiter::request(LIMITED, RELAIS_MANUAL, 0, &conflicts, &wait);
+    RelaisArbiter::setDeadline(LIMITED, RelaisArbiter::getTimeout(LIMITED, 0));
+
+    TEST_ASSERT_EQUAL(600000, RelaisArbiter::getRemaining(LIMITED, 0));
+    TEST_ASSERT_TRUE(RelaisArbiter::release(LIMITED));
+    TEST_ASSERT_EQUAL(0, RelaisArbiter::getRemaining(LIMITED, 0));
+}
+
+void test_queued_duration_is_kept()
+{
+    int64_t wait;
+    uint32_t conflicts;
+
+    int64_t now = 10000000;
+
+    RelaisArbiter::reset(1000000);
+    TEST_ASSERT_EQUAL(RELAIS_STARTED, RelaisArbiter::request(UNLIMITED, RELAIS_MANUAL, now, &conflicts, &wait));
+
+    // Second Start inside the Gap, the Duration is set while queued.
+    TEST_ASSERT_EQUAL(RELAIS_QUEUED, RelaisArbiter::request(LIMITED, RELAIS_MANUAL, now, &conflicts, &wait));
+    RelaisArbiter::setDeadline(LIMITED, now + RelaisArbiter::getTimeout(LIMITED, 30));
+
+    // The staggered Start must not replace the Duration with `maxOn`.
+    TEST_ASSERT_EQUAL(LIMITED, RelaisArbiter::startNext(now + wait));
+    TEST_ASSERT_EQUAL(0ULL, RelaisArbiter::getStartTimeout(LIMITED));
+    TEST_ASSERT_EQUAL(29000, RelaisArbiter::getRemaining(LIMITED, now + wait));
+}
+
+void test_start_without_duration_uses_max_on()
+{
+    int64_t wait;
+    uint32_t conflicts;
+
+    RelaisArbiter::request(LIMITED, RELAIS_MANUAL, 0, &conflicts, &wait);
+
+    TEST_ASSERT_EQUAL(600000000ULL, RelaisArbiter::getStartTimeout(LIMITED));
+    TEST_ASSERT_EQUAL(0ULL, RelaisArbiter::getStartTimeout(UNLIMITED));
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_native_table);
+    RUN_TEST(test_timeout_in_microseconds);
+    RUN_TEST(test_timeout_is_limited_to_max_on);
+    RUN_TEST(test_long_timeout_does_not_overflow);
+    RUN_TEST(test_remaining_time);
+    RUN_TEST(test_without_timeout);
+    RUN_TEST(test_overshoot_reads_zero);
+    RUN_TEST(test_wraparound_of_32_bit_microseconds);
+    RUN_TEST(test_wraparound_of_millis);
+    RUN_TEST(test_remaining_is_clamped);
+    RUN_TEST(test_release_clears_deadline);
+    RUN_TEST(test_queued_duration_is_kept);
+    RUN_TEST(test_start_without_duration_uses_max_on);
+    return UNITY_END();
+}
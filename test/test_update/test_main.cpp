@@ -0,0 +1,246 @@
+//
+// Created by JanHe on 18.10.2026.
+//
+
+#include <string.h>
+#include <unity.h>
+
+#include "InternalConfig.h"
+#include "UpdateSchedule.h"
+
+/**
+ * Local Stand-In for UPDATE_SERVER, counts Requests and answers 304 if the
+ * Client sends the current ETag.
+ */
+struct Server
+{
+    char version[16];
+    char etag[16];
+    int requests;
+    int notModified;
+};
+
+Server server;
+
+// Store Client Side of the Update Task (OTAHandler).
+bool available;
+char latest[16];
+int installs;
+bool installWorks;
+
+void setUp()
+{
+    UpdateSchedule::reset(UPDATE_TTL);
+
+    strcpy(server.version, "1.6.0");
+    strcpy(server.etag, "\"a1\"");
+    server.requests = 0;
+    server.notModified = 0;
+
+    available = false;
+    latest[0] = '\0';
+    installs = 0;
+    installWorks = false;
+}
+
+void tearDown()
+{
+}
+
+/**
+ * Sends a Manifest Request like `OTAHandler::fetchManifest()`.
+ */
+void fetch()
+{
+    server.requests++;
+
+    if (strcmp(UpdateSchedule::getETag(), server.etag) == 0)
+    {
+        server.notModified++;
+        return;
+    }
+
+    UpdateSchedule::storeValidators(server.etag, "");
+
+    available = UpdateSchedule::isNewer(server.version, VERSION);
+    strcpy(latest, available ? server.version : "");
+}
+
+/**
+ * Runs one Tick of `OTAHandler::runTask()` with UPDATE_AUTO.
+ *
+ * @param now The Time of the Tick (ms).
+ */
+void tick(unsigned long now)
+{
+    if (UpdateSchedule::isCheckDue(now))
+    {
+        fetch();
+        UpdateSchedule::checked(now);
+    }
+
+    if (UpdateSchedule::isInstallDue(latest, now))
+    {
+        installs++;
+
+        if (!installWorks)
+            UpdateSchedule::failed(latest, now);
+    }
+}
+
+/**
+ * Runs the Update Task with one Tick per Second.
+ */
+void run(unsigned long from, unsigned long to)
+{
+    for (unsigned long now = from; now < to; now += 1000)
+    {
+        tick(now);
+    }
+}
+
+void test_first_tick_checks()
+{
+    tick(0);
+
+    TEST_ASSERT_EQUAL(1, server.requests);
+    TEST_ASSERT_EQUAL_STRING("\"a1\"", UpdateSchedule::getETag());
+}
+
+void test_interval_is_respected()
+{
+    installWorks = true;
+    strcpy(server.version, VERSION);
+
+    run(0, UPDATE_TTL * 3);
+
+    TEST_ASSERT_EQUAL(3, server.requests);
+    TEST_ASSERT_EQUAL(2, server.notModified);
+}
+
+void test_unchanged_manifest_sends_etag()
+{
+    strcpy(server.version, VERSION);
+
+    tick(0);
+    tick(UPDATE_TTL);
+
+    TEST_ASSERT_EQUAL(2, server.requests);
+    TEST_ASSERT_EQUAL(1, server.notModified);
+}
+
+void test_changed_manifest_is_fetched()
+{
+    strcpy(server.version, VERSION);
+
+    tick(0);
+    TEST_ASSERT_FALSE(available);
+
+    strcpy(server.version, "9.0.0");
+    strcpy(server.etag, "\"b2\"");
+    installWorks = true;
+
+    tick(UPDATE_TTL);
+
+    TEST_ASSERT_EQUAL(0, server.notModified);
+    TEST_ASSERT_TRUE(available);
+    TEST_ASSERT_EQUAL_STRING("9.0.0", latest);
+    TEST_ASSERT_EQUAL(1, installs);
+}
+
+void test_refresh_forces_check()
+{
+    strcpy(server.version, VERSION);
+
+    tick(0);
+    tick(1000);
+    TEST_ASSERT_EQUAL(1, server.requests);
+
+    UpdateSchedule::requestCheck();
+    tick(2000);
+    tick(3000);
+
+    TEST_ASSERT_EQUAL(2, server.requests);
+}
+
+void test_failed_update_backs_off()
+{
+    // One Day with an Update that always fails.
+    run(0, 86400000UL);
+
+    // Retries after 10, 20, 40, 80, 160, 320 and 640 Minutes.
+    TEST_ASSERT_EQUAL(8, installs);
+    TEST_ASSERT_EQUAL(24, server.requests);
+    TEST_ASSERT_TRUE(UpdateSchedule::hasFailed("1.6.0"));
+}
+
+void test_retry_delay_is_capped()
+{
+    for (int i = 0; i < 40; i++)
+    {
+        UpdateSchedule::failed("1.6.0", 0);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(UPDATE_RETRY_MAX, UpdateSchedule::getRetryDelay());
+}
+
+void test_new_version_after_failure_installs()
+{
+    run(0, 60000);
+    TEST_ASSERT_EQUAL(1, installs);
+
+    strcpy(server.version, "1.7.0");
+    strcpy(server.etag, "\"c3\"");
+    UpdateSchedule::requestCheck();
+
+    tick(61000);
+
+    // Installed at once, although the Backoff of 1.6.0 is still running.
+    TEST_ASSERT_EQUAL(2, installs);
+    TEST_ASSERT_FALSE(UpdateSchedule::hasFailed("1.6.0"));
+}
+
+void test_no_install_without_version()
+{
+    TEST_ASSERT_FALSE(UpdateSchedule::isInstallDue("", 0));
+    TEST_ASSERT_FALSE(UpdateSchedule::isInstallDue(nullptr, 0));
+}
+
+void test_oversized_etag_is_dropped()
+{
+    char etag[128];
+    memset(etag, 'x', sizeof(etag) - 1);
+    etag[sizeof(etag) - 1] = '\0';
+
+    UpdateSchedule::storeValidators(etag, "Sat, 17 Oct 2026 10:00:00 GMT");
+
+    TEST_ASSERT_EQUAL_STRING("", UpdateSchedule::getETag());
+    TEST_ASSERT_EQUAL_STRING("Sat, 17 Oct 2026 10:00:00 GMT", UpdateSchedule::getModified());
+}
+
+void test_version_compare()
+{
+    TEST_ASSERT_TRUE(UpdateSchedule::isNewer("1.5.1", "1.5.0"));
+    TEST_ASSERT_TRUE(UpdateSchedule::isNewer("1.10.0", "1.9.9"));
+    TEST_ASSERT_TRUE(UpdateSchedule::isNewer("2", "1.9.9"));
+    TEST_ASSERT_FALSE(UpdateSchedule::isNewer("1.5.0", "1.5.0"));
+    TEST_ASSERT_FALSE(UpdateSchedule::isNewer("1.4.9", "1.5.0"));
+    TEST_ASSERT_FALSE(UpdateSchedule::isNewer("", "1.5.0"));
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_first_tick_checks);
+    RUN_TEST(test_interval_is_respected);
+    RUN_TEST(test_unchanged_manifest_sends_etag);
+    RUN_TEST(test_changed_manifest_is_fetched);
+    RUN_TEST(test_refresh_forces_check);
+    RUN_TEST(test_failed_update_backs_off);
+    RUN_TEST(test_retry_delay_is_capped);
+    RUN_TEST(test_new_version_after_failure_installs);
+    RUN_TEST(test_no_install_without_version);
+    RUN_TEST(test_oversized_etag_is_dropped);
+    RUN_TEST(test_version_compare);
+    return UNITY_END();
+}
@@ -0,0 +1,107 @@
+#!/usr/bin/env python3
+#
+# Created by JanHe on 18.10.2026.
+#
+# Generates a Delta Patch (BLD1) between two Firmware Images for the
+# PatchHandler and prints the matching Manifest Entry.
+#
+# Usage: mkpatch.py <old.bin> <new.bin> <out.patch> [--gzip]
+#
+# Patch Format (all Values little-endian):
+#   Header: "BLD1" + uint32 Size of the resulting Image.
+#   0x01 COPY: uint32 Offset, uint32 Length => copy from running Partition.
+#   0x02 INSERT: uint32 Length + Data => copy from Patch Stream.
+#   0x00 END.
+
+import gzip
+import hashlib
+import struct
+import sys
+
+BLOCK = 32
+PATCH_END = 0x00
+PATCH_COPY = 0x01
+PATCH_INSERT = 0x02
+
+
+def diff(old, new):
+    # Index aligned Blocks of the old Image.
+    index = {}
+    for offset in range(0, len(old) - BLOCK + 1, BLOCK):
+        index.setdefault(old[offset:offset + BLOCK], offset)
+
+    out = bytearray(b"BLD1" + struct.pack("<I", len(new)))
+    pending = bytearray()
+    i = 0
+
+    while i < len(new):
+        offset = index.get(new[i:i + BLOCK])
+
+        if offset is None:
+            pending.append(new[i])
+            i += 1
+            continue
+
+        # Extend Match forward.
+        length = BLOCK
+        while i + length < len(new) and offset + length < len(old) and new[i + length] == old[offset + length]:
+            length += 1
+
+        if pending:
+            out += struct.pack("<BI", PATCH_INSERT, len(pending)) + pending
+            pending = bytearray()
+
+        out += struct.pack("<BII", PATCH_COPY, offset, length)
+        i += length
+
+    if pending:
+        out += struct.pack("<BI", PATCH_INSERT, len(pending)) + pending
+
+    out.append(PATCH_END)
+    return bytes(out)
+
+
+def apply(old, patch):
+    # Reference Implementation, used to verify the generated Patch.
+    assert patch[:4] == b"BLD1"
+    size = struct.unpack_from("<I", patch, 4)[0]
+    out = bytearray()
+    i = 8
+
+    while patch[i] != PATCH_END:
+        if patch[i] == PATCH_COPY:
+            offset, length = struct.unpack_from("<II", patch, i + 1)
+            out += old[offset:offset + length]
+            i += 9
+        else:
+            length = struct.unpack_from("<I", patch, i + 1)[0]
+            out += patch[i + 5:i + 5 + length]
+            i += 5 + length
+
+    assert len(out) == size
+    return bytes(out)
+
+
+def main():
+    if len(sys.argv) < 4:
+        print("Usage: mkpatch.py <old.bin> <new.bin> <out.patch> [--gzip]")
+        sys.exit(1)
+
+    old = open(sys.argv[1], "rb").read()
+    new = open(sys.argv[2], "rb").read()
+    compress = "--gzip" in sys.argv[4:]
+
+    patch = diff(old, new)
+    assert apply(old, patch) == new
+
+    data = gzip.compress(patch, mtime=0) if compress else patch
+    open(sys.argv[3], "wb").write(data)
+
+    print("patch: %d bytes (image %d bytes, %.1f%%)" % (len(data), len(new), 100.0 * len(data) / len(new)))
+    print('"sha256": "%s",' % hashlib.sha256(new).hexdigest())
+    print('"delta": {"from": "<old version>", "url": "<url>/%s", "gzip": %s}'
+          % (sys.argv[3].split("/")[-1], "true" if compress else "false"))
+
+
+if __name__ == "__main__":
+    main()